@@ -0,0 +1,250 @@
+#pragma once
+
+#include "framePacing.hh"
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <iris/vec2.hh>
+#include <iris/vec4.hh>
+#include <iris/general.hh>
+
+/// The curves of iris' interpolation helpers
+enum struct Easing : uint8_t
+{
+	LINEAR, EASE_OUT, EASE_IN, EXP_EASE_OUT, EXP_EASE_IN, SMOOTHSTEP, SMOOTHERSTEP
+};
+
+/// Which widget property a tween drives, and so how many of its 4 channels are used
+enum struct AnimTrack : uint8_t
+{
+	POSITION, SIZE, COLOR, OPACITY
+};
+
+/// Progress 0 to 1 along an easing curve, the same formulas as IR::lerpV2, eoerpV2 etc
+inline float ease(Easing easing, float t)
+{
+	switch(easing)
+	{
+		case Easing::EASE_OUT: return std::sin(t * IR::pi<float> * 0.5f);
+		case Easing::EASE_IN: return 1.0f - std::cos(t * IR::pi<float> * 0.5f);
+		case Easing::EXP_EASE_OUT: return std::sin((t * t) * IR::pi<float> * 0.5f);
+		case Easing::EXP_EASE_IN: return 1.0f - std::cos((t * t) * IR::pi<float> * 0.5f);
+		case Easing::SMOOTHSTEP: return (t * t) * (3.0f - 2.0f * t);
+		case Easing::SMOOTHERSTEP: return t * t * t * (t * (6.0f * t - 15.0f) + 10.0f);
+		default: return t;
+	}
+}
+
+/// Every active tween lives here as a column per field, update() advances them all in a few flat passes the compiler can vectorize.
+/// A tween writes its property and the owner's dirty flag each frame, and is retired once it finishes.
+/// Not thread safe, start tweens and call update() on the thread that renders
+struct Animator final
+{
+	using Clock = FramePacer::Clock;
+	
+	inline static Animator &instance()
+	{
+		static Animator out;
+		return out;
+	}
+	
+	/// Tween a property from its current value.  A tween already running on the same owner and track is replaced, so
+	/// reversing a hover fade halfway starts from where it got to.  out points at 2 int32_t for POSITION and SIZE, 4 floats for COLOR and 1 for OPACITY
+	inline void animate(void const *owner, AnimTrack track, void *out, std::atomic<bool> *dirty, IR::vec4<float> const &to, float seconds, Easing easing = Easing::SMOOTHSTEP, float delay = 0)
+	{
+		if(!this->size()) this->lastUpdate = {}; //Idle time before this tween doesn't count towards it
+		IR::vec4<float> from = read(track, out);
+		size_t i = this->find(owner, track);
+		if(i == this->size())
+		{
+			this->elapsed.emplace_back();
+			this->invDuration.emplace_back();
+			this->easing.emplace_back();
+			for(auto &channel : this->from) channel.emplace_back();
+			for(auto &channel : this->delta) channel.emplace_back();
+			this->targets.emplace_back();
+		}
+		this->elapsed[i] = -delay;
+		this->invDuration[i] = seconds > 0 ? 1.0f / seconds : 1e30f; //Finishes on the first update with any time passed
+		this->easing[i] = easing;
+		for(size_t c = 0; c < 4; c++)
+		{
+			this->from[c][i] = from[c];
+			this->delta[c][i] = to[c] - from[c];
+		}
+		this->targets[i] = {owner, out, dirty, track};
+		FramePacer::instance().invalidate();
+	}
+	
+	/// Stop every tween of owner where it is, call before the owner is destroyed
+	inline void cancel(void const *owner)
+	{
+		for(size_t i = 0; i < this->size();)
+		{
+			if(this->targets[i].owner == owner) this->retire(i);
+			else i++;
+		}
+	}
+	
+	inline void cancel(void const *owner, AnimTrack track)
+	{
+		size_t i = this->find(owner, track);
+		if(i != this->size()) this->retire(i);
+	}
+	
+	/// Stop every tween where it is
+	inline void clear()
+	{
+		this->elapsed.clear();
+		this->invDuration.clear();
+		this->easing.clear();
+		for(size_t c = 0; c < 4; c++)
+		{
+			this->from[c].clear();
+			this->delta[c].clear();
+		}
+		this->targets.clear();
+	}
+	
+	/// Advance by the time since the last update, call once per frame before rendering
+	inline void update()
+	{
+		Clock::time_point now = Clock::now();
+		float dt = this->lastUpdate == Clock::time_point{} ? 0.0f : std::chrono::duration<float>(now - this->lastUpdate).count();
+		this->lastUpdate = now;
+		this->update(dt);
+	}
+	
+	/// Advance every tween by dt seconds
+	inline void update(float dt)
+	{
+		size_t count = this->size();
+		if(!count) return;
+		this->progress.resize(count);
+		for(auto &channel : this->value) channel.resize(count);
+		float *elapsed = this->elapsed.data(), *invDuration = this->invDuration.data(), *progress = this->progress.data();
+		for(size_t i = 0; i < count; i++)
+		{
+			elapsed[i] += dt;
+			progress[i] = std::clamp(elapsed[i] * invDuration[i], 0.0f, 1.0f);
+		}
+		//Only the eased curves need the per tween switch, linear progress is used as is
+		Easing const *easing = this->easing.data();
+		for(size_t i = 0; i < count; i++) if(easing[i] != Easing::LINEAR) progress[i] = ease(easing[i], progress[i]);
+		for(size_t c = 0; c < 4; c++)
+		{
+			float const *from = this->from[c].data(), *delta = this->delta[c].data();
+			float *value = this->value[c].data();
+			for(size_t i = 0; i < count; i++) value[i] = from[i] + delta[i] * progress[i];
+		}
+		for(size_t i = 0; i < count; i++) this->write(i);
+		FramePacer::instance().invalidate();
+		//Retire finished tweens after their final value is written, backwards so swapping the last one in doesn't skip any
+		for(size_t i = count; i-- > 0;) if(elapsed[i] * invDuration[i] >= 1.0f) this->retire(i);
+	}
+	
+	inline size_t size() const
+	{
+		return this->elapsed.size();
+	}
+	
+	inline bool running(void const *owner, AnimTrack track) const
+	{
+		return this->find(owner, track) != this->size();
+	}
+
+private:
+	struct Target
+	{
+		void const *owner;
+		void *out;
+		std::atomic<bool> *dirty;
+		AnimTrack track;
+	};
+	
+	Animator() = default;
+	
+	inline static IR::vec4<float> read(AnimTrack track, void const *out)
+	{
+		switch(track)
+		{
+			case AnimTrack::POSITION:
+			case AnimTrack::SIZE:
+			{
+				int32_t const *in = static_cast<int32_t const *>(out);
+				return {static_cast<float>(in[0]), static_cast<float>(in[1]), 0, 0};
+			}
+			case AnimTrack::COLOR:
+			{
+				float const *in = static_cast<float const *>(out);
+				return {in[0], in[1], in[2], in[3]};
+			}
+			default: return {*static_cast<float const *>(out), 0, 0, 0};
+		}
+	}
+	
+	inline void write(size_t i)
+	{
+		Target const &target = this->targets[i];
+		switch(target.track)
+		{
+			case AnimTrack::POSITION:
+			case AnimTrack::SIZE:
+			{
+				int32_t *out = static_cast<int32_t *>(target.out);
+				out[0] = static_cast<int32_t>(std::lround(this->value[0][i]));
+				out[1] = static_cast<int32_t>(std::lround(this->value[1][i]));
+				break;
+			}
+			case AnimTrack::COLOR:
+			{
+				float *out = static_cast<float *>(target.out);
+				for(size_t c = 0; c < 4; c++) out[c] = this->value[c][i];
+				break;
+			}
+			case AnimTrack::OPACITY: *static_cast<float *>(target.out) = this->value[0][i]; break;
+		}
+		if(target.dirty) target.dirty->store(true, std::memory_order_relaxed);
+	}
+	
+	inline size_t find(void const *owner, AnimTrack track) const
+	{
+		for(size_t i = 0; i < this->targets.size(); i++) if(this->targets[i].owner == owner && this->targets[i].track == track) return i;
+		return this->size();
+	}
+	
+	/// Swap the last tween into slot i
+	inline void retire(size_t i)
+	{
+		size_t last = this->size() - 1;
+		this->elapsed[i] = this->elapsed[last];
+		this->invDuration[i] = this->invDuration[last];
+		this->easing[i] = this->easing[last];
+		for(size_t c = 0; c < 4; c++)
+		{
+			this->from[c][i] = this->from[c][last];
+			this->delta[c][i] = this->delta[c][last];
+		}
+		this->targets[i] = this->targets[last];
+		this->elapsed.pop_back();
+		this->invDuration.pop_back();
+		this->easing.pop_back();
+		for(size_t c = 0; c < 4; c++)
+		{
+			this->from[c].pop_back();
+			this->delta[c].pop_back();
+		}
+		this->targets.pop_back();
+	}
+	
+	std::vector<float> elapsed, invDuration; //Seconds, elapsed starts negative while delayed
+	std::vector<Easing> easing;
+	std::vector<float> from[4], delta[4];
+	std::vector<Target> targets;
+	std::vector<float> progress, value[4]; //Scratch for update()
+	Clock::time_point lastUpdate {};
+};
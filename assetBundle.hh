@@ -0,0 +1,452 @@
+#pragma once
+
+#include "mappedFile.hh"
+#include "mipmap.hh"
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+/// Compress size bytes of in into out with a small LZ77 codec in the spirit of LZ4, fast to decode and needing no library.
+/// Each sequence is a token of literal and match length nibbles, longer lengths continued in bytes of 255, the literals, then a 2 byte match offset
+inline void bundleCompress(unsigned char const *in, size_t size, std::vector<unsigned char> &out)
+{
+	static size_t constexpr minMatch = 4, hashBits = 14, maxOffset = 65535, none = ~static_cast<size_t>(0);
+	out.clear();
+	out.reserve(size / 2 + 16);
+	std::vector<size_t> table(static_cast<size_t>(1) << hashBits, none);
+	auto length = [&out](size_t remaining)
+	{
+		for(; remaining >= 255; remaining -= 255) out.push_back(255);
+		out.push_back(static_cast<unsigned char>(remaining));
+	};
+	auto sequence = [&](size_t anchor, size_t end, size_t match, size_t offset)
+	{
+		size_t literals = end - anchor, extra = match ? match - minMatch : 0;
+		out.push_back(static_cast<unsigned char>(std::min<size_t>(literals, 15) << 4 | (match ? std::min<size_t>(extra, 15) : 0)));
+		if(literals >= 15) length(literals - 15);
+		out.insert(out.end(), in + anchor, in + end);
+		if(!match) return;
+		out.push_back(static_cast<unsigned char>(offset & 255));
+		out.push_back(static_cast<unsigned char>(offset >> 8));
+		if(extra >= 15) length(extra - 15);
+	};
+	size_t anchor = 0, at = 0;
+	while(at + minMatch <= size)
+	{
+		uint32_t word;
+		memcpy(&word, in + at, 4);
+		size_t slot = static_cast<uint32_t>(word * 2654435761u) >> (32 - hashBits), candidate = table[slot];
+		table[slot] = at;
+		if(candidate == none || at - candidate > maxOffset || memcmp(in + candidate, in + at, minMatch) != 0)
+		{
+			at++;
+			continue;
+		}
+		size_t match = minMatch;
+		while(at + match < size && in[candidate + match] == in[at + match]) match++;
+		sequence(anchor, at, match, at - candidate);
+		at += match;
+		anchor = at;
+	}
+	sequence(anchor, size, 0, 0); //The last sequence is only literals, the decoder stops when it runs out of input after them
+}
+
+/// Decompress what bundleCompress() made into out, which must hold exactly rawSize bytes.  False if in is corrupt
+inline bool bundleDecompress(unsigned char const *in, size_t size, unsigned char *out, size_t rawSize)
+{
+	size_t at = 0, written = 0;
+	auto length = [&](size_t &value)
+	{
+		unsigned char next;
+		do
+		{
+			if(at >= size) return false;
+			next = in[at++];
+			value += next;
+		} while(next == 255);
+		return true;
+	};
+	while(at < size)
+	{
+		unsigned char token = in[at++];
+		size_t literals = token >> 4;
+		if(literals == 15 && !length(literals)) return false;
+		if(literals > size - at || literals > rawSize - written) return false;
+		if(literals) memcpy(out + written, in + at, literals);
+		at += literals;
+		written += literals;
+		if(at == size) break;
+		if(size - at < 2) return false;
+		size_t offset = in[at] | static_cast<size_t>(in[at + 1]) << 8, match = (token & 15) + 4;
+		at += 2;
+		if((token & 15) == 15 && !length(match)) return false;
+		if(!offset || offset > written || match > rawSize - written) return false;
+		unsigned char *to = out + written, *from = to - offset;
+		if(offset >= match) memcpy(to, from, match);
+		else for(size_t i = 0; i < match; i++) to[i] = from[i]; //Overlapping matches repeat the bytes just written
+		written += match;
+	}
+	return written == rawSize;
+}
+
+/// Bundles are written and read in the machine's byte order, which is little endian everywhere WinterUI runs
+struct BundleHeader
+{
+	char magic[4] = {'W', 'U', 'I', 'B'};
+	uint32_t version = 1;
+	uint32_t slotCount = 0, entryCount = 0; //Slots of the index, a power of 2 at most half full
+	uint64_t namesOffset = 0, dataOffset = 0;
+};
+
+enum struct BundleKind : uint8_t
+{
+	BLOB, TEXTURE
+};
+
+/// A slot of the index, empty when nameLength is 0.  Entries are found by the FNV-1a hash of their name, probing linearly from hash & (slotCount - 1)
+struct BundleEntry
+{
+	uint64_t hash = 0;
+	uint64_t offset = 0, size = 0, rawSize = 0; //Bytes stored from the start of the file and bytes once decompressed
+	uint32_t nameOffset = 0; //From BundleHeader::namesOffset
+	uint16_t nameLength = 0;
+	BundleKind kind = BundleKind::BLOB;
+	uint8_t compressed = 0;
+};
+
+static_assert(sizeof(BundleHeader) == 32 && sizeof(BundleEntry) == 40, "The bundle format is written as these structs");
+
+/// Leads a texture payload, its levels follow tightly packed, each half the size of the one before rounded down like GL
+struct BundleTextureHeader
+{
+	uint32_t width = 0, height = 0, channels = 4, levelCount = 1;
+	uint32_t srgb = 1, reserved[3] = {0, 0, 0};
+};
+
+/// A texture stored decoded in a bundle, texels point into the mapping or into the scratch it was decompressed to.  See Pixmap(BundleTexture const &)
+struct BundleTexture
+{
+	/// Texels of level and its size
+	inline unsigned char const *level(uint32_t level, uint32_t &width, uint32_t &height) const
+	{
+		unsigned char const *out = this->texels;
+		width = this->width;
+		height = this->height;
+		for(uint32_t i = 0; i < level; i++)
+		{
+			out += static_cast<size_t>(width) * height * this->channels;
+			width = std::max(width >> 1, 1u);
+			height = std::max(height >> 1, 1u);
+		}
+		return out;
+	}
+	
+	uint32_t width = 0, height = 0, channels = 4, levelCount = 0;
+	bool srgb = true;
+	unsigned char const *texels = nullptr;
+};
+
+/// Bytes of an entry read in place from the mapping
+struct AssetView
+{
+	unsigned char const *data = nullptr;
+	size_t size = 0;
+};
+
+/// A bundle of assets packed into one file by wui_pack or AssetBundleWriter and mapped with a MappedFile.
+/// Looking an asset up hashes its name into the index rather than opening a file, and uncompressed entries are read where they lie, their blobs start 64 byte aligned
+struct AssetBundle final
+{
+	inline AssetBundle() = default;
+	
+	inline explicit AssetBundle(std::string const &filePath)
+	{
+		this->open(filePath);
+	}
+	
+	/// Map filePath and check its index, false if it isn't a bundle or is truncated
+	inline bool open(std::string const &filePath)
+	{
+		this->close();
+		if(!this->file.open(filePath)) return false;
+		if(!this->validate())
+		{
+			printf("Error reading bundle %s\n", filePath.data());
+			this->close();
+			return false;
+		}
+		return true;
+	}
+	
+	inline void close()
+	{
+		this->file.close();
+		this->header = nullptr;
+		this->slots = nullptr;
+	}
+	
+	inline static uint64_t hash(std::string_view name)
+	{
+		uint64_t out = 14695981039346656037ull;
+		for(char c : name) out = (out ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+		return out;
+	}
+	
+	/// The entry named name, null if there isn't one
+	inline BundleEntry const *find(std::string_view name) const
+	{
+		if(!this->header) return nullptr;
+		uint64_t key = hash(name);
+		uint32_t mask = this->header->slotCount - 1;
+		for(uint32_t slot = static_cast<uint32_t>(key) & mask;; slot = (slot + 1) & mask)
+		{
+			BundleEntry const &entry = this->slots[slot];
+			if(!entry.nameLength) return nullptr;
+			if(entry.hash == key && this->name(entry) == name) return &entry;
+		}
+	}
+	
+	inline std::string_view name(BundleEntry const &entry) const
+	{
+		return {reinterpret_cast<char const *>(this->file.data() + this->header->namesOffset + entry.nameOffset), entry.nameLength};
+	}
+	
+	/// name's bytes straight from the mapping, without copying.  Null for missing entries and compressed ones, which need read()
+	inline AssetView view(std::string_view name) const
+	{
+		BundleEntry const *entry = this->find(name);
+		if(!entry || entry->compressed) return {};
+		return {this->file.data() + entry->offset, entry->size};
+	}
+	
+	/// Copy name's bytes into out, decompressing them if need be
+	inline bool read(std::string_view name, std::vector<unsigned char> &out) const
+	{
+		BundleEntry const *entry = this->find(name);
+		if(!entry) return false;
+		return this->read(*entry, out);
+	}
+	
+	/// name as text, like readTextFile()
+	inline std::string readText(std::string_view name) const
+	{
+		AssetView in = this->view(name);
+		if(in.data) return {reinterpret_cast<char const *>(in.data), in.size};
+		std::vector<unsigned char> bytes;
+		if(!this->read(name, bytes)) printf("Error opening asset %.*s\n", static_cast<int>(name.size()), name.data());
+		return {bytes.begin(), bytes.end()};
+	}
+	
+	/// The decoded texture name, its texels stay in the mapping unless it is compressed, then they're decompressed into scratch
+	inline bool texture(std::string_view name, BundleTexture &out, std::vector<unsigned char> &scratch) const
+	{
+		BundleEntry const *entry = this->find(name);
+		if(!entry || entry->kind != BundleKind::TEXTURE) return false;
+		unsigned char const *payload = this->file.data() + entry->offset;
+		if(entry->compressed)
+		{
+			if(!this->read(*entry, scratch)) return false;
+			payload = scratch.data();
+		}
+		BundleTextureHeader texture;
+		memcpy(&texture, payload, sizeof(texture));
+		size_t bytes = 0;
+		for(uint32_t level = 0, width = texture.width, height = texture.height; level < texture.levelCount; level++, width = std::max(width >> 1, 1u), height = std::max(height >> 1, 1u))
+		{
+			bytes += static_cast<size_t>(width) * height * texture.channels;
+		}
+		if((texture.channels != 3 && texture.channels != 4) || !texture.levelCount || entry->rawSize != sizeof(texture) + bytes) return false;
+		out = {texture.width, texture.height, texture.channels, texture.levelCount, texture.srgb != 0, payload + sizeof(texture)};
+		return true;
+	}
+	
+	inline size_t size() const
+	{
+		return this->header ? this->header->entryCount : 0;
+	}
+	
+	/// Every slot of the index, skip the ones with no name
+	inline BundleEntry const *begin() const
+	{
+		return this->slots;
+	}
+	
+	inline BundleEntry const *end() const
+	{
+		return this->header ? this->slots + this->header->slotCount : nullptr;
+	}
+
+private:
+	inline bool read(BundleEntry const &entry, std::vector<unsigned char> &out) const
+	{
+		unsigned char const *in = this->file.data() + entry.offset;
+		out.resize(entry.rawSize);
+		if(!entry.compressed)
+		{
+			std::copy(in, in + entry.size, out.begin());
+			return true;
+		}
+		if(bundleDecompress(in, entry.size, out.data(), entry.rawSize)) return true;
+		printf("Error decompressing asset %.*s\n", static_cast<int>(entry.nameLength), this->name(entry).data());
+		out.clear();
+		return false;
+	}
+	
+	/// Every offset is checked once here so lookups needn't
+	inline bool validate()
+	{
+		size_t size = this->file.size();
+		if(size < sizeof(BundleHeader)) return false;
+		BundleHeader const *in = reinterpret_cast<BundleHeader const *>(this->file.data());
+		if(memcmp(in->magic, BundleHeader{}.magic, 4) != 0 || in->version != BundleHeader{}.version) return false;
+		if(!in->slotCount || (in->slotCount & (in->slotCount - 1)) || in->entryCount >= in->slotCount) return false;
+		if(sizeof(BundleHeader) + static_cast<uint64_t>(in->slotCount) * sizeof(BundleEntry) > in->namesOffset || in->namesOffset > in->dataOffset || in->dataOffset > size) return false; //Names lie between the index and the blobs
+		BundleEntry const *index = reinterpret_cast<BundleEntry const *>(this->file.data() + sizeof(BundleHeader));
+		uint32_t entries = 0;
+		for(uint32_t slot = 0; slot < in->slotCount; slot++)
+		{
+			BundleEntry const &entry = index[slot];
+			if(!entry.nameLength) continue;
+			entries++;
+			if(entry.nameOffset + static_cast<uint64_t>(entry.nameLength) > in->dataOffset - in->namesOffset) return false;
+			if(entry.offset < in->dataOffset || entry.offset > size || entry.size > size - entry.offset) return false;
+			if(!entry.compressed && entry.size != entry.rawSize) return false;
+			if(entry.kind == BundleKind::TEXTURE && entry.rawSize < sizeof(BundleTextureHeader)) return false;
+		}
+		if(entries != in->entryCount) return false;
+		this->header = in;
+		this->slots = index;
+		return true;
+	}
+	
+	MappedFile file;
+	BundleHeader const *header = nullptr;
+	BundleEntry const *slots = nullptr;
+};
+
+/// Packs assets into a bundle for AssetBundle, see tools/pack.cc
+struct AssetBundleWriter final
+{
+	static size_t constexpr alignment = 64;
+	
+	/// Add size bytes of data as name, compressed when asked to and when that saves at least an eighth
+	inline void add(std::string name, unsigned char const *data, size_t size, bool compress = false)
+	{
+		this->add(std::move(name), BundleKind::BLOB, std::vector<unsigned char>(data, data + size), compress);
+	}
+	
+	/// Add a decoded RGB or RGBA image as a texture, with every level of its MipChain when mips is set
+	inline void addTexture(std::string name, unsigned char const *texels, uint32_t width, uint32_t height, uint32_t channels, bool srgb, bool mips = false, bool compress = false)
+	{
+		BundleTextureHeader texture {width, height, channels, 1, srgb ? 1u : 0u};
+		std::vector<unsigned char> payload(sizeof(texture));
+		if(mips)
+		{
+			MipChain chain;
+			chain.build(texels, width, height, channels, srgb);
+			texture.levelCount = static_cast<uint32_t>(chain.levels.size());
+			payload.insert(payload.end(), chain.texels(0), chain.texels(0) + chain.bytes());
+		}
+		else payload.insert(payload.end(), texels, texels + static_cast<size_t>(width) * height * channels);
+		memcpy(payload.data(), &texture, sizeof(texture));
+		this->add(std::move(name), BundleKind::TEXTURE, std::move(payload), compress);
+	}
+	
+	/// Write the bundle out, false if filePath can't be written or two entries share a name
+	inline bool write(std::string const &filePath) const
+	{
+		BundleHeader header;
+		header.entryCount = static_cast<uint32_t>(this->entries.size());
+		header.slotCount = 16;
+		while(header.slotCount < header.entryCount * 2 + 1) header.slotCount <<= 1;
+		std::vector<BundleEntry> index(header.slotCount);
+		std::string names;
+		header.namesOffset = sizeof(BundleHeader) + static_cast<uint64_t>(header.slotCount) * sizeof(BundleEntry);
+		for(Pending const &pending : this->entries) names += pending.name;
+		header.dataOffset = align(header.namesOffset + names.size());
+		uint64_t offset = header.dataOffset, nameOffset = 0;
+		for(Pending const &pending : this->entries)
+		{
+			BundleEntry entry;
+			entry.hash = AssetBundle::hash(pending.name);
+			entry.offset = offset;
+			entry.size = pending.bytes.size();
+			entry.rawSize = pending.rawSize;
+			entry.nameOffset = static_cast<uint32_t>(nameOffset);
+			entry.nameLength = static_cast<uint16_t>(pending.name.size());
+			entry.kind = pending.kind;
+			entry.compressed = pending.compressed;
+			nameOffset += pending.name.size();
+			offset = align(offset + entry.size);
+			uint32_t slot = static_cast<uint32_t>(entry.hash) & (header.slotCount - 1);
+			for(; index[slot].nameLength; slot = (slot + 1) & (header.slotCount - 1))
+			{
+				if(index[slot].hash == entry.hash && names.compare(index[slot].nameOffset, index[slot].nameLength, pending.name) == 0)
+				{
+					printf("Error packing bundle %s, %s was added twice\n", filePath.data(), pending.name.data());
+					return false;
+				}
+			}
+			index[slot] = entry;
+		}
+		FILE *out = fopen(filePath.data(), "wb");
+		if(!out)
+		{
+			printf("Error opening file %s\n", filePath.data());
+			return false;
+		}
+		static unsigned char const zeros[alignment] = {};
+		uint64_t written = sizeof(header) + index.size() * sizeof(BundleEntry) + names.size();
+		fwrite(&header, sizeof(header), 1, out);
+		fwrite(index.data(), sizeof(BundleEntry), index.size(), out);
+		fwrite(names.data(), 1, names.size(), out);
+		for(Pending const &pending : this->entries)
+		{
+			fwrite(zeros, 1, align(written) - written, out);
+			if(!pending.bytes.empty()) fwrite(pending.bytes.data(), 1, pending.bytes.size(), out);
+			written = align(written) + pending.bytes.size();
+		}
+		bool failed = ferror(out) != 0;
+		fclose(out);
+		if(failed) printf("Error writing file %s\n", filePath.data());
+		return !failed;
+	}
+
+private:
+	struct Pending
+	{
+		std::string name;
+		BundleKind kind;
+		std::vector<unsigned char> bytes;
+		uint64_t rawSize;
+		bool compressed;
+	};
+	
+	inline static uint64_t align(uint64_t offset)
+	{
+		return (offset + alignment - 1) / alignment * alignment;
+	}
+	
+	inline void add(std::string name, BundleKind kind, std::vector<unsigned char> bytes, bool compress)
+	{
+		if(name.empty() || name.size() > UINT16_MAX) return;
+		uint64_t rawSize = bytes.size();
+		bool compressed = false;
+		if(compress)
+		{
+			std::vector<unsigned char> packed;
+			bundleCompress(bytes.data(), bytes.size(), packed);
+			compressed = packed.size() < bytes.size() - bytes.size() / 8;
+			if(compressed) bytes = std::move(packed);
+		}
+		this->entries.push_back({std::move(name), kind, std::move(bytes), rawSize, compressed});
+	}
+	
+	std::vector<Pending> entries;
+};
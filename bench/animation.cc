@@ -0,0 +1,28 @@
+#include "animation.hh"
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+/// range(0) widgets each fading opacity and moving, the tweens are long enough to never finish
+static void animatorUpdate(benchmark::State &state)
+{
+	Animator &animator = Animator::instance();
+	size_t count = static_cast<size_t>(state.range(0));
+	std::vector<IR::vec2<int32_t>> pos(count);
+	std::vector<float> opacity(count, 1);
+	std::vector<std::atomic<bool>> dirty(count);
+	Easing easings[] = {Easing::LINEAR, Easing::EASE_OUT, Easing::SMOOTHSTEP, Easing::SMOOTHERSTEP};
+	for(size_t i = 0; i < count; i++)
+	{
+		animator.animate(&pos[i], AnimTrack::POSITION, &pos[i][0], &dirty[i], {400, 300, 0, 0}, 1e6f, easings[i % 4]);
+		animator.animate(&pos[i], AnimTrack::OPACITY, &opacity[i], &dirty[i], {0, 0, 0, 0}, 1e6f, easings[(i + 1) % 4]);
+	}
+	for(auto _ : state)
+	{
+		animator.update(1.0f / 60.0f);
+		benchmark::DoNotOptimize(pos.data());
+	}
+	animator.clear();
+	state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+}
+BENCHMARK(animatorUpdate)->Arg(1 << 8)->Arg(1 << 12);
@@ -0,0 +1,139 @@
+#include "sharedAssets.hh"
+
+#include <benchmark/benchmark.h>
+
+/// Build and submit a batch of range(0) quads, the recording device only counts what reaches it
+static void batchBuild(benchmark::State &state)
+{
+	Mesh mesh;
+	Shader shader(guiInstancedVertShader, guiInstancedFragShader);
+	QuadBatch batch;
+	size_t count = static_cast<size_t>(state.range(0));
+	batch.instances.reserve(count);
+	RecordingDevice::resetStats();
+	for(auto _ : state)
+	{
+		batch.clear();
+		for(size_t i = 0; i < count; i++)
+		{
+			float x = static_cast<float>(i % 64) * 60, y = static_cast<float>(i / 64) * 30;
+			batch.add({{x, y, 56, 26}, {0, 0, 1, 1}, {1, 1, 1, 1}, static_cast<float>(i % 8)});
+		}
+		shader.bind();
+		mesh.bind();
+		batch.draw(mesh);
+		mesh.endFrame();
+		CommandEncoder::current().endFrame();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.counters["draws"] = benchmark::Counter(static_cast<double>(RecordingDevice::stats().instancedDraws), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(batchBuild)->Arg(1 << 10)->Arg(1 << 16);
+
+/// The same quads written straight into the stream buffer instead of through the batch's vector
+static void batchMapped(benchmark::State &state)
+{
+	Mesh mesh;
+	Shader shader(guiInstancedVertShader, guiInstancedFragShader);
+	size_t count = static_cast<size_t>(state.range(0));
+	for(auto _ : state)
+	{
+		QuadInstance *out = mesh.mapInstances(count);
+		for(size_t i = 0; i < count; i++)
+		{
+			float x = static_cast<float>(i % 64) * 60, y = static_cast<float>(i / 64) * 30;
+			out[i] = {{x, y, 56, 26}, {0, 0, 1, 1}, {1, 1, 1, 1}, static_cast<float>(i % 8)};
+		}
+		shader.bind();
+		mesh.bind();
+		mesh.drawInstanced(count);
+		mesh.endFrame();
+		CommandEncoder::current().endFrame();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(batchMapped)->Arg(1 << 10)->Arg(1 << 16);
+
+/// One draw per widget the way Pane::render does it, mostly redundant binds the encoder drops
+static void perWidgetDraws(benchmark::State &state)
+{
+	Mesh mesh;
+	Shader shader;
+	RecordingDevice::resetStats();
+	for(auto _ : state)
+	{
+		for(int64_t i = 0; i < state.range(0); i++)
+		{
+			shader.bind();
+			mesh.bind();
+			shader.sendMat4f("mvp", IR::mat4x4<float>{});
+			mesh.draw();
+		}
+		CommandEncoder::current().endFrame();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.counters["elided"] = benchmark::Counter(static_cast<double>(CommandEncoder::current().stats().elided));
+}
+BENCHMARK(perWidgetDraws)->Arg(1 << 10);
+
+/// range(0) widgets drawn as a shadow and a bordered rounded rect each, in the same single draw as textured quads would be.
+/// pixmapBytes is what baking each widget's look into its own RGBA8 pixmap would have cost instead
+static void batchShapes(benchmark::State &state)
+{
+	Mesh mesh;
+	Shader shader(guiInstancedVertShader, guiInstancedFragShader);
+	QuadBatch batch;
+	size_t count = static_cast<size_t>(state.range(0));
+	float constexpr blur = 6;
+	batch.instances.reserve(count * 2);
+	RecordingDevice::resetStats();
+	for(auto _ : state)
+	{
+		batch.clear();
+		for(size_t i = 0; i < count; i++)
+		{
+			float x = static_cast<float>(i % 64) * 60, y = static_cast<float>(i / 64) * 30;
+			batch.add(QuadInstance::shadow({x + 2, y - 2, 56, 26}, {4, 4, 4, 4}, {0, 0, 0, 0.4f}, blur, static_cast<float>(i % 8)));
+			batch.add(QuadInstance::roundedRect({x, y, 56, 26}, {4, 4, 4, 4}, {0.2f, 0.4f, 0.8f, 1}, static_cast<float>(i % 8), 1, {1, 1, 1, 1}));
+		}
+		shader.bind();
+		mesh.bind();
+		batch.draw(mesh);
+		mesh.endFrame();
+		CommandEncoder::current().endFrame();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.counters["draws"] = benchmark::Counter(static_cast<double>(RecordingDevice::stats().instancedDraws), benchmark::Counter::kAvgIterations);
+	state.counters["pixmapBytes"] = static_cast<double>(count) * (56 + blur * 2 + 2) * (26 + blur * 2 + 2) * 4;
+}
+BENCHMARK(batchShapes)->Arg(1 << 10)->Arg(1 << 16);
+
+/// range(0) nine-sliced widgets resized every frame, each is up to 9 quads from the same pixmap and no texture is touched
+static void batchNineSlice(benchmark::State &state)
+{
+	Mesh mesh;
+	Shader shader(guiInstancedVertShader, guiInstancedFragShader);
+	QuadBatch batch;
+	NineSlice frame {32, 32, {8, 8, 8, 8}};
+	size_t count = static_cast<size_t>(state.range(0));
+	batch.instances.reserve(count * 9);
+	float grow = 0;
+	for(auto _ : state)
+	{
+		batch.clear();
+		grow = grow < 32 ? grow + 1 : 0;
+		for(size_t i = 0; i < count; i++)
+		{
+			float x = static_cast<float>(i % 64) * 60, y = static_cast<float>(i / 64) * 30;
+			batch.addNineSlice(frame, {x, y, 24 + grow, 26}, {1, 1, 1, 1}, static_cast<float>(i % 8));
+		}
+		shader.bind();
+		mesh.bind();
+		batch.draw(mesh);
+		mesh.endFrame();
+		CommandEncoder::current().endFrame();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.counters["quads"] = static_cast<double>(batch.instances.size());
+}
+BENCHMARK(batchNineSlice)->Arg(1 << 10)->Arg(1 << 16);
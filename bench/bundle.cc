@@ -0,0 +1,85 @@
+#include "assetBundle.hh"
+#include "util.hh"
+
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <cstdio>
+
+static size_t constexpr assetCount = 400;
+
+/// A theme's worth of small text assets, as loose files in a temporary directory and packed into bundles beside them, plain and compressed
+static std::filesystem::path const &benchAssets()
+{
+	static std::filesystem::path out = []
+	{
+		std::filesystem::path root = std::filesystem::temp_directory_path() / "wui_bench_assets";
+		std::filesystem::create_directories(root / "loose");
+		AssetBundleWriter plain, compressed;
+		for(size_t i = 0; i < assetCount; i++)
+		{
+			std::string text;
+			for(size_t line = 0; line < 40 + i % 200; line++) text += "widget." + std::to_string(i) + ".style" + std::to_string(line) + " = { color: #" + std::to_string(line * 2654435761u % 999983) + "; radius: 4; }\n";
+			std::string name = "theme/asset" + std::to_string(i) + ".txt";
+			std::filesystem::create_directories((root / "loose" / name).parent_path());
+			FILE *file = fopen((root / "loose" / name).string().data(), "wb");
+			fwrite(text.data(), 1, text.size(), file);
+			fclose(file);
+			plain.add(name, reinterpret_cast<unsigned char const *>(text.data()), text.size());
+			compressed.add(name, reinterpret_cast<unsigned char const *>(text.data()), text.size(), true);
+		}
+		plain.write((root / "plain.wuib").string());
+		compressed.write((root / "compressed.wuib").string());
+		return root;
+	}();
+	return out;
+}
+
+static std::vector<std::string> const &assetNames()
+{
+	static std::vector<std::string> out = []
+	{
+		std::vector<std::string> names;
+		for(size_t i = 0; i < assetCount; i++) names.push_back("theme/asset" + std::to_string(i) + ".txt");
+		return names;
+	}();
+	return out;
+}
+
+/// Reading every asset at startup as a file of its own through readTextFile()
+static void startupLooseFiles(benchmark::State &state)
+{
+	std::string root = (benchAssets() / "loose").string() + "/";
+	for(auto _ : state)
+	{
+		size_t bytes = 0;
+		for(std::string const &name : assetNames()) bytes += readTextFile(root + name).size();
+		benchmark::DoNotOptimize(bytes);
+	}
+	state.SetItemsProcessed(state.iterations() * assetCount);
+}
+BENCHMARK(startupLooseFiles)->Unit(benchmark::kMicrosecond);
+
+/// Opening a bundle and reading every asset from it.  range(0) 0 views them in place touching a byte of every page, 1 copies them out as text, 2 decompresses them
+static void startupBundle(benchmark::State &state)
+{
+	std::string path = (benchAssets() / (state.range(0) == 2 ? "compressed.wuib" : "plain.wuib")).string();
+	for(auto _ : state)
+	{
+		AssetBundle bundle(path);
+		size_t bytes = 0;
+		for(std::string const &name : assetNames())
+		{
+			if(state.range(0)) bytes += bundle.readText(name).size();
+			else
+			{
+				AssetView view = bundle.view(name);
+				for(size_t at = 0; at < view.size; at += 4096) bytes += view.data[at];
+			}
+		}
+		benchmark::DoNotOptimize(bytes);
+	}
+	state.SetItemsProcessed(state.iterations() * assetCount);
+}
+BENCHMARK(startupBundle)->Arg(0)->Arg(1)->Arg(2)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,128 @@
+#include "culling.hh"
+#include "definitions.hh"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+/// Stands in for a widget, the per widget test walks the tree through SP children the way Widget does
+struct CullNode
+{
+	IR::aabb2D<int32_t> hitbox;
+	bool clipChildren = false;
+	std::vector<SP<CullNode>> children;
+	
+	inline void collect(CullList &list) const
+	{
+		list.push(this->hitbox);
+		if(this->children.empty()) return;
+		if(this->clipChildren) list.pushClip(this->hitbox);
+		for(auto &child : this->children) child->collect(list);
+		if(this->clipChildren) list.popClip();
+	}
+	
+	inline void countVisible(IR::aabb2D<int32_t> const &clip, size_t &visible) const
+	{
+		IR::aabb2D<int32_t> inner(std::max(clip.minX, this->hitbox.minX), std::min(clip.maxX, this->hitbox.maxX), std::max(clip.minY, this->hitbox.minY), std::min(clip.maxY, this->hitbox.maxY));
+		if(this->hitbox.minX < clip.maxX && clip.minX < this->hitbox.maxX && this->hitbox.minY < clip.maxY && clip.minY < this->hitbox.maxY) visible++;
+		if(this->clipChildren && (inner.minX >= inner.maxX || inner.minY >= inner.maxY)) return;
+		for(auto &child : this->children) child->countVisible(this->clipChildren ? inner : clip, visible);
+	}
+};
+
+/// A 4K window tiled with 100 scrolling panes, each split into 10 scrolling columns of 100 rows, 100k rects and most of them scrolled out of view.
+/// Every column overlaps its pane, so nothing is pruned before its rows are tested
+static SP<CullNode> buildScene()
+{
+	std::mt19937 rng(1);
+	std::uniform_int_distribution<int32_t> jitter(0, 8), scroll(0, 1800);
+	SP<CullNode> root = MS<CullNode>();
+	root->hitbox = {0, 3840, 0, 2160};
+	for(int32_t pane = 0; pane < 100; pane++)
+	{
+		SP<CullNode> outer = MS<CullNode>();
+		int32_t x = (pane % 10) * 384, y = 2160 - (pane / 10) * 216;
+		outer->hitbox = {x, x + 384, y - 216, y};
+		outer->clipChildren = true;
+		for(int32_t column = 0; column < 10; column++)
+		{
+			SP<CullNode> inner = MS<CullNode>();
+			int32_t left = x + column * 38, top = y + scroll(rng);
+			inner->hitbox = {left, left + 36, y - 216, y};
+			inner->clipChildren = true;
+			for(int32_t row = 0; row < 100; row++)
+			{
+				SP<CullNode> item = MS<CullNode>();
+				int32_t rowTop = top - row * 20;
+				item->hitbox = {left + jitter(rng), left + 36, rowTop - 18, rowTop};
+				inner->children.push_back(item);
+			}
+			outer->children.push_back(inner);
+		}
+		root->children.push_back(outer);
+	}
+	return root;
+}
+
+static IR::aabb2D<int32_t> const viewport {0, 3840, 0, 2160};
+
+/// One overlap test per widget while walking the tree, clips narrowed on the way down
+static void cullPerWidget(benchmark::State &state)
+{
+	SP<CullNode> root = buildScene();
+	CullList list;
+	root->collect(list);
+	for(auto _ : state)
+	{
+		size_t visible = 0;
+		root->countVisible(viewport, visible);
+		benchmark::DoNotOptimize(visible);
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(list.size()));
+}
+BENCHMARK(cullPerWidget);
+
+/// Flattening the tree into a CullList, paid once per frame before culling
+static void cullCollect(benchmark::State &state)
+{
+	SP<CullNode> root = buildScene();
+	CullList list;
+	for(auto _ : state)
+	{
+		list.clear();
+		root->collect(list);
+		benchmark::DoNotOptimize(list.size());
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(list.size()));
+}
+BENCHMARK(cullCollect);
+
+template <typename Backend> static void cullMask(benchmark::State &state)
+{
+	CullList list;
+	buildScene()->collect(list);
+	std::vector<uint64_t> visible;
+	for(auto _ : state)
+	{
+		list.cull<Backend>(viewport, visible);
+		benchmark::DoNotOptimize(visible.data());
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(list.size()));
+}
+BENCHMARK_TEMPLATE(cullMask, IR::simd::Scalar);
+BENCHMARK_TEMPLATE(cullMask, IR::simd::Native);
+
+template <typename Backend> static void cullIndices(benchmark::State &state)
+{
+	CullList list;
+	buildScene()->collect(list);
+	std::vector<uint32_t> visible;
+	for(auto _ : state)
+	{
+		list.cull<Backend>(viewport, visible);
+		benchmark::DoNotOptimize(visible.data());
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(list.size()));
+}
+BENCHMARK_TEMPLATE(cullIndices, IR::simd::Scalar);
+BENCHMARK_TEMPLATE(cullIndices, IR::simd::Native);
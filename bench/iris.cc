@@ -0,0 +1,151 @@
+#include <iris/mat4.hh>
+#include <iris/vec4.hh>
+#include <iris/quaternion.hh>
+#include <iris/shapes.hh>
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+static void mat4Multiply(benchmark::State &state)
+{
+	IR::mat4x4<float> a = IR::mat4x4<float>::modelMatrix({10, 20, 1}, {}, {300, 40, 1});
+	IR::mat4x4<float> b = IR::mat4x4<float>::orthoProjectionMatrix(0, 3840, 2160, 0, 1, 100);
+	for(auto _ : state)
+	{
+		benchmark::DoNotOptimize(a);
+		benchmark::DoNotOptimize(b);
+		IR::mat4x4<float> out = b * a;
+		benchmark::DoNotOptimize(out);
+	}
+}
+BENCHMARK(mat4Multiply);
+
+/// The mat4x4<float> kernels on the scalar backend and on the one this build selected, the gap is the SIMD speedup
+template <typename Backend> static void mat4MultiplyKernel(benchmark::State &state)
+{
+	IR::mat4x4<float> a = IR::mat4x4<float>::modelMatrix({10, 20, 1}, {}, {300, 40, 1});
+	IR::mat4x4<float> b = IR::mat4x4<float>::orthoProjectionMatrix(0, 3840, 2160, 0, 1, 100), out;
+	for(auto _ : state)
+	{
+		benchmark::DoNotOptimize(a);
+		IR::simd::mat4Multiply<Backend>(&a[0][0], &b[0][0], &out[0][0]);
+		benchmark::DoNotOptimize(out);
+	}
+}
+BENCHMARK_TEMPLATE(mat4MultiplyKernel, IR::simd::Scalar);
+BENCHMARK_TEMPLATE(mat4MultiplyKernel, IR::simd::Native);
+
+template <typename Backend> static void mat4InverseKernel(benchmark::State &state)
+{
+	IR::mat4x4<float> a = IR::mat4x4<float>::modelMatrix({10, 20, 1}, IR::quat<float>{}, {300, 40, 1}) * IR::mat4x4<float>::orthoProjectionMatrix(0, 3840, 2160, 0, 1, 100), out;
+	for(auto _ : state)
+	{
+		benchmark::DoNotOptimize(a);
+		IR::simd::mat4Inverse<Backend>(&a[0][0], &out[0][0]);
+		benchmark::DoNotOptimize(out);
+	}
+}
+BENCHMARK_TEMPLATE(mat4InverseKernel, IR::simd::Scalar);
+BENCHMARK_TEMPLATE(mat4InverseKernel, IR::simd::Native);
+
+template <typename Backend> static void mat4TransposeKernel(benchmark::State &state)
+{
+	IR::mat4x4<float> a = IR::mat4x4<float>::modelMatrix({10, 20, 1}, {}, {300, 40, 1}), out;
+	for(auto _ : state)
+	{
+		benchmark::DoNotOptimize(a);
+		IR::simd::mat4Transpose<Backend>(&a[0][0], &out[0][0]);
+		benchmark::DoNotOptimize(out);
+	}
+}
+BENCHMARK_TEMPLATE(mat4TransposeKernel, IR::simd::Scalar);
+BENCHMARK_TEMPLATE(mat4TransposeKernel, IR::simd::Native);
+
+/// Batch transforms of range(0) points, the 2D one is what projecting quad corners needs
+template <typename Backend> static void vec4TransformKernel(benchmark::State &state)
+{
+	IR::mat4x4<float> m = IR::mat4x4<float>::orthoProjectionMatrix(0, 3840, 2160, 0, 1, 100);
+	std::vector<IR::vec4<float>> points(static_cast<size_t>(state.range(0)), IR::vec4<float>{10, 20, 1, 1});
+	for(auto _ : state)
+	{
+		IR::simd::vec4Transform<Backend>(&m[0][0], points[0].data, points[0].data, points.size());
+		benchmark::DoNotOptimize(points.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(vec4TransformKernel, IR::simd::Scalar)->Arg(4096);
+BENCHMARK_TEMPLATE(vec4TransformKernel, IR::simd::Native)->Arg(4096);
+
+template <typename Backend> static void vec2TransformKernel(benchmark::State &state)
+{
+	IR::mat4x4<float> m = IR::mat4x4<float>::orthoProjectionMatrix(0, 3840, 2160, 0, 1, 100);
+	std::vector<IR::vec2<float>> points(static_cast<size_t>(state.range(0)), IR::vec2<float>{10, 20});
+	for(auto _ : state)
+	{
+		IR::simd::vec2Transform<Backend>(&m[0][0], points[0].data, points[0].data, points.size());
+		benchmark::DoNotOptimize(points.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(vec2TransformKernel, IR::simd::Scalar)->Arg(4096);
+BENCHMARK_TEMPLATE(vec2TransformKernel, IR::simd::Native)->Arg(4096);
+
+/// The per widget transform Pane::render builds every frame
+static void mat4ModelViewProjection(benchmark::State &state)
+{
+	IR::vec2<int32_t> pos {10, 20}, size {300, 40};
+	for(auto _ : state)
+	{
+		benchmark::DoNotOptimize(pos);
+		IR::mat4x4<float> mvp = IR::mat4x4<float>::modelViewProjectionMatrix(IR::mat4x4<float>::modelMatrix({pos, 1}, {}, {size, 1}),
+		                                                                     IR::mat4x4<float>::viewMatrix({}, {}),
+		                                                                     IR::mat4x4<float>::orthoProjectionMatrix(0, 3840, 2160, 0, 1, 100));
+		benchmark::DoNotOptimize(mvp);
+	}
+}
+BENCHMARK(mat4ModelViewProjection);
+
+static std::vector<IR::aabb2D<int32_t>> randomBoxes(size_t count)
+{
+	std::mt19937 rng(1);
+	std::uniform_int_distribution<int32_t> posDist(0, 3840), sizeDist(8, 400);
+	std::vector<IR::aabb2D<int32_t>> out;
+	out.reserve(count);
+	for(size_t i = 0; i < count; i++)
+	{
+		int32_t x = posDist(rng), y = posDist(rng);
+		out.emplace_back(x, x + sizeDist(rng), y - sizeDist(rng), y);
+	}
+	return out;
+}
+
+/// Which of range(0) hitboxes a moving cursor is over
+static void aabbContainsPoint(benchmark::State &state)
+{
+	std::vector<IR::aabb2D<int32_t>> boxes = randomBoxes(static_cast<size_t>(state.range(0)));
+	int32_t x = 0;
+	for(auto _ : state)
+	{
+		x = (x + 7) % 3840;
+		size_t hits = 0;
+		for(auto &box : boxes) hits += box.containsPoint(x, 1080);
+		benchmark::DoNotOptimize(hits);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(aabbContainsPoint)->Arg(1 << 10)->Arg(1 << 16);
+
+static void aabbIntersecting(benchmark::State &state)
+{
+	std::vector<IR::aabb2D<int32_t>> boxes = randomBoxes(static_cast<size_t>(state.range(0)));
+	IR::aabb2D<int32_t> clip(0, 1920, 0, 1080);
+	for(auto _ : state)
+	{
+		size_t hits = 0;
+		for(auto &box : boxes) hits += box.isIntersecting(clip);
+		benchmark::DoNotOptimize(hits);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(aabbIntersecting)->Arg(1 << 10)->Arg(1 << 16);
@@ -0,0 +1,80 @@
+#include "layout.hh"
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+/// Stands in for a widget, Widget::applyLayout() walks its children the same way
+struct LayoutNode
+{
+	IR::vec2<int32_t> pos, size, minSize;
+	float stretch = 1;
+	Layout *layout = nullptr;
+	std::vector<LayoutNode> children;
+	
+	inline void applyLayout(std::vector<LayoutItem> &items)
+	{
+		if(this->layout && !this->children.empty())
+		{
+			items.resize(this->children.size());
+			for(size_t i = 0; i < items.size(); i++) items[i] = {this->children[i].minSize, {}, {}, this->children[i].stretch};
+			this->layout->arrange(this->pos, this->size, items.data(), items.size());
+			for(size_t i = 0; i < items.size(); i++)
+			{
+				this->children[i].pos = items[i].pos;
+				this->children[i].size = items[i].size;
+			}
+		}
+		for(auto &child : this->children) child.applyLayout(items);
+	}
+};
+
+static VBoxLayout vbox;
+static HBoxLayout hbox;
+static FlexBoxLayout flex;
+
+/// A tree alternating vertical, horizontal and wrapping layouts, fanout children per node
+static void buildTree(LayoutNode &node, int64_t depth, int64_t fanout, size_t &count)
+{
+	count++;
+	node.minSize = {16, 12};
+	node.stretch = static_cast<float>(count % 3);
+	if(!depth) return;
+	Layout *layouts[] = {&vbox, &hbox, &flex};
+	node.layout = layouts[depth % 3];
+	node.children.resize(static_cast<size_t>(fanout));
+	for(auto &child : node.children) buildTree(child, depth - 1, fanout, count);
+}
+
+static void layoutTree(benchmark::State &state)
+{
+	LayoutNode root;
+	size_t count = 0;
+	buildTree(root, state.range(0), state.range(1), count);
+	root.pos = {0, 2160};
+	root.size = {3840, 2160};
+	std::vector<LayoutItem> items;
+	for(auto _ : state)
+	{
+		root.applyLayout(items);
+		benchmark::DoNotOptimize(root.children.data());
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+	state.counters["nodes"] = static_cast<double>(count);
+}
+BENCHMARK(layoutTree)->Args({3, 10})->Args({4, 10})->Args({2, 300});
+
+/// One wide flat list of the kind a long menu or list produces
+static void layoutFlat(benchmark::State &state)
+{
+	std::vector<LayoutItem> items(static_cast<size_t>(state.range(0)));
+	for(size_t i = 0; i < items.size(); i++) items[i] = {{40 + static_cast<int32_t>(i % 50), 20}, {}, {}, 1};
+	Layout *layouts[] = {&vbox, &hbox, &flex};
+	Layout *layout = layouts[state.range(1)];
+	for(auto _ : state)
+	{
+		layout->arrange({0, 2160}, {3840, 2160}, items.data(), items.size());
+		benchmark::DoNotOptimize(items.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(layoutFlat)->ArgsProduct({{1 << 10, 1 << 16}, {0, 1, 2}});
@@ -0,0 +1,193 @@
+#include "virtualList.hh"
+
+#include <benchmark/benchmark.h>
+#include <random>
+
+/// Stands in for a row widget, binding and placing it is what ListView::refresh() does per row
+struct BenchRow
+{
+	size_t item = 0;
+	int64_t top = 0;
+	int32_t height = 0;
+};
+
+static size_t constexpr itemCount = 1000000;
+static int64_t constexpr viewHeight = 2160, overscan = 4;
+
+static int32_t itemHeight(size_t item)
+{
+	return 20 + static_cast<int32_t>(item % 7) * 4;
+}
+
+/// A million row list scrolled the way ListView does it, uniform rows are 24 pixels tall and variable ones between 20 and 44
+struct BenchList
+{
+	inline explicit BenchList(bool uniform)
+	{
+		if(uniform) this->heights.uniform(itemCount, 24);
+		else this->heights.assign(itemCount, itemHeight);
+	}
+	
+	inline void scrollTo(int64_t offset)
+	{
+		this->scroll = std::clamp<int64_t>(offset, 0, std::max<int64_t>(this->heights.total() - viewHeight, 0));
+		size_t first = this->heights.find(this->scroll), end = this->heights.find(this->scroll + viewHeight - 1) + 1;
+		first = first > overscan ? first - overscan : 0;
+		end = std::min<size_t>(end + overscan, itemCount);
+		this->rows.show(first, end, []{return MS<BenchRow>();}, [](BenchRow &row, size_t item){row.item = item;}, [](BenchRow &row, size_t){row.item = 0;});
+		this->rows.forEach([&](BenchRow &row, size_t item)
+		{
+			row.top = this->heights.offset(item) - this->scroll;
+			row.height = this->heights.height(item);
+		});
+	}
+	
+	HeightIndex heights;
+	RowRecycler<BenchRow> rows;
+	int64_t scroll = 0;
+};
+
+/// Building the height index of a million variable height items, paid when the list's source is set or changes
+static void listHeightIndex(benchmark::State &state)
+{
+	HeightIndex heights;
+	for(auto _ : state)
+	{
+		heights.assign(itemCount, itemHeight);
+		benchmark::DoNotOptimize(heights.total());
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(itemCount));
+}
+BENCHMARK(listHeightIndex)->Unit(benchmark::kMillisecond);
+
+/// Smooth scrolling through a million rows range(0) pixels a frame and wrapping at the end, range(1) picks uniform heights
+static void listScroll(benchmark::State &state)
+{
+	BenchList list(state.range(1));
+	int64_t step = state.range(0);
+	for(auto _ : state)
+	{
+		int64_t before = list.scroll;
+		list.scrollTo(list.scroll + step);
+		if(list.scroll == before) list.scrollTo(0);
+	}
+	state.counters["rows"] = static_cast<double>(list.rows.rowCount());
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(listScroll)->Args({8, 0})->Args({400, 0})->Args({8, 1})->Args({400, 1});
+
+/// Jumping to random places in a million rows, every row is rebound each time
+static void listJump(benchmark::State &state)
+{
+	BenchList list(false);
+	std::mt19937_64 rng(1);
+	std::uniform_int_distribution<int64_t> offset(0, list.heights.total());
+	for(auto _ : state) list.scrollTo(offset(rng));
+	state.counters["rows"] = static_cast<double>(list.rows.rowCount());
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(listJump);
+
+/// A million row table's columns, sorted the way TableView's worker does it.  The thread that renders only swaps the result in
+template <TableColumn::Type type> static void tableSort(benchmark::State &state)
+{
+	std::mt19937_64 rng(1);
+	std::vector<int64_t> ints(itemCount);
+	std::vector<double> floats(itemCount);
+	std::vector<std::string> texts(type == TableColumn::Type::TEXT ? itemCount : 0);
+	for(size_t i = 0; i < itemCount; i++)
+	{
+		ints[i] = static_cast<int64_t>(rng() % 100000) - 50000;
+		floats[i] = static_cast<double>(ints[i]) * 0.25;
+		if(!texts.empty()) texts[i] = "asset_" + std::to_string(rng() % 100000);
+	}
+	TableColumn column = type == TableColumn::Type::INT ? TableColumn::of(ints.data(), itemCount) : type == TableColumn::Type::FLOAT ? TableColumn::of(floats.data(), itemCount) : TableColumn::of(texts.data(), itemCount);
+	std::vector<uint32_t> order;
+	for(auto _ : state)
+	{
+		sortRows(column, true, order);
+		benchmark::DoNotOptimize(order.data());
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(itemCount));
+}
+BENCHMARK_TEMPLATE(tableSort, TableColumn::Type::INT)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(tableSort, TableColumn::Type::FLOAT)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(tableSort, TableColumn::Type::TEXT)->Unit(benchmark::kMillisecond);
+
+/// Formatting the cells of a screenful of a 300 column table, what a TableView pays when every visible cell is rebound
+static void tableFormat(benchmark::State &state)
+{
+	std::vector<double> floats(itemCount);
+	for(size_t i = 0; i < itemCount; i++) floats[i] = static_cast<double>(i) * 0.37;
+	TableColumn column = TableColumn::of(floats.data(), itemCount);
+	std::vector<std::string> text(90 * 8);
+	for(auto _ : state)
+	{
+		for(size_t i = 0; i < text.size(); i++) formatCell(column, i * 997 % itemCount, text[i]);
+		benchmark::DoNotOptimize(text.data());
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+BENCHMARK(tableFormat);
+
+/// 50 top level nodes with 100 children with 100 children each, 505,050 nodes once everything is expanded.  Ids are the node's path in base 1000
+static void treeChildren(uint64_t node, std::vector<uint64_t> &out)
+{
+	uint64_t count = node == 0 ? 50 : node < 1000 * 1000 ? 100 : 0;
+	for(uint64_t i = 1; i <= count; i++) out.push_back(node * 1000 + i);
+}
+
+static void expandAll(TreeIndex &tree)
+{
+	std::vector<uint64_t> topLevel;
+	treeChildren(0, topLevel);
+	tree.reset(topLevel);
+	for(uint32_t node = 0; node < tree.size(); node++) tree.expand(node, treeChildren); //Nodes loaded by the loop are visited by it too
+}
+
+/// Loading and expanding every node, one level at a time the way a user opening everything would
+static void treeExpandAll(benchmark::State &state)
+{
+	TreeIndex tree;
+	for(auto _ : state)
+	{
+		expandAll(tree);
+		benchmark::DoNotOptimize(tree.rowCount());
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(tree.size()));
+}
+BENCHMARK(treeExpandAll)->Unit(benchmark::kMillisecond);
+
+/// Collapsing and re-expanding a top level node in the middle of the fully expanded tree, splicing its 10,100 rows out and back in
+static void treeToggle(benchmark::State &state)
+{
+	TreeIndex tree;
+	expandAll(tree);
+	uint32_t node = tree.find(25);
+	for(auto _ : state)
+	{
+		tree.collapse(node);
+		tree.expand(node, treeChildren);
+	}
+	state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(treeToggle);
+
+/// Finding the row of random nodes of the fully expanded tree, what scrolling to a node costs.  range(0) scans the rows instead to compare
+static void treeRowOf(benchmark::State &state)
+{
+	TreeIndex tree;
+	expandAll(tree);
+	std::mt19937 rng(1);
+	std::uniform_int_distribution<uint32_t> pick(0, static_cast<uint32_t>(tree.size() - 1));
+	for(auto _ : state)
+	{
+		uint32_t node = pick(rng);
+		size_t row = 0;
+		if(state.range(0)) while(tree.nodeAt(row) != node) row++;
+		else row = tree.rowOf(node);
+		benchmark::DoNotOptimize(row);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(treeRowOf)->Arg(0)->Arg(1);
@@ -0,0 +1,47 @@
+#include "pixmap.hh"
+
+#include <benchmark/benchmark.h>
+
+/// A 1024x1024 RGBA sRGB image, noisy so nothing is uniform
+static std::vector<unsigned char> const &benchImage()
+{
+	static std::vector<unsigned char> out = []
+	{
+		std::vector<unsigned char> image(1024 * 1024 * 4);
+		for(size_t i = 0; i < image.size(); i++) image[i] = static_cast<unsigned char>((i * 2654435761u) >> 13);
+		return image;
+	}();
+	return out;
+}
+
+/// Building every level of the image, range(0) picks the filter and range(1) splits the rows across a pool of 3 workers
+static void mipChainBuild(benchmark::State &state)
+{
+	static WorkerPool pool(3);
+	std::vector<unsigned char> const &image = benchImage();
+	MipFilter filter = state.range(0) ? MipFilter::LANCZOS : MipFilter::BOX;
+	MipChain chain;
+	for(auto _ : state)
+	{
+		chain.build(image.data(), 1024, 1024, 4, true, filter, state.range(1) ? &pool : nullptr);
+		benchmark::DoNotOptimize(chain.texels(1));
+	}
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(image.size()));
+}
+BENCHMARK(mipChainBuild)->Args({0, 0})->Args({0, 1})->Args({1, 0})->Args({1, 1})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+/// Uploading the chain for an icon drawn at range(0) pixels, only the levels it samples go up
+static void mipUpload(benchmark::State &state)
+{
+	MipChain chain;
+	chain.build(benchImage().data(), 1024, 1024, 4, true);
+	uint32_t size = static_cast<uint32_t>(state.range(0));
+	RecordingDevice::resetStats();
+	for(auto _ : state)
+	{
+		Pixmap pixmap(chain, chain.levelFor(size, size));
+		benchmark::DoNotOptimize(pixmap.baseLevel);
+	}
+	state.counters["uploadedBytes"] = benchmark::Counter(static_cast<double>(RecordingDevice::stats().uploadedBytes), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(mipUpload)->Arg(1024)->Arg(64);
@@ -0,0 +1,74 @@
+#include "shortcuts.hh"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+enum BenchKey : uint16_t {};
+
+static KeyMods const modMasks[] {KeyMods::CTRL, KeyMods::CTRL | KeyMods::SHIFT, KeyMods::ALT, KeyMods::CTRL | KeyMods::ALT};
+
+/// count bindings, every tenth a two stroke chord, and the key presses to resolve
+static void makeBindings(size_t count, std::vector<std::vector<KeyStroke<BenchKey>>> &bindings, std::vector<KeyStroke<BenchKey>> &presses)
+{
+	std::mt19937 rng(1);
+	for(size_t i = 0; i < count; i++)
+	{
+		std::vector<KeyStroke<BenchKey>> chord {{static_cast<BenchKey>(4 + i % 100), modMasks[i / 100 % 4]}};
+		if(i % 10 == 9) chord.push_back({static_cast<BenchKey>(4 + rng() % 100), KeyMods::CTRL});
+		bindings.push_back(chord);
+	}
+	for(size_t i = 0; i < 4096; i++) presses.push_back({static_cast<BenchKey>(4 + rng() % 100), rng() % 4 ? KeyMods::NONE : modMasks[rng() % 4]});
+}
+
+/// Resolving key presses through a ShortcutRegistry, modifier presses included
+static void shortcutRegistry(benchmark::State &state)
+{
+	std::vector<std::vector<KeyStroke<BenchKey>>> bindings;
+	std::vector<KeyStroke<BenchKey>> presses;
+	makeBindings(state.range(0), bindings, presses);
+	ShortcutRegistry<BenchKey> registry;
+	BenchKey const ctrl = static_cast<BenchKey>(224), shift = static_cast<BenchKey>(225), alt = static_cast<BenchKey>(226);
+	registry.setModifierKey(ctrl, KeyMods::CTRL);
+	registry.setModifierKey(shift, KeyMods::SHIFT);
+	registry.setModifierKey(alt, KeyMods::ALT);
+	size_t fired = 0;
+	for(auto const &chord : bindings) registry.bind(chord, [&fired]{fired++;});
+	for(auto _ : state)
+	{
+		for(KeyStroke<BenchKey> const &press : presses)
+		{
+			uint8_t mods = static_cast<uint8_t>(press.mods);
+			if(mods & 1) registry.keyDown(ctrl);
+			if(mods & 2) registry.keyDown(shift);
+			if(mods & 4) registry.keyDown(alt);
+			benchmark::DoNotOptimize(registry.keyDown(press.key));
+			registry.keyUp(press.key);
+			if(mods & 1) registry.keyUp(ctrl);
+			if(mods & 2) registry.keyUp(shift);
+			if(mods & 4) registry.keyUp(alt);
+		}
+	}
+	benchmark::DoNotOptimize(fired);
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(presses.size()));
+}
+BENCHMARK(shortcutRegistry)->Arg(10)->Arg(500);
+
+/// Every binding checking every key press, the way menu items each listening to keyPressed matched them
+static void shortcutLinear(benchmark::State &state)
+{
+	std::vector<std::vector<KeyStroke<BenchKey>>> bindings;
+	std::vector<KeyStroke<BenchKey>> presses;
+	makeBindings(state.range(0), bindings, presses);
+	size_t fired = 0;
+	for(auto _ : state)
+	{
+		for(KeyStroke<BenchKey> const &press : presses)
+		{
+			for(auto const &chord : bindings) if(chord.size() == 1 && chord[0].key == press.key && chord[0].mods == press.mods) fired++;
+		}
+	}
+	benchmark::DoNotOptimize(fired);
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(presses.size()));
+}
+BENCHMARK(shortcutLinear)->Arg(10)->Arg(500);
@@ -0,0 +1,44 @@
+#include "signal.hh"
+
+#include <benchmark/benchmark.h>
+
+static void signalConnect(benchmark::State &state)
+{
+	for(auto _ : state)
+	{
+		Signal<int> signal;
+		Observer observer;
+		for(int64_t i = 0; i < state.range(0); i++) signal.connect(observer, [](int){});
+		benchmark::DoNotOptimize(observer.connections.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(signalConnect)->Arg(16)->Arg(1024);
+
+static void signalFire(benchmark::State &state)
+{
+	Signal<int> signal;
+	Observer observer;
+	int64_t sum = 0;
+	for(int64_t i = 0; i < state.range(0); i++) signal.connect(observer, [&sum](int v){sum += v;});
+	for(auto _ : state) signal.fire(1);
+	benchmark::DoNotOptimize(sum);
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(signalFire)->Arg(1)->Arg(16)->Arg(1024);
+
+/// Dropping an observer disconnects every one of its connections, newest first
+static void signalDisconnect(benchmark::State &state)
+{
+	Signal<int> signal;
+	for(auto _ : state)
+	{
+		state.PauseTiming();
+		UP<Observer> observer = MU<Observer>();
+		for(int64_t i = 0; i < state.range(0); i++) signal.connect(*observer, [](int){});
+		state.ResumeTiming();
+		observer.reset();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(signalDisconnect)->Arg(16)->Arg(1024);
@@ -0,0 +1,58 @@
+#include "softwareRaster.hh"
+
+#include <benchmark/benchmark.h>
+
+/// A frame of range(0) translucent widgets on a 4K target in the software rasterizer
+static void softwareFrame4K(benchmark::State &state)
+{
+	SoftwareRasterizer &raster = SoftwareRasterizer::instance();
+	SoftwareTexture target, white;
+	target.resize(3840, 2160);
+	white.resize(1, 1);
+	white.texels[0] = packRGBA(255, 255, 255, 255);
+	IR::mat4x4<float> projection = IR::mat4x4<float>::orthoProjectionMatrix(0, 3840, 2160, 0, 1, 100);
+	raster.setViewport(3840, 2160);
+	raster.bindTarget(&target);
+	raster.bindTexture(&white);
+	raster.blending = true;
+	for(auto _ : state)
+	{
+		raster.clear(packRGBA(0, 0, 0, 255));
+		for(int64_t i = 0; i < state.range(0); i++)
+		{
+			float x = static_cast<float>(i % 100) * 38, y = static_cast<float>(i / 100 % 53) * 40 + 48;
+			raster.drawRect(projection, {x, y, 120, 48}, {0, 0, 1, 1}, packRGBA(40, 120, 200, 160), 1);
+		}
+		raster.flush();
+	}
+	raster.bindTarget(nullptr);
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(softwareFrame4K)->Arg(5000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+/// The same frame with every widget a rounded rect with a border over a blurred shadow, evaluated per pixel near their edges
+static void softwareShapes4K(benchmark::State &state)
+{
+	SoftwareRasterizer &raster = SoftwareRasterizer::instance();
+	SoftwareTexture target;
+	target.resize(3840, 2160);
+	IR::mat4x4<float> projection = IR::mat4x4<float>::orthoProjectionMatrix(0, 3840, 2160, 0, 1, 100);
+	raster.setViewport(3840, 2160);
+	raster.bindTarget(&target);
+	raster.blending = true;
+	for(auto _ : state)
+	{
+		raster.clear(packRGBA(0, 0, 0, 255));
+		for(int64_t i = 0; i < state.range(0); i++)
+		{
+			float x = static_cast<float>(i % 100) * 38, y = static_cast<float>(i / 100 % 53) * 40 + 48;
+			QuadInstance shadow = QuadInstance::shadow({x + 2, y - 2, 120, 48}, {6, 6, 6, 6}, {0, 0, 0, 0.4f}, 6);
+			raster.drawShape(projection, shadow.rect, shadow.uvRect, packRGBA(0, 0, 0, 100), 0, shadow.shape, 1);
+			raster.drawShape(projection, {x, y, 120, 48}, {6, 6, 6, 6}, packRGBA(40, 120, 200, 160), packRGBA(255, 255, 255, 255), {1, 0, 0, 1}, 1);
+		}
+		raster.flush();
+	}
+	raster.bindTarget(nullptr);
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(softwareShapes4K)->Arg(5000)->Unit(benchmark::kMillisecond)->UseRealTime();
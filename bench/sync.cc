@@ -0,0 +1,41 @@
+#include "util.hh"
+
+#include <benchmark/benchmark.h>
+
+static RWSpinlock rwLock;
+static int64_t shared = 0;
+
+/// Every thread reads, one in writeEvery takes the write lock instead
+static void rwSpinlockContention(benchmark::State &state)
+{
+	int64_t writeEvery = state.range(0), i = 0;
+	for(auto _ : state)
+	{
+		if(++i % writeEvery == 0)
+		{
+			rwLock.writeLock();
+			shared++;
+			rwLock.writeUnlock();
+		}
+		else
+		{
+			rwLock.readAccess();
+			benchmark::DoNotOptimize(shared);
+			rwLock.readDone();
+		}
+	}
+}
+BENCHMARK(rwSpinlockContention)->Arg(1)->Arg(16)->Arg(1 << 20)->ThreadRange(1, 8)->UseRealTime();
+
+static Spinlock spinlock;
+
+static void spinlockContention(benchmark::State &state)
+{
+	for(auto _ : state)
+	{
+		spinlock.lock();
+		shared++;
+		spinlock.unlock();
+	}
+}
+BENCHMARK(spinlockContention)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,88 @@
+#include "typeAhead.hh"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <vector>
+
+/// 50,000 item picker names like "Great_axe of Healing 417"
+static std::vector<std::string> makeEntries()
+{
+	std::vector<std::string> const words {"Iron", "sword", "Shield", "potion", "of", "Healing", "mana", "Great", "axe", "bow", "arrow", "ring", "Amulet", "boots", "helm", "Cursed", "Ancient"};
+	std::mt19937 rng(1);
+	std::vector<std::string> out(50000);
+	for(std::string &entry : out)
+	{
+		for(uint32_t word = 0, count = 2 + rng() % 3; word < count; word++) entry += (word ? (rng() % 2 ? " " : "_") : "") + words[rng() % words.size()];
+		entry += " " + std::to_string(rng() % 1000);
+	}
+	return out;
+}
+
+static std::string const typed = "ancient sword 4";
+
+static void typeAheadBuild(benchmark::State &state)
+{
+	std::vector<std::string> entries = makeEntries();
+	TypeAheadIndex index;
+	for(auto _ : state) index.build(entries);
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(entries.size()));
+}
+BENCHMARK(typeAheadBuild)->Unit(benchmark::kMillisecond);
+
+/// Typing a query a character at a time, one filter per keystroke
+static void typeAheadFilter(benchmark::State &state)
+{
+	std::vector<std::string> entries = makeEntries();
+	TypeAheadIndex index;
+	index.build(entries);
+	std::vector<uint32_t> matches;
+	for(auto _ : state)
+	{
+		for(size_t length = 0; length <= typed.size(); length++) index.filter(typed.substr(0, length), matches);
+		benchmark::DoNotOptimize(matches.data());
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(typed.size() + 1));
+}
+BENCHMARK(typeAheadFilter);
+
+/// The same keystrokes rescanning every entry each time, what filtering cost without the index
+static void typeAheadRescan(benchmark::State &state)
+{
+	std::vector<std::string> entries = makeEntries();
+	std::vector<uint32_t> matches;
+	std::string query, folded;
+	for(auto _ : state)
+	{
+		for(size_t length = 0; length <= typed.size(); length++)
+		{
+			query = typed.substr(0, length);
+			matches.clear();
+			for(size_t i = 0; i < entries.size(); i++)
+			{
+				folded = entries[i];
+				for(char &c : folded) c = c >= 'A' && c <= 'Z' ? static_cast<char>(c + ('a' - 'A')) : c;
+				if(folded.find(query) != std::string::npos) matches.push_back(static_cast<uint32_t>(i));
+			}
+		}
+		benchmark::DoNotOptimize(matches.data());
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(typed.size() + 1));
+}
+BENCHMARK(typeAheadRescan);
+
+/// Fuzzy ranking every entry against the whole query, the part DropdownMenu leaves to a worker
+static void typeAheadRank(benchmark::State &state)
+{
+	std::vector<std::string> entries = makeEntries();
+	TypeAheadIndex index;
+	index.build(entries);
+	std::vector<uint32_t> ranked;
+	for(auto _ : state)
+	{
+		index.rank("ancswd", ranked);
+		benchmark::DoNotOptimize(ranked.data());
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(entries.size()));
+}
+BENCHMARK(typeAheadRank)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <array>
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <iris/shapes.hh>
+#include <iris/simd.hh>
+
+/// Rects to test against the viewport before drawing, kept as columns of extents so they're culled 4 at a time.
+/// pushClip() and popClip() bracket the rects a scrolling container clips, clips nest and each is cut down by the ones around it.
+/// Build it on the thread that renders, then cull() it against the viewport
+struct CullList
+{
+	inline CullList()
+	{
+		this->clear();
+	}
+	
+	inline void clear()
+	{
+		this->minX.clear();
+		this->minY.clear();
+		this->maxX.clear();
+		this->maxY.clear();
+		this->clips.clear();
+		this->runs.clear();
+		float constexpr big = std::numeric_limits<float>::max();
+		this->clips.push_back({-big, -big, big, big});
+		this->runs.push_back({0, 0, this->clips.back()});
+	}
+	
+	/// Rects pushed until the matching popClip() are only visible inside rect, and inside every clip around it
+	inline void pushClip(IR::aabb2D<int32_t> const &rect)
+	{
+		Extents const &outer = this->clips.back();
+		this->clips.push_back({std::max(outer[0], static_cast<float>(rect.minX)), std::max(outer[1], static_cast<float>(rect.minY)),
+		                       std::min(outer[2], static_cast<float>(rect.maxX)), std::min(outer[3], static_cast<float>(rect.maxY))});
+		this->beginRun();
+	}
+	
+	inline void popClip()
+	{
+		if(this->clips.size() == 1) return;
+		this->clips.pop_back();
+		this->beginRun();
+	}
+	
+	/// Add a rect inside the current clips, returns its index in what cull() produces
+	inline uint32_t push(IR::aabb2D<int32_t> const &rect)
+	{
+		uint32_t out = static_cast<uint32_t>(this->minX.size());
+		this->minX.push_back(static_cast<float>(rect.minX));
+		this->minY.push_back(static_cast<float>(rect.minY));
+		this->maxX.push_back(static_cast<float>(rect.maxX));
+		this->maxY.push_back(static_cast<float>(rect.maxY));
+		this->runs.back().end++;
+		return out;
+	}
+	
+	inline size_t size() const
+	{
+		return this->minX.size();
+	}
+	
+	/// Set bit i of visible, bit i % 64 of word i / 64, when rect i overlaps the viewport and all of its clips
+	template <typename B = IR::simd::Native> inline void cull(IR::aabb2D<int32_t> const &viewport, std::vector<uint64_t> &visible) const
+	{
+		visible.assign((this->size() + 63) / 64 + 1, 0); //One spare word so a group of 4 straddling two words can always write both
+		uint64_t *out = visible.data();
+		this->forEachRun<B>(viewport, [&](size_t first, uint32_t bits)
+		{
+			size_t word = first / 64, shift = first % 64;
+			out[word] |= static_cast<uint64_t>(bits) << shift;
+			if(shift > 60) out[word + 1] |= static_cast<uint64_t>(bits) >> (64 - shift);
+		});
+		visible.resize((this->size() + 63) / 64);
+	}
+	
+	/// The indices of the rects that overlap the viewport and all of their clips, in the order they were pushed
+	template <typename B = IR::simd::Native> inline void cull(IR::aabb2D<int32_t> const &viewport, std::vector<uint32_t> &visible) const
+	{
+		visible.resize(this->size() + 4); //Each group writes all 4 lanes and only advances past the visible ones
+		uint32_t *out = visible.data();
+		size_t count = 0;
+		this->forEachRun<B>(viewport, [&](size_t first, uint32_t bits)
+		{
+			for(uint32_t lane = 0; lane < 4; lane++)
+			{
+				out[count] = static_cast<uint32_t>(first + lane);
+				count += (bits >> lane) & 1;
+			}
+		});
+		visible.resize(count);
+	}
+
+private:
+	using Extents = std::array<float, 4>; //minX minY maxX maxY
+	
+	/// Consecutive rects under the same clips
+	struct Run
+	{
+		uint32_t first, end;
+		Extents clip;
+	};
+	
+	inline void beginRun()
+	{
+		Run &last = this->runs.back();
+		if(last.first == last.end) last.clip = this->clips.back();
+		else this->runs.push_back({last.end, last.end, this->clips.back()});
+	}
+	
+	/// Calls emit(index, bits) for every group of 4 rects in each run that isn't clipped away entirely
+	template <typename B, typename F> inline void forEachRun(IR::aabb2D<int32_t> const &viewport, F const &emit) const
+	{
+		for(Run const &run : this->runs)
+		{
+			float clip[4] {std::max(run.clip[0], static_cast<float>(viewport.minX)), std::max(run.clip[1], static_cast<float>(viewport.minY)),
+			               std::min(run.clip[2], static_cast<float>(viewport.maxX)), std::min(run.clip[3], static_cast<float>(viewport.maxY))};
+			if(run.first == run.end || clip[0] >= clip[2] || clip[1] >= clip[3]) continue;
+			IR::simd::rectOverlap<B>(&this->minX[run.first], &this->minY[run.first], &this->maxX[run.first], &this->maxY[run.first], run.end - run.first, clip,
+			                         [&](size_t first, uint32_t bits){emit(run.first + first, bits);});
+		}
+	}
+	
+	std::vector<float> minX, minY, maxX, maxY;
+	std::vector<Extents> clips; //The stack of nested clips, the first one is unbounded
+	std::vector<Run> runs;
+};
@@ -0,0 +1,182 @@
+#pragma once
+
+#include "version.hh"
+
+#if defined(_USEGL45)
+#include "deviceGL45.hh"
+using Device = GL45Device;
+#elif defined(_USEGL33)
+#include "deviceGL33.hh"
+using Device = GL33Device;
+#elif defined(_USESOFTWARE)
+#include "deviceSoftware.hh"
+using Device = SoftwareDevice;
+#elif defined(_USERECORDING)
+#include "deviceRecording.hh"
+using Device = RecordingDevice;
+#endif
+
+#if !defined(_INVALIDGLVERSION)
+using StreamBuffer = Device::StreamBuffer;
+
+/// Calls the encoder issued to the device and calls it skipped because the state was already set
+struct EncoderStats
+{
+	uint64_t issued = 0, elided = 0;
+};
+
+/// Every bind and draw goes through the encoder of the thread that owns the context, so state handling lives in one place for every device.
+/// The encoder shadows the bound target, pipeline, vertex input, texture units, blend and scissor state and skips calls that wouldn't change them
+struct CommandEncoder final
+{
+	static constexpr uint32_t textureUnits = 16;
+	
+	inline static CommandEncoder &current()
+	{
+		thread_local CommandEncoder out;
+		return out;
+	}
+	
+	inline void setTarget(Device::Target target)
+	{
+		if(this->shadowed(this->known.target, this->target == target)) return;
+		this->target = target;
+		Device::bindTarget(target);
+	}
+	
+	inline void setPipeline(Device::Pipeline pipeline)
+	{
+		if(this->shadowed(this->known.pipeline, this->pipeline == pipeline)) return;
+		this->pipeline = pipeline;
+		Device::bindPipeline(pipeline);
+	}
+	
+	inline void setVertexInput(Device::VertexInput input)
+	{
+		if(this->shadowed(this->known.input, this->input == input)) return;
+		this->input = input;
+		Device::bindVertexInput(input);
+	}
+	
+	inline void setTexture(uint32_t unit, Device::Texture texture)
+	{
+		if(unit < textureUnits)
+		{
+			uint32_t bit = 1u << unit;
+			if((this->known.textures & bit) && this->textures[unit] == texture)
+			{
+				this->frame.elided++;
+				return;
+			}
+			this->known.textures |= bit;
+			this->textures[unit] = texture;
+		}
+		this->frame.issued++;
+		Device::bindTexture(unit, texture);
+	}
+	
+	inline void setBlend(bool enabled)
+	{
+		if(this->shadowed(this->known.blend, this->blend == enabled)) return;
+		this->blend = enabled;
+		Device::setBlend(enabled);
+	}
+	
+	/// The rect is ignored while the scissor test is disabled
+	inline void setScissor(bool enabled, ScissorRect const &rect = {})
+	{
+		if(this->shadowed(this->known.scissor, this->scissorEnabled == enabled && (!enabled || this->scissor == rect))) return;
+		this->scissorEnabled = enabled;
+		this->scissor = rect;
+		Device::setScissor(enabled, rect);
+	}
+	
+	/// Draw the GUI quad with the bound pipeline, vertex input and texture
+	inline void draw()
+	{
+		Device::draw(4);
+	}
+	
+	/// Draw count instances from where the stream buffer was last mapped
+	inline void drawInstanced(Device::VertexInput input, StreamBuffer &instances, size_t count)
+	{
+		Device::drawInstanced(input, instances, count);
+	}
+	
+	/// Stop trusting the shadowed state, call after anything outside the encoder changes bindings or when sharing the context with other renderers
+	inline void invalidate()
+	{
+		this->known = {};
+	}
+	
+	/// Objects being destroyed must be forgotten, the device may hand the same handle to the next object created
+	inline void forgetTexture(Device::Texture texture)
+	{
+		for(uint32_t unit = 0; unit < textureUnits; unit++) if(this->textures[unit] == texture) this->known.textures &= ~(1u << unit);
+	}
+	
+	inline void forgetPipeline(Device::Pipeline pipeline)
+	{
+		if(this->pipeline == pipeline) this->known.pipeline = false;
+	}
+	
+	inline void forgetVertexInput(Device::VertexInput input)
+	{
+		if(this->input == input) this->known.input = false;
+	}
+	
+	inline void forgetTarget(Device::Target target)
+	{
+		if(this->target == target) this->known.target = false;
+	}
+	
+	/// Devices that edit objects through their bind points leave other textures and vertex inputs bound, call after creating or editing one
+	inline void edited()
+	{
+		if constexpr(!Device::bindsToEdit) return;
+		this->known.textures = 0;
+		this->known.input = false;
+	}
+	
+	/// Call once per frame, stats() then reports the frame that just ended
+	inline void endFrame()
+	{
+		this->last = this->frame;
+		this->frame = {};
+	}
+	
+	inline EncoderStats const &stats() const
+	{
+		return this->last;
+	}
+
+private:
+	struct Known
+	{
+		bool target = false, pipeline = false, input = false, blend = false, scissor = false;
+		uint32_t textures = 0;
+	};
+	
+	/// Count the call and report whether it can be skipped
+	inline bool shadowed(bool &known, bool same)
+	{
+		if(known && same)
+		{
+			this->frame.elided++;
+			return true;
+		}
+		known = true;
+		this->frame.issued++;
+		return false;
+	}
+	
+	Known known;
+	Device::Target target {};
+	Device::Pipeline pipeline {};
+	Device::VertexInput input {};
+	Device::Texture textures[textureUnits] {};
+	bool blend = false, scissorEnabled = false;
+	ScissorRect scissor;
+	EncoderStats frame, last;
+};
+#endif
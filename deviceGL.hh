@@ -0,0 +1,263 @@
+#pragma once
+
+#include "renderTypes.hh"
+
+#include <vector>
+#include <string>
+#include <cstdio>
+
+/// What the GL 3.3 and 4.5 devices share, both derive from it and only implement what differs
+struct GLDevice
+{
+	using Texture = uint32_t;
+	using Buffer = uint32_t;
+	using Pipeline = uint32_t;
+	using VertexInput = uint32_t;
+	using Target = uint32_t;
+	using Query = uint32_t;
+	
+	/// Creating or editing an object doesn't disturb what's bound, GL 3.3 overrides this
+	static constexpr bool bindsToEdit = false;
+	/// GPU timestamps are available for profiling
+	static constexpr bool timestamps = true;
+	
+	/// The size new targets are created with
+	inline static void defaultTargetSize(uint32_t &width, uint32_t &height)
+	{
+		int dfSz[4];
+		glGetIntegerv(GL_VIEWPORT, dfSz);
+		width = static_cast<uint32_t>(dfSz[2]);
+		height = static_cast<uint32_t>(dfSz[3]);
+	}
+	
+	inline static void destroyTexture(Texture texture)
+	{
+		glDeleteTextures(1, &texture);
+	}
+	
+	inline static void destroyBuffer(Buffer buffer)
+	{
+		glDeleteBuffers(1, &buffer);
+	}
+	
+	inline static void destroyVertexInput(VertexInput input)
+	{
+		glDeleteVertexArrays(1, &input);
+	}
+	
+	inline static void destroyTarget(Target target)
+	{
+		glDeleteFramebuffers(1, &target);
+	}
+	
+	inline static Pipeline createPipeline(char const *vertSource, char const *fragSource)
+	{
+		uint32_t vertHandle = glCreateShader(GL_VERTEX_SHADER), fragHandle = glCreateShader(GL_FRAGMENT_SHADER);
+		Pipeline out = glCreateProgram();
+		glShaderSource(vertHandle, 1, &vertSource, nullptr);
+		glShaderSource(fragHandle, 1, &fragSource, nullptr);
+		if(!compile(vertHandle) || !compile(fragHandle)) return out;
+		glAttachShader(out, vertHandle);
+		glAttachShader(out, fragHandle);
+		glLinkProgram(out);
+		int32_t success = 0;
+		glGetProgramiv(out, GL_LINK_STATUS, &success);
+		if(!success)
+		{
+			int32_t maxLen = 0;
+			glGetProgramiv(out, GL_INFO_LOG_LENGTH, &maxLen);
+			std::vector<char> error;
+			error.resize(maxLen * sizeof(GLchar));
+			glGetProgramInfoLog(out, maxLen, &maxLen, error.data());
+			std::string errorStr{error.begin(), error.end()};
+			printf("Shader program %u failed to link: %s\n", out, errorStr.data());
+			return out;
+		}
+		glDetachShader(out, vertHandle);
+		glDetachShader(out, fragHandle);
+		glDeleteShader(vertHandle);
+		glDeleteShader(fragHandle);
+		return out;
+	}
+	
+	inline static void destroyPipeline(Pipeline pipeline)
+	{
+		glDeleteProgram(pipeline);
+	}
+	
+	/// Uniforms are written to the bound pipeline, bind it first
+	inline static void setUniform(Pipeline pipeline, char const *location, float val)
+	{
+		glUniform1f(glGetUniformLocation(pipeline, location), val);
+	}
+	
+	inline static void setUniform(Pipeline pipeline, char const *location, int32_t val)
+	{
+		glUniform1i(glGetUniformLocation(pipeline, location), val);
+	}
+	
+	inline static void setUniform(Pipeline pipeline, char const *location, uint32_t val)
+	{
+		glUniform1ui(glGetUniformLocation(pipeline, location), val);
+	}
+	
+	inline static void setUniform(Pipeline pipeline, char const *location, IR::vec2<float> const &val)
+	{
+		glUniform2fv(glGetUniformLocation(pipeline, location), 1, val.data);
+	}
+	
+	inline static void setUniform(Pipeline pipeline, char const *location, IR::vec3<float> const &val)
+	{
+		glUniform3fv(glGetUniformLocation(pipeline, location), 1, val.data);
+	}
+	
+	inline static void setUniform(Pipeline pipeline, char const *location, IR::vec4<float> const &val)
+	{
+		glUniform4fv(glGetUniformLocation(pipeline, location), 1, val.data);
+	}
+	
+	inline static void setUniform(Pipeline pipeline, char const *location, IR::mat3x3<float> const &val)
+	{
+		glUniformMatrix3fv(glGetUniformLocation(pipeline, location), 1, GL_FALSE, &val[0][0]);
+	}
+	
+	inline static void setUniform(Pipeline pipeline, char const *location, IR::mat4x4<float> const &val)
+	{
+		glUniformMatrix4fv(glGetUniformLocation(pipeline, location), 1, GL_FALSE, &val[0][0]);
+	}
+	
+	inline static void bindTarget(Target target)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, target);
+	}
+	
+	inline static void bindPipeline(Pipeline pipeline)
+	{
+		glUseProgram(pipeline);
+	}
+	
+	inline static void bindVertexInput(VertexInput input)
+	{
+		glBindVertexArray(input);
+	}
+	
+	inline static Query createQuery()
+	{
+		Query out = 0;
+		glGenQueries(1, &out);
+		return out;
+	}
+	
+	inline static void destroyQuery(Query query)
+	{
+		glDeleteQueries(1, &query);
+	}
+	
+	/// Record the GPU time once every command before this one has finished
+	inline static void writeTimestamp(Query query)
+	{
+		glQueryCounter(query, GL_TIMESTAMP);
+	}
+	
+	inline static bool queryReady(Query query)
+	{
+		int32_t available = 0;
+		glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+		return available;
+	}
+	
+	/// Nanoseconds
+	inline static uint64_t queryResult(Query query)
+	{
+		GLuint64 out = 0;
+		glGetQueryObjectui64v(query, GL_QUERY_RESULT, &out);
+		return out;
+	}
+	
+	/// The GPU clock in nanoseconds once the commands issued so far have reached the GPU
+	inline static uint64_t gpuTime()
+	{
+		GLint64 out = 0;
+		glGetInteger64v(GL_TIMESTAMP, &out);
+		return static_cast<uint64_t>(out);
+	}
+	
+	/// Blending is always glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA)
+	inline static void setBlend(bool enabled)
+	{
+		if(!enabled)
+		{
+			glDisable(GL_BLEND);
+			return;
+		}
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	}
+	
+	inline static void setScissor(bool enabled, ScissorRect const &rect)
+	{
+		if(!enabled)
+		{
+			glDisable(GL_SCISSOR_TEST);
+			return;
+		}
+		glEnable(GL_SCISSOR_TEST);
+		glScissor(rect.x, rect.y, rect.width, rect.height);
+	}
+	
+	/// Draw the GUI quad as a strip
+	inline static void draw(uint32_t vertexCount)
+	{
+		glDrawArrays(GL_TRIANGLE_STRIP, 0, static_cast<int32_t>(vertexCount));
+	}
+
+protected:
+	inline static GLenum internalFormat(TextureFormat format, bool srgb)
+	{
+		switch(format)
+		{
+			case TextureFormat::RGB8: return srgb ? GL_SRGB8 : GL_RGB8;
+			case TextureFormat::RGBA8: return srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+			default: return GL_RGBA32F;
+		}
+	}
+	
+	inline static GLenum pixelFormat(TextureFormat format)
+	{
+		return format == TextureFormat::RGB8 ? GL_RGB : GL_RGBA;
+	}
+	
+	inline static GLenum pixelType(TextureFormat format)
+	{
+		return format == TextureFormat::RGBA32F ? GL_FLOAT : GL_UNSIGNED_BYTE;
+	}
+	
+	inline static void reportTargetStatus(GLenum error)
+	{
+		if(error == GL_FRAMEBUFFER_COMPLETE) return;
+		switch(error)
+		{
+			case GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT: printf("attachment\n"); break;
+			case GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT: printf("missing attachment\n"); break;
+			case GL_FRAMEBUFFER_UNSUPPORTED: printf("fbo not supported\n"); break;
+			default: break;
+		}
+	}
+
+private:
+	inline static bool compile(uint32_t handle)
+	{
+		glCompileShader(handle);
+		int32_t success = 0;
+		glGetShaderiv(handle, GL_COMPILE_STATUS, &success);
+		if(success) return true;
+		int32_t maxLen = 0;
+		glGetShaderiv(handle, GL_INFO_LOG_LENGTH, &maxLen);
+		std::vector<char> error;
+		error.resize(maxLen * sizeof(GLchar));
+		glGetShaderInfoLog(handle, maxLen, &maxLen, error.data());
+		std::string errorStr{error.begin(), error.end()};
+		printf("Shader failed to compile: %s\n", errorStr.data());
+		return false;
+	}
+};
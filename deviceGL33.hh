@@ -0,0 +1,301 @@
+#pragma once
+
+#include "deviceGL.hh"
+
+#include <algorithm>
+
+static constexpr char const *guiVertShader = R"(
+#version 330 core
+
+layout(location = 0) in vec3 pos;
+layout(location = 1) in vec2 uv_in;
+out vec2 uv;
+uniform mat4 mvp;
+
+void main()
+{
+	uv = uv_in;
+	gl_Position = mvp * vec4(pos, 1.0f);
+})";
+
+static constexpr char const *guiFragShader = R"(
+#version 330 core
+
+in vec2 uv;
+uniform sampler2D tex;
+uniform vec4 color = vec4(1.0);
+out vec4 fragColor;
+
+void main()
+{
+	fragColor = texture(tex, uv) * color;
+})";
+
+static constexpr char const *guiInstancedVertShader = R"(
+#version 330 core
+
+layout(location = 0) in vec3 pos;
+layout(location = 1) in vec2 uv_in;
+layout(location = 2) in vec4 rect;
+layout(location = 3) in vec4 uvRect;
+layout(location = 4) in vec4 color_in;
+layout(location = 5) in float layer;
+layout(location = 6) in vec4 borderColor_in;
+layout(location = 7) in vec4 shape_in;
+out vec2 uv;
+out vec2 local;
+out vec4 color;
+flat out vec4 radii;
+flat out vec4 borderColor;
+flat out vec4 shape;
+flat out float shaped;
+uniform mat4 projection;
+
+void main()
+{
+	uv = mix(uvRect.xy, uvRect.zw, uv_in);
+	local = (uv_in - 0.5f) * rect.zw;
+	color = color_in;
+	radii = uvRect;
+	borderColor = borderColor_in;
+	shape = vec4(max(rect.zw * 0.5f - shape_in.z, 0.0f), shape_in.xy);
+	shaped = shape_in.w;
+	gl_Position = projection * vec4(rect.xy + pos.xy * rect.zw, layer, 1.0f);
+})";
+
+static constexpr char const *guiInstancedFragShader = R"(
+#version 330 core
+
+in vec2 uv;
+in vec2 local;
+in vec4 color;
+flat in vec4 radii;
+flat in vec4 borderColor;
+flat in vec4 shape; //Half size, border width and blur of a shape quad
+flat in float shaped;
+uniform sampler2D tex;
+out vec4 fragColor;
+
+//Signed distance to the edge of the rounded box, y is down and radii go clockwise from the top left
+float roundedBox(vec2 p, vec2 halfSize)
+{
+	vec2 side = step(0.0f, p);
+	float radius = mix(mix(radii.x, radii.y, side.x), mix(radii.w, radii.z, side.x), side.y);
+	radius = clamp(radius, 0.0f, min(halfSize.x, halfSize.y));
+	vec2 q = abs(p) - halfSize + radius;
+	return min(max(q.x, q.y), 0.0f) + length(max(q, 0.0f)) - radius;
+}
+
+void main()
+{
+	if(shaped == 0.0f)
+	{
+		fragColor = texture(tex, uv) * color;
+		return;
+	}
+	float edge = roundedBox(local, shape.xy), soft = max(shape.w, 0.5f);
+	vec4 fill = shape.z > 0.0f ? mix(color, borderColor, clamp(edge + shape.z + 0.5f, 0.0f, 1.0f)) : color;
+	fragColor = vec4(fill.rgb, fill.a * (1.0f - smoothstep(-soft, soft, edge)));
+})";
+
+/// Without buffer storage the GL 3.3 path orphans the buffer at the start of each frame, so the driver hands back fresh memory
+/// instead of stalling on draws still reading the previous contents
+struct GL33StreamBuffer
+{
+	static constexpr size_t alignment = 64;
+	
+	inline explicit GL33StreamBuffer(size_t regionSize = 64 * 1024) : capacity(regionSize)
+	{
+		glGenBuffers(1, &this->handle);
+		glBindBuffer(GL_ARRAY_BUFFER, this->handle);
+		glBufferData(GL_ARRAY_BUFFER, this->capacity, nullptr, GL_STREAM_DRAW);
+	}
+	
+	inline ~GL33StreamBuffer()
+	{
+		glDeleteBuffers(1, &this->handle);
+	}
+	
+	/// Reserve space for bytes and get a pointer to write them through, call unmap() before drawing from offset()
+	inline unsigned char *map(size_t bytes)
+	{
+		bytes = (bytes + alignment - 1) & ~(alignment - 1);
+		glBindBuffer(GL_ARRAY_BUFFER, this->handle);
+		if(!this->cursor || this->cursor + bytes > this->capacity)
+		{
+			if(bytes > this->capacity)
+			{
+				this->capacity = std::max(bytes, this->capacity * 2);
+				this->stats.reallocations++;
+			}
+			glBufferData(GL_ARRAY_BUFFER, this->capacity, nullptr, GL_STREAM_DRAW);
+			this->cursor = 0;
+			this->stats.orphans++;
+		}
+		this->lastOffset = this->cursor;
+		this->cursor += bytes;
+		return static_cast<unsigned char *>(glMapBufferRange(GL_ARRAY_BUFFER, this->lastOffset, bytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
+	}
+	
+	inline void unmap()
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, this->handle);
+		glUnmapBuffer(GL_ARRAY_BUFFER);
+	}
+	
+	inline size_t offset() const
+	{
+		return this->lastOffset;
+	}
+	
+	/// Call once per frame after issuing the draws that read this frame's data
+	inline void endFrame()
+	{
+		this->cursor = 0;
+	}
+	
+	uint32_t handle = 0;
+	StreamBufferStats stats;
+
+private:
+	size_t capacity, cursor = 0, lastOffset = 0;
+};
+
+
+/// Objects are edited through the bind points, so creating or editing one changes what's bound to GL_TEXTURE_2D or GL_ARRAY_BUFFER
+struct GL33Device : GLDevice
+{
+	using StreamBuffer = GL33StreamBuffer;
+	
+	static constexpr bool bindsToEdit = true;
+	
+	/// A texture with levels mip levels, sampled trilinearly when there's more than one
+	inline static Texture createTexture(uint32_t width, uint32_t height, TextureFormat format, bool srgb, uint32_t levels = 1)
+	{
+		Texture out = 0;
+		glGenTextures(1, &out);
+		glBindTexture(GL_TEXTURE_2D, out);
+		for(uint32_t level = 0; level < levels; level++)
+		{
+			glTexImage2D(GL_TEXTURE_2D, level, internalFormat(format, srgb), std::max(width >> level, 1u), std::max(height >> level, 1u), 0, pixelFormat(format), pixelType(format), nullptr);
+		}
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levels - 1));
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		return out;
+	}
+	
+	/// Replace a region of a level with tightly packed rows in the texture's format
+	inline static void updateTexture(Texture texture, uint32_t x, uint32_t y, uint32_t width, uint32_t height, TextureFormat format, void const *data, uint32_t level = 0)
+	{
+		glBindTexture(GL_TEXTURE_2D, texture);
+		glTexSubImage2D(GL_TEXTURE_2D, level, x, y, width, height, pixelFormat(format), pixelType(format), data);
+	}
+	
+	/// Only sample levels base to max, the levels before base needn't have been uploaded
+	inline static void setTextureLevels(Texture texture, uint32_t base, uint32_t max)
+	{
+		glBindTexture(GL_TEXTURE_2D, texture);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(base));
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(max));
+	}
+	
+	inline static void setTextureFilter(Texture texture, int32_t min, int32_t mag)
+	{
+		glBindTexture(GL_TEXTURE_2D, texture);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, min);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mag);
+	}
+	
+	/// Anisotropic filtering isn't core in 3.3
+	inline static void setTextureAnisotropy(Texture, uint32_t) {}
+	
+	/// Read back RGBA8 texels, rows from the bottom up like every GL read
+	inline static void readTexture(Texture texture, uint32_t, uint32_t, uint32_t *out)
+	{
+		glBindTexture(GL_TEXTURE_2D, texture);
+		glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, out);
+	}
+	
+	inline static Buffer createBuffer(void const *data, size_t size)
+	{
+		Buffer out = 0;
+		glGenBuffers(1, &out);
+		glBindBuffer(GL_ARRAY_BUFFER, out);
+		glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
+		return out;
+	}
+	
+	/// Vertex input for the GUI quad, positions at location 0, UVs at 1 and QuadInstance attributes at 2 to 7.
+	/// The instance attributes start out pointing at the stream buffer so non-instanced draws never source from an enabled array without a buffer,
+	/// drawInstanced() re-points them at the offset it draws from.  Leaves the vertex input bound
+	inline static VertexInput createQuadInput(Buffer vertices, Buffer uvs, StreamBuffer &instances)
+	{
+		VertexInput out = 0;
+		glGenVertexArrays(1, &out);
+		glBindVertexArray(out);
+		
+		glBindBuffer(GL_ARRAY_BUFFER, vertices);
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), nullptr);
+		
+		glBindBuffer(GL_ARRAY_BUFFER, uvs);
+		glEnableVertexAttribArray(1);
+		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), nullptr);
+		
+		glBindBuffer(GL_ARRAY_BUFFER, instances.handle);
+		for(InstanceAttrib const &attrib : quadInstanceAttribs)
+		{
+			glEnableVertexAttribArray(attrib.location);
+			glVertexAttribPointer(attrib.location, attrib.components, GL_FLOAT, GL_FALSE, sizeof(QuadInstance), reinterpret_cast<void const *>(attrib.offset));
+			glVertexAttribDivisor(attrib.location, 1);
+		}
+		return out;
+	}
+	
+	/// A framebuffer with a new RGBA32F color texture, leaves the default framebuffer bound
+	inline static Target createTarget(uint32_t width, uint32_t height, Texture &color)
+	{
+		Target out = 0;
+		glGenFramebuffers(1, &out);
+		glBindFramebuffer(GL_FRAMEBUFFER, out);
+		glViewport(0, 0, width, height);
+		color = createTexture(width, height, TextureFormat::RGBA32F, false);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color, 0);
+		GLenum drawBuffers[1] = {GL_COLOR_ATTACHMENT0};
+		glDrawBuffers(1, drawBuffers);
+		reportTargetStatus(glCheckFramebufferStatus(GL_FRAMEBUFFER));
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		return out;
+	}
+	
+	/// Only switches the active unit when it changes, editing a texture binds it to whichever unit is active
+	inline static void bindTexture(uint32_t unit, Texture texture)
+	{
+		uint32_t &activeUnit = activeTextureUnit();
+		if(unit != activeUnit)
+		{
+			glActiveTexture(GL_TEXTURE0 + unit);
+			activeUnit = unit;
+		}
+		glBindTexture(GL_TEXTURE_2D, texture);
+	}
+	
+	/// Draw count instances from where the stream buffer was last mapped, the vertex input must be bound
+	inline static void drawInstanced(VertexInput, StreamBuffer &instances, size_t count)
+	{
+		instances.unmap();
+		for(InstanceAttrib const &attrib : quadInstanceAttribs)
+		{
+			glVertexAttribPointer(attrib.location, attrib.components, GL_FLOAT, GL_FALSE, sizeof(QuadInstance), reinterpret_cast<void const *>(instances.offset() + attrib.offset));
+		}
+		glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<int32_t>(count));
+	}
+
+private:
+	inline static uint32_t &activeTextureUnit()
+	{
+		thread_local uint32_t out = 0;
+		return out;
+	}
+};
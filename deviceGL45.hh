@@ -0,0 +1,315 @@
+#pragma once
+
+#include "deviceGL.hh"
+
+#include <chrono>
+#include <algorithm>
+
+static constexpr char const *guiVertShader =
+R"(#version 450
+
+layout(location = 0) in vec3 pos;
+layout(location = 1) in vec2 uv_in;
+out vec2 uv;
+uniform mat4 mvp;
+
+void main()
+{
+	uv = uv_in;
+	gl_Position = mvp * vec4(pos, 1.0f);
+})";
+
+static constexpr char const *guiFragShader =
+R"(#version 450
+
+in vec2 uv;
+layout(binding = 0) uniform sampler2D tex;
+uniform vec4 color = vec4(1.0);
+out vec4 fragColor;
+
+void main()
+{
+	fragColor = texture(tex, uv) * color;
+})";
+
+static constexpr char const *guiInstancedVertShader =
+R"(#version 450
+
+layout(location = 0) in vec3 pos;
+layout(location = 1) in vec2 uv_in;
+layout(location = 2) in vec4 rect;
+layout(location = 3) in vec4 uvRect;
+layout(location = 4) in vec4 color_in;
+layout(location = 5) in float layer;
+layout(location = 6) in vec4 borderColor_in;
+layout(location = 7) in vec4 shape_in;
+out vec2 uv;
+out vec2 local;
+out vec4 color;
+flat out vec4 radii;
+flat out vec4 borderColor;
+flat out vec4 shape;
+flat out float shaped;
+uniform mat4 projection;
+
+void main()
+{
+	uv = mix(uvRect.xy, uvRect.zw, uv_in);
+	local = (uv_in - 0.5f) * rect.zw;
+	color = color_in;
+	radii = uvRect;
+	borderColor = borderColor_in;
+	shape = vec4(max(rect.zw * 0.5f - shape_in.z, 0.0f), shape_in.xy);
+	shaped = shape_in.w;
+	gl_Position = projection * vec4(rect.xy + pos.xy * rect.zw, layer, 1.0f);
+})";
+
+static constexpr char const *guiInstancedFragShader =
+R"(#version 450
+
+in vec2 uv;
+in vec2 local;
+in vec4 color;
+flat in vec4 radii;
+flat in vec4 borderColor;
+flat in vec4 shape; //Half size, border width and blur of a shape quad
+flat in float shaped;
+layout(binding = 0) uniform sampler2D tex;
+out vec4 fragColor;
+
+//Signed distance to the edge of the rounded box, y is down and radii go clockwise from the top left
+float roundedBox(vec2 p, vec2 halfSize)
+{
+	vec2 side = step(0.0f, p);
+	float radius = mix(mix(radii.x, radii.y, side.x), mix(radii.w, radii.z, side.x), side.y);
+	radius = clamp(radius, 0.0f, min(halfSize.x, halfSize.y));
+	vec2 q = abs(p) - halfSize + radius;
+	return min(max(q.x, q.y), 0.0f) + length(max(q, 0.0f)) - radius;
+}
+
+void main()
+{
+	if(shaped == 0.0f)
+	{
+		fragColor = texture(tex, uv) * color;
+		return;
+	}
+	float edge = roundedBox(local, shape.xy), soft = max(shape.w, 0.5f);
+	vec4 fill = shape.z > 0.0f ? mix(color, borderColor, clamp(edge + shape.z + 0.5f, 0.0f, 1.0f)) : color;
+	fragColor = vec4(fill.rgb, fill.a * (1.0f - smoothstep(-soft, soft, edge)));
+})";
+
+/// A triple buffered ring that stays persistently mapped, so geometry rebuilt every frame is written straight into GPU visible memory.
+/// Each third is fenced when the ring moves past it and only waited on when the ring wraps back around to it
+struct GL45StreamBuffer
+{
+	static constexpr uint32_t regionCount = 3;
+	static constexpr size_t alignment = 64;
+	
+	inline explicit GL45StreamBuffer(size_t regionSize = 64 * 1024)
+	{
+		this->allocate(regionSize);
+	}
+	
+	inline ~GL45StreamBuffer()
+	{
+		this->release();
+	}
+	
+	/// Reserve space for bytes and get a pointer to write them through, offset() is where they start in the buffer
+	inline unsigned char *map(size_t bytes)
+	{
+		bytes = (bytes + alignment - 1) & ~(alignment - 1);
+		if(bytes > this->regionSize)
+		{
+			this->release();
+			this->allocate(std::max(bytes, this->regionSize * 2));
+			this->stats.reallocations++;
+		}
+		else if(this->cursor + bytes > this->regionSize) this->advance();
+		if(!this->cursor) this->wait();
+		this->lastOffset = this->region * this->regionSize + this->cursor;
+		this->cursor += bytes;
+		return this->mapped + this->lastOffset;
+	}
+	
+	/// The mapping is coherent, nothing needs flushing
+	inline void unmap() {}
+	
+	inline size_t offset() const
+	{
+		return this->lastOffset;
+	}
+	
+	/// Call once per frame after issuing the draws that read this frame's data
+	inline void endFrame()
+	{
+		if(this->cursor) this->advance();
+	}
+	
+	uint32_t handle = 0;
+	StreamBufferStats stats;
+
+private:
+	inline void allocate(size_t size)
+	{
+		GLbitfield constexpr flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		this->regionSize = (size + alignment - 1) & ~(alignment - 1);
+		glCreateBuffers(1, &this->handle);
+		glNamedBufferStorage(this->handle, this->regionSize * regionCount, nullptr, flags);
+		this->mapped = static_cast<unsigned char *>(glMapNamedBufferRange(this->handle, 0, this->regionSize * regionCount, flags));
+		this->region = 0;
+		this->cursor = 0;
+	}
+	
+	/// GL keeps the storage alive until pending draws finish, so the fences can be dropped without waiting on them
+	inline void release()
+	{
+		for(GLsync &fence : this->fences)
+		{
+			if(fence) glDeleteSync(fence);
+			fence = nullptr;
+		}
+		glUnmapNamedBuffer(this->handle);
+		glDeleteBuffers(1, &this->handle);
+	}
+	
+	inline void advance()
+	{
+		this->fences[this->region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		this->region = (this->region + 1) % regionCount;
+		this->cursor = 0;
+	}
+	
+	inline void wait()
+	{
+		GLsync &fence = this->fences[this->region];
+		if(!fence) return;
+		auto start = std::chrono::steady_clock::now();
+		GLenum result;
+		do result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+		while(result == GL_TIMEOUT_EXPIRED);
+		glDeleteSync(fence);
+		fence = nullptr;
+		this->stats.lastFenceWaitNanoseconds = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+		this->stats.fenceWaitNanoseconds += this->stats.lastFenceWaitNanoseconds;
+		if(result != GL_ALREADY_SIGNALED) this->stats.fenceWaits++;
+	}
+	
+	unsigned char *mapped = nullptr;
+	GLsync fences[regionCount] {};
+	size_t regionSize = 0, cursor = 0, lastOffset = 0;
+	uint32_t region = 0;
+};
+
+
+/// Direct state access, nothing has to be bound to create or edit an object
+struct GL45Device : GLDevice
+{
+	using StreamBuffer = GL45StreamBuffer;
+	
+	/// A texture with levels mip levels, sampled trilinearly when there's more than one
+	inline static Texture createTexture(uint32_t width, uint32_t height, TextureFormat format, bool srgb, uint32_t levels = 1)
+	{
+		Texture out = 0;
+		glCreateTextures(GL_TEXTURE_2D, 1, &out);
+		glTextureStorage2D(out, levels, internalFormat(format, srgb), width, height);
+		glTextureParameteri(out, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+		glTextureParameteri(out, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		return out;
+	}
+	
+	/// Replace a region of a level with tightly packed rows in the texture's format
+	inline static void updateTexture(Texture texture, uint32_t x, uint32_t y, uint32_t width, uint32_t height, TextureFormat format, void const *data, uint32_t level = 0)
+	{
+		glTextureSubImage2D(texture, level, x, y, width, height, pixelFormat(format), pixelType(format), data);
+	}
+	
+	/// Only sample levels base to max, the levels before base needn't have been uploaded
+	inline static void setTextureLevels(Texture texture, uint32_t base, uint32_t max)
+	{
+		glTextureParameteri(texture, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(base));
+		glTextureParameteri(texture, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(max));
+	}
+	
+	inline static void setTextureFilter(Texture texture, int32_t min, int32_t mag)
+	{
+		glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, min);
+		glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, mag);
+	}
+	
+	inline static void setTextureAnisotropy(Texture texture, uint32_t level)
+	{
+		glTextureParameterf(texture, GL_TEXTURE_MAX_ANISOTROPY, level);
+	}
+	
+	/// Read back RGBA8 texels, rows from the bottom up like every GL read
+	inline static void readTexture(Texture texture, uint32_t width, uint32_t height, uint32_t *out)
+	{
+		glGetTextureImage(texture, 0, GL_RGBA, GL_UNSIGNED_BYTE, static_cast<int32_t>(width * height * sizeof(uint32_t)), out);
+	}
+	
+	inline static Buffer createBuffer(void const *data, size_t size)
+	{
+		Buffer out = 0;
+		glCreateBuffers(1, &out);
+		glNamedBufferData(out, size, data, GL_STATIC_DRAW);
+		return out;
+	}
+	
+	/// Vertex input for the GUI quad, positions at location 0, UVs at 1 and QuadInstance attributes from the stream buffer at 2 to 7
+	inline static VertexInput createQuadInput(Buffer vertices, Buffer uvs, StreamBuffer &instances)
+	{
+		VertexInput out = 0;
+		glCreateVertexArrays(1, &out);
+		glVertexArrayAttribBinding(out, 0, 0);
+		glVertexArrayVertexBuffer(out, 0, vertices, 0, 3 * sizeof(float));
+		glEnableVertexArrayAttrib(out, 0);
+		glVertexArrayAttribFormat(out, 0, 3, GL_FLOAT, GL_FALSE, 0);
+		
+		glVertexArrayAttribBinding(out, 1, 1);
+		glVertexArrayVertexBuffer(out, 1, uvs, 0, 2 * sizeof(float));
+		glEnableVertexArrayAttrib(out, 1);
+		glVertexArrayAttribFormat(out, 1, 2, GL_FLOAT, GL_FALSE, 0);
+		
+		glVertexArrayVertexBuffer(out, 2, instances.handle, 0, sizeof(QuadInstance));
+		glVertexArrayBindingDivisor(out, 2, 1);
+		for(InstanceAttrib const &attrib : quadInstanceAttribs)
+		{
+			glVertexArrayAttribBinding(out, attrib.location, 2);
+			glEnableVertexArrayAttrib(out, attrib.location);
+			glVertexArrayAttribFormat(out, attrib.location, attrib.components, GL_FLOAT, GL_FALSE, static_cast<uint32_t>(attrib.offset));
+		}
+		return out;
+	}
+	
+	/// A framebuffer with a new RGBA32F color texture, leaves the default framebuffer bound
+	inline static Target createTarget(uint32_t width, uint32_t height, Texture &color)
+	{
+		Target out = 0;
+		glCreateFramebuffers(1, &out);
+		glBindFramebuffer(GL_FRAMEBUFFER, out);
+		glViewport(0, 0, width, height);
+		glScissor(0, 0, width, height);
+		color = createTexture(width, height, TextureFormat::RGBA32F, false);
+		glNamedFramebufferTexture(out, GL_COLOR_ATTACHMENT0, color, 0);
+		GLenum drawBuffers[1] = {GL_COLOR_ATTACHMENT0};
+		glNamedFramebufferDrawBuffers(out, 1, drawBuffers);
+		reportTargetStatus(glCheckNamedFramebufferStatus(out, GL_FRAMEBUFFER));
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		return out;
+	}
+	
+	inline static void bindTexture(uint32_t unit, Texture texture)
+	{
+		glBindTextureUnit(unit, texture);
+	}
+	
+	/// Draw count instances from where the stream buffer was last mapped
+	inline static void drawInstanced(VertexInput input, StreamBuffer &instances, size_t count)
+	{
+		instances.unmap();
+		glVertexArrayVertexBuffer(input, 2, instances.handle, static_cast<GLintptr>(instances.offset()), sizeof(QuadInstance));
+		glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<int32_t>(count));
+	}
+};
@@ -0,0 +1,182 @@
+#pragma once
+
+#include "renderTypes.hh"
+
+#include <algorithm>
+
+/// Shader sources are never compiled
+static constexpr char const *guiVertShader = "";
+static constexpr char const *guiFragShader = "";
+static constexpr char const *guiInstancedVertShader = "";
+static constexpr char const *guiInstancedFragShader = "";
+
+/// What the recording device was asked to do since the last reset
+struct RecordingStats
+{
+	uint64_t texturesCreated = 0, textureUploads = 0, uploadedBytes = 0;
+	uint64_t buffersCreated = 0, pipelinesCreated = 0, targetsCreated = 0, uniforms = 0;
+	uint64_t targetBinds = 0, pipelineBinds = 0, vertexInputBinds = 0, textureBinds = 0, blendChanges = 0, scissorChanges = 0;
+	uint64_t draws = 0, instancedDraws = 0, instances = 0;
+};
+
+/// Touches no graphics API and only counts what it's asked to do, so benchmarks can time everything in front of the driver
+struct RecordingDevice
+{
+	using Texture = uint32_t;
+	using Buffer = uint32_t;
+	using Pipeline = uint32_t;
+	using VertexInput = uint32_t;
+	using Target = uint32_t;
+	using StreamBuffer = HostStreamBuffer;
+	using Query = uint32_t;
+	
+	static constexpr bool bindsToEdit = false;
+	static constexpr bool timestamps = false;
+	
+	inline static RecordingStats &stats()
+	{
+		static RecordingStats out;
+		return out;
+	}
+	
+	inline static void resetStats()
+	{
+		stats() = {};
+	}
+	
+	/// The size new targets are created with
+	inline static void setDefaultTargetSize(uint32_t width, uint32_t height)
+	{
+		targetSize().x() = width;
+		targetSize().y() = height;
+	}
+	
+	inline static void defaultTargetSize(uint32_t &width, uint32_t &height)
+	{
+		width = targetSize().x();
+		height = targetSize().y();
+	}
+	
+	inline static Texture createTexture(uint32_t, uint32_t, TextureFormat, bool, uint32_t = 1)
+	{
+		stats().texturesCreated++;
+		return nextHandle();
+	}
+	
+	inline static void updateTexture(Texture, uint32_t, uint32_t, uint32_t width, uint32_t height, TextureFormat format, void const *, uint32_t = 0)
+	{
+		stats().textureUploads++;
+		stats().uploadedBytes += static_cast<uint64_t>(width) * height * texelSize(format);
+	}
+	
+	inline static void setTextureFilter(Texture, int32_t, int32_t) {}
+	inline static void setTextureAnisotropy(Texture, uint32_t) {}
+	inline static void setTextureLevels(Texture, uint32_t, uint32_t) {}
+	
+	/// Nothing is rendered, reads come back transparent black
+	inline static void readTexture(Texture, uint32_t width, uint32_t height, uint32_t *out)
+	{
+		std::fill(out, out + static_cast<size_t>(width) * height, 0);
+	}
+	
+	inline static void destroyTexture(Texture) {}
+	
+	inline static Buffer createBuffer(void const *, size_t)
+	{
+		stats().buffersCreated++;
+		return nextHandle();
+	}
+	
+	inline static void destroyBuffer(Buffer) {}
+	
+	inline static VertexInput createQuadInput(Buffer, Buffer, StreamBuffer &)
+	{
+		return nextHandle();
+	}
+	
+	inline static void destroyVertexInput(VertexInput) {}
+	
+	inline static Pipeline createPipeline(char const *, char const *)
+	{
+		stats().pipelinesCreated++;
+		return nextHandle();
+	}
+	
+	inline static void destroyPipeline(Pipeline) {}
+	
+	template <typename T> inline static void setUniform(Pipeline, char const *, T const &)
+	{
+		stats().uniforms++;
+	}
+	
+	inline static Target createTarget(uint32_t width, uint32_t height, Texture &color)
+	{
+		stats().targetsCreated++;
+		color = createTexture(width, height, TextureFormat::RGBA32F, false);
+		return nextHandle();
+	}
+	
+	inline static void destroyTarget(Target) {}
+	
+	inline static void bindTarget(Target)
+	{
+		stats().targetBinds++;
+	}
+	
+	inline static void bindPipeline(Pipeline)
+	{
+		stats().pipelineBinds++;
+	}
+	
+	inline static void bindVertexInput(VertexInput)
+	{
+		stats().vertexInputBinds++;
+	}
+	
+	inline static void bindTexture(uint32_t, Texture)
+	{
+		stats().textureBinds++;
+	}
+	
+	/// No GPU timestamps, GPU profiling scopes record nothing
+	inline static Query createQuery() { return 0; }
+	inline static void destroyQuery(Query) {}
+	inline static void writeTimestamp(Query) {}
+	inline static bool queryReady(Query) { return true; }
+	inline static uint64_t queryResult(Query) { return 0; }
+	inline static uint64_t gpuTime() { return 0; }
+	
+	inline static void setBlend(bool)
+	{
+		stats().blendChanges++;
+	}
+	
+	inline static void setScissor(bool, ScissorRect const &)
+	{
+		stats().scissorChanges++;
+	}
+	
+	inline static void draw(uint32_t)
+	{
+		stats().draws++;
+	}
+	
+	inline static void drawInstanced(VertexInput, StreamBuffer &, size_t count)
+	{
+		stats().instancedDraws++;
+		stats().instances += count;
+	}
+
+private:
+	inline static uint32_t nextHandle()
+	{
+		static uint32_t next = 0;
+		return ++next;
+	}
+	
+	inline static IR::vec2<uint32_t> &targetSize()
+	{
+		static IR::vec2<uint32_t> out {1, 1};
+		return out;
+	}
+};
@@ -0,0 +1,216 @@
+#pragma once
+
+#include "renderTypes.hh"
+#include "softwareRaster.hh"
+
+#include <string_view>
+#include <algorithm>
+
+/// Shader sources are ignored, the rasterizer implements the GUI and instanced GUI shaders itself
+static constexpr char const *guiVertShader = "";
+static constexpr char const *guiFragShader = "";
+static constexpr char const *guiInstancedVertShader = "";
+static constexpr char const *guiInstancedFragShader = "";
+
+/// The mvp, projection and color uniforms the rasterizer reads, everything else the GL shaders take is ignored
+struct SoftwarePipeline
+{
+	IR::mat4x4<float> mvp, projection;
+	uint32_t color = 0xFFFFFFFF;
+};
+
+/// Renders through SoftwareRasterizer into CPU memory, textures and targets are both SoftwareTextures
+struct SoftwareDevice
+{
+	using Texture = SoftwareTexture *;
+	using Buffer = float const *;
+	using Pipeline = SoftwarePipeline *;
+	using VertexInput = uint32_t;
+	using Target = SoftwareTexture *;
+	using StreamBuffer = HostStreamBuffer;
+	using Query = uint32_t;
+	
+	static constexpr bool bindsToEdit = false;
+	static constexpr bool timestamps = false;
+	
+	/// The size new targets are created with, set it with SoftwareRasterizer::setViewport
+	inline static void defaultTargetSize(uint32_t &width, uint32_t &height)
+	{
+		width = SoftwareRasterizer::instance().viewportWidth;
+		height = SoftwareRasterizer::instance().viewportHeight;
+	}
+	
+	/// Every format is stored as RGBA8.  Only the base level is kept, it's all nearest sampling reads
+	inline static Texture createTexture(uint32_t width, uint32_t height, TextureFormat, bool, uint32_t = 1)
+	{
+		Texture out = new SoftwareTexture;
+		out->resize(width, height);
+		out->fullWidth = width;
+		out->fullHeight = height;
+		return out;
+	}
+	
+	/// Replace a region with tightly packed rows in the texture's format, queued draws still see the old texels.  Levels other than the base are dropped
+	inline static void updateTexture(Texture texture, uint32_t x, uint32_t y, uint32_t width, uint32_t height, TextureFormat format, void const *data, uint32_t level = 0)
+	{
+		if(level != texture->level) return;
+		SoftwareRasterizer::instance().flush();
+		unsigned char const *bytes = static_cast<unsigned char const *>(data);
+		float const *floats = static_cast<float const *>(data);
+		for(uint32_t row = 0; row < height; row++)
+		{
+			uint32_t *out = &texture->texels[static_cast<size_t>(y + row) * texture->width + x];
+			for(uint32_t i = 0; i < width; i++)
+			{
+				size_t texel = static_cast<size_t>(row) * width + i;
+				switch(format)
+				{
+					case TextureFormat::RGB8: out[i] = packRGBA(bytes[texel * 3], bytes[texel * 3 + 1], bytes[texel * 3 + 2], 255); break;
+					case TextureFormat::RGBA8: out[i] = packRGBA(bytes[texel * 4], bytes[texel * 4 + 1], bytes[texel * 4 + 2], bytes[texel * 4 + 3]); break;
+					default: out[i] = packRGBA(packUnorm(floats[texel * 4]), packUnorm(floats[texel * 4 + 1]), packUnorm(floats[texel * 4 + 2]), packUnorm(floats[texel * 4 + 3])); break;
+				}
+			}
+		}
+	}
+	
+	/// Textures are always sampled nearest
+	inline static void setTextureFilter(Texture, int32_t, int32_t) {}
+	inline static void setTextureAnisotropy(Texture, uint32_t) {}
+	
+	/// Moving the base level reallocates the texture at that level's size, upload it afterwards
+	inline static void setTextureLevels(Texture texture, uint32_t base, uint32_t)
+	{
+		if(base == texture->level) return;
+		SoftwareRasterizer::instance().flush();
+		texture->resize(std::max(texture->fullWidth >> base, 1u), std::max(texture->fullHeight >> base, 1u));
+		texture->level = base;
+	}
+	
+	/// Finish queued draws and read back the texels, row 0 is the top
+	inline static void readTexture(Texture texture, uint32_t, uint32_t, uint32_t *out)
+	{
+		SoftwareRasterizer::instance().flush();
+		std::copy(texture->texels.begin(), texture->texels.end(), out);
+	}
+	
+	/// Queued draws may still sample the texture
+	inline static void destroyTexture(Texture texture)
+	{
+		SoftwareRasterizer::instance().flush();
+		delete texture;
+	}
+	
+	/// Vertex buffers only ever hold the GUI quad, which the rasterizer knows
+	inline static Buffer createBuffer(void const *data, size_t)
+	{
+		return static_cast<float const *>(data);
+	}
+	
+	inline static void destroyBuffer(Buffer) {}
+	inline static VertexInput createQuadInput(Buffer, Buffer, StreamBuffer &) { return 0; }
+	inline static void destroyVertexInput(VertexInput) {}
+	
+	inline static Pipeline createPipeline(char const *, char const *)
+	{
+		return new SoftwarePipeline;
+	}
+	
+	inline static void destroyPipeline(Pipeline pipeline)
+	{
+		SoftwareRasterizer &rasterizer = SoftwareRasterizer::instance();
+		if(rasterizer.mvp == &pipeline->mvp) rasterizer.mvp = nullptr;
+		if(rasterizer.projection == &pipeline->projection) rasterizer.projection = nullptr;
+		if(rasterizer.tint == &pipeline->color) rasterizer.tint = nullptr;
+		delete pipeline;
+	}
+	
+	template <typename T> inline static void setUniform(Pipeline, char const *, T const &) {}
+	
+	inline static void setUniform(Pipeline pipeline, char const *location, IR::mat4x4<float> const &val)
+	{
+		if(std::string_view{location} == "mvp") pipeline->mvp = val;
+		else if(std::string_view{location} == "projection") pipeline->projection = val;
+	}
+	
+	inline static void setUniform(Pipeline pipeline, char const *location, IR::vec4<float> const &val)
+	{
+		if(std::string_view{location} == "color") pipeline->color = packRGBA(packUnorm(val.x()), packUnorm(val.y()), packUnorm(val.z()), packUnorm(val.w()));
+	}
+	
+	/// Targets are their own color texture
+	inline static Target createTarget(uint32_t width, uint32_t height, Texture &color)
+	{
+		color = createTexture(width, height, TextureFormat::RGBA8, false);
+		return color;
+	}
+	
+	/// The color texture is destroyed separately
+	inline static void destroyTarget(Target target)
+	{
+		if(SoftwareRasterizer::instance().boundTarget() == target) SoftwareRasterizer::instance().bindTarget(nullptr);
+	}
+	
+	inline static void bindTarget(Target target)
+	{
+		SoftwareRasterizer::instance().bindTarget(target);
+	}
+	
+	inline static void bindPipeline(Pipeline pipeline)
+	{
+		SoftwareRasterizer::instance().mvp = pipeline ? &pipeline->mvp : nullptr;
+		SoftwareRasterizer::instance().projection = pipeline ? &pipeline->projection : nullptr;
+		SoftwareRasterizer::instance().tint = pipeline ? &pipeline->color : nullptr;
+	}
+	
+	inline static void bindVertexInput(VertexInput) {}
+	
+	/// Only texture unit 0 is sampled
+	inline static void bindTexture(uint32_t unit, Texture texture)
+	{
+		if(unit == 0) SoftwareRasterizer::instance().bindTexture(texture);
+	}
+	
+	/// No GPU timestamps, GPU profiling scopes record nothing
+	inline static Query createQuery() { return 0; }
+	inline static void destroyQuery(Query) {}
+	inline static void writeTimestamp(Query) {}
+	inline static bool queryReady(Query) { return true; }
+	inline static uint64_t queryResult(Query) { return 0; }
+	inline static uint64_t gpuTime() { return 0; }
+	
+	inline static void setBlend(bool enabled)
+	{
+		SoftwareRasterizer::instance().blending = enabled;
+	}
+	
+	inline static void setScissor(bool enabled, ScissorRect const &rect)
+	{
+		SoftwareRasterizer::instance().setScissor(enabled, rect.x, rect.y, rect.width, rect.height);
+	}
+	
+	/// Draw the GUI quad with the bound pipeline's mvp and color
+	inline static void draw(uint32_t)
+	{
+		SoftwareRasterizer &rasterizer = SoftwareRasterizer::instance();
+		if(rasterizer.mvp) rasterizer.drawQuad(*rasterizer.mvp, rasterizer.tint ? *rasterizer.tint : 0xFFFFFFFF);
+	}
+	
+	/// Draw count instances from where the stream buffer was last mapped with the bound pipeline's projection
+	inline static void drawInstanced(VertexInput, StreamBuffer &instances, size_t count)
+	{
+		SoftwareRasterizer &rasterizer = SoftwareRasterizer::instance();
+		if(!rasterizer.projection) return;
+		QuadInstance const *instance = reinterpret_cast<QuadInstance const *>(instances.data() + instances.offset());
+		for(size_t i = 0; i < count; i++, instance++)
+		{
+			uint32_t color = packRGBA(packUnorm(instance->color.x()), packUnorm(instance->color.y()), packUnorm(instance->color.z()), packUnorm(instance->color.w()));
+			if(instance->shape.w() == 0) rasterizer.drawRect(*rasterizer.projection, instance->rect, instance->uvRect, color, instance->layer);
+			else
+			{
+				IR::vec4<float> const &border = instance->borderColor;
+				uint32_t borderColor = packRGBA(packUnorm(border.x()), packUnorm(border.y()), packUnorm(border.z()), packUnorm(border.w()));
+				rasterizer.drawShape(*rasterizer.projection, instance->rect, instance->uvRect, color, borderColor, instance->shape, instance->layer);
+			}
+		}
+	}
+};
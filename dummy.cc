@@ -0,0 +1,64 @@
+#include <iris/vec2.hh>
+#include <iris/vec3.hh>
+#include <iris/vec4.hh>
+#include <iris/mat3.hh>
+#include <iris/mat4.hh>
+#include <iris/quaternion.hh>
+#include <iris/shapes.hh>
+#include "nineSlice.hh"
+
+//The library has no other translation unit, so these compile time checks of iris' constexpr support run on every build
+namespace
+{
+	constexpr IR::vec2<int32_t> padding {8, 4};
+	constexpr IR::vec2<int32_t> buttonSize = IR::vec2<int32_t>{120, 32} + padding * 2;
+	static_assert(buttonSize == IR::vec2<int32_t>{136, 40});
+	static_assert(-buttonSize == IR::vec2<int32_t>{-136, -40} && buttonSize.dot(padding) == 1248);
+	static_assert(IR::vec3<float>{1, 0, 0}.cross({0, 1, 0}) == IR::vec3<float>{0, 0, 1});
+	static_assert(IR::vec4<float>{1, 2, 3, 4}.dot(IR::vec4<float>{1}) == 10);
+	
+	constexpr IR::vec2<int32_t> postIncrement()
+	{
+		IR::vec2<int32_t> a {1, 2}, b = a++;
+		return a - b;
+	}
+	static_assert(postIncrement() == IR::vec2<int32_t>{1, 1});
+	
+	constexpr IR::mat4x4<float> projection = IR::mat4x4<float>::orthoProjectionMatrix(0, 2048, 1024, 0, 1, 100);
+	constexpr IR::mat4x4<float> model = IR::mat4x4<float>::modelMatrix({1024, 512, 1}, {}, {2, 2, 1});
+	constexpr IR::vec4<float> center = model * projection * IR::vec4<float>{0, 0, 0, 1};
+	static_assert(projection[0][0] == 1.0f / 1024.0f && projection[3][0] == -1.0f && projection[3][1] == -1.0f);
+	static_assert(center.x() == 0 && center.y() == 0 && center.w() == 1);
+	static_assert(model.inverse() * model == IR::mat4x4<float>{});
+	static_assert(model.transpose().transpose() == model && model.determinant() == 4);
+	static_assert(IR::mat3x3<float>{model}.determinant() == 4);
+	static_assert(IR::mat4x4<double>::translateMat({1, 2, 3}).inverse() == IR::mat4x4<double>::translateMat({-1, -2, -3}));
+	
+	constexpr IR::aabb2D<int32_t> clip {0, 100, 0, 50};
+	static_assert(clip.containsPoint(10, 10) && !clip.containsPoint(100, 10));
+	static_assert(clip.isIntersecting({90, 200, 40, 60}) && !clip.predictIntersection(200, 0, {90, 200, 40, 60}));
+	static_assert(IR::aabb3D<float>{0, 1, 0, 1, 0, 1}.containsPoint(0.5f, 0.5f, 0.5f));
+	
+	//A 32x32 nine-slice image with 8 texel corners, drawn at 100x40 and at 10x40 where the left and right corners have to shrink to fit
+	constexpr NineSlice frame {32, 32, {8, 8, 8, 8}};
+	struct Slices
+	{
+		QuadInstance quads[9] {};
+		size_t count = 0;
+	};
+	
+	constexpr Slices sliced(float width)
+	{
+		Slices out;
+		out.count = frame.expand({10, 50, width, 40}, {1, 1, 1, 1}, 2, out.quads);
+		return out;
+	}
+	constexpr Slices wide = sliced(100), narrow = sliced(10);
+	static_assert(wide.count == 9 && narrow.count == 6);
+	static_assert(wide.quads[0].rect.x() == 10 && wide.quads[0].rect.y() == 50 && wide.quads[0].rect.z() == 8 && wide.quads[0].rect.w() == 8);
+	static_assert(wide.quads[0].uvRect.x() == 0 && wide.quads[0].uvRect.z() == 0.25f && wide.quads[0].uvRect.w() == 0.25f);
+	static_assert(wide.quads[4].rect.x() == 18 && wide.quads[4].rect.y() == 42 && wide.quads[4].rect.z() == 84 && wide.quads[4].rect.w() == 24);
+	static_assert(wide.quads[4].uvRect.x() == 0.25f && wide.quads[4].uvRect.z() == 0.75f && wide.quads[4].layer == 2);
+	static_assert(wide.quads[8].rect.x() == 102 && wide.quads[8].rect.y() == 18 && wide.quads[8].uvRect.z() == 1 && wide.quads[8].uvRect.w() == 1);
+	static_assert(narrow.quads[0].rect.z() == 5 && narrow.quads[1].rect.x() == 15 && narrow.quads[1].uvRect.x() == 0.75f);
+}
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "definitions.hh"
+
+#include <pango/pangocairo.h>
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+
+/// A font description string such as "Sans Bold 12" and a language tag such as "ja", empty for the default language
+struct FontKey
+{
+	std::string description, language;
+};
+
+struct FontCacheStats
+{
+	uint64_t hits = 0, misses = 0, evictions = 0;
+	uint64_t loadNanoseconds = 0, slowestLoadNanoseconds = 0;
+	size_t residentBytes = 0;
+};
+
+/// Resolved Pango fontsets kept alive across layouts so font selection and fallback loading happen once per description and language.
+/// Pango font maps aren't thread safe, so every thread gets its own font map and LRU through local(),
+/// while the memory budget, warmup list and stats are shared by the whole process
+struct FontCache final
+{
+	/// Pango doesn't report what a fontset costs, so each font it resolves to is charged this many bytes against the budget
+	static constexpr size_t bytesPerFace = 512 * 1024;
+
+	/// The calling thread's cache
+	inline static FontCache &local()
+	{
+		thread_local FontCache cache;
+		return cache;
+	}
+
+	/// Caps the estimated memory of every thread's cached fontsets combined, least recently used fontsets are released past it
+	inline static void setMemoryBudget(size_t bytes)
+	{
+		shared().budget.store(bytes);
+	}
+
+	/// Fonts every thread loads up front the first time it uses the cache, or when warmup() is called
+	inline static void setWarmupList(std::vector<FontKey> fonts)
+	{
+		std::lock_guard<std::mutex> guard(shared().warmupMutex);
+		shared().warmupList = std::move(fonts);
+	}
+
+	inline static FontCacheStats stats()
+	{
+		FontCacheStats out;
+		out.hits = shared().hits.load();
+		out.misses = shared().misses.load();
+		out.evictions = shared().evictions.load();
+		out.loadNanoseconds = shared().loadNanoseconds.load();
+		out.slowestLoadNanoseconds = shared().slowestLoadNanoseconds.load();
+		out.residentBytes = shared().residentBytes.load();
+		return out;
+	}
+
+	FontCache(FontCache const &) = delete;
+	FontCache &operator=(FontCache const &) = delete;
+
+	inline ~FontCache()
+	{
+		for(Entry &entry : this->lru) this->release(entry);
+		for(auto &context : this->contexts) g_object_unref(context.second);
+		g_object_unref(this->fontMap);
+	}
+
+	/// A context for shaping text in a language, owned by the cache
+	inline PangoContext *context(std::string const &language)
+	{
+		auto it = this->contexts.find(language);
+		if(it != this->contexts.end()) return it->second;
+		PangoContext *out = pango_font_map_create_context(this->fontMap);
+		if(!language.empty()) pango_context_set_language(out, pango_language_from_string(language.data()));
+		this->contexts.emplace(language, out);
+		return out;
+	}
+
+	/// Resolve the fontset for a description and language, loading it on a miss.  The fontset is owned by the cache
+	inline PangoFontset *fontset(FontKey const &key)
+	{
+		std::string id = key.description + '\n' + key.language;
+		auto it = this->index.find(id);
+		if(it != this->index.end())
+		{
+			this->lru.splice(this->lru.begin(), this->lru, it->second);
+			shared().hits++;
+			return it->second->fontset;
+		}
+		shared().misses++;
+		auto start = std::chrono::steady_clock::now();
+		PangoFontDescription *description = pango_font_description_from_string(key.description.data());
+		PangoLanguage *language = key.language.empty() ? pango_language_get_default() : pango_language_from_string(key.language.data());
+		PangoFontset *fontset = pango_font_map_load_fontset(this->fontMap, this->context(key.language), description, language);
+		pango_font_description_free(description);
+		uint64_t elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+		shared().loadNanoseconds += elapsed;
+		uint64_t slowest = shared().slowestLoadNanoseconds.load();
+		while(elapsed > slowest && !shared().slowestLoadNanoseconds.compare_exchange_weak(slowest, elapsed));
+		if(!fontset) return nullptr;
+		size_t faces = 0;
+		pango_fontset_foreach(fontset, [](PangoFontset *, PangoFont *, void *count) -> gboolean
+		{
+			(*static_cast<size_t *>(count))++;
+			return false;
+		}, &faces);
+		this->lru.push_front({id, fontset, std::max<size_t>(faces, 1) * bytesPerFace});
+		this->index.emplace(id, this->lru.begin());
+		shared().residentBytes += this->lru.front().bytes;
+		this->trim();
+		return fontset;
+	}
+
+	/// Load every font on the warmup list into this thread's cache
+	inline void warmup()
+	{
+		std::vector<FontKey> fonts;
+		{
+			std::lock_guard<std::mutex> guard(shared().warmupMutex);
+			fonts = shared().warmupList;
+		}
+		for(FontKey const &font : fonts) this->fontset(font);
+	}
+
+	PangoFontMap *const fontMap;
+
+private:
+	struct Entry
+	{
+		std::string id;
+		PangoFontset *fontset;
+		size_t bytes;
+	};
+
+	struct Shared
+	{
+		std::atomic<size_t> budget {64 * 1024 * 1024}, residentBytes {0};
+		std::atomic<uint64_t> hits {0}, misses {0}, evictions {0}, loadNanoseconds {0}, slowestLoadNanoseconds {0};
+		std::mutex warmupMutex;
+		std::vector<FontKey> warmupList;
+	};
+
+	inline static Shared &shared()
+	{
+		static Shared out;
+		return out;
+	}
+
+	inline FontCache() : fontMap(pango_cairo_font_map_new())
+	{
+		this->warmup();
+	}
+
+	inline void release(Entry &entry)
+	{
+		g_object_unref(entry.fontset);
+		shared().residentBytes -= entry.bytes;
+	}
+
+	/// Each thread can only release its own fontsets, so a thread trims its LRU whenever the process wide total is over budget.
+	/// The most recently loaded fontset is always kept
+	inline void trim()
+	{
+		while(shared().residentBytes.load() > shared().budget.load() && this->lru.size() > 1)
+		{
+			this->release(this->lru.back());
+			this->index.erase(this->lru.back().id);
+			this->lru.pop_back();
+			shared().evictions++;
+		}
+	}
+
+	std::list<Entry> lru;
+	std::unordered_map<std::string, std::list<Entry>::iterator> index;
+	std::unordered_map<std::string, PangoContext *> contexts;
+};
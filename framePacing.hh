@@ -0,0 +1,136 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+
+/// Tracks whether anything visible changed since the last frame, so an app can sleep instead of redrawing identical frames.
+/// invalidate() and requestFrame() may be called from any thread, everything else belongs to the thread that renders.
+/// A render on demand loop looks like:
+///   if(pacer.needsRedraw()) { pacer.beginFrame(); render(); swap(); }
+///   else wait for input with a timeout of pacer.millisecondsUntilDeadline(), or pacer.waitUntilDeadline() without input
+struct FramePacer final
+{
+	using Clock = std::chrono::steady_clock;
+	
+	inline static FramePacer &instance()
+	{
+		static FramePacer out;
+		return out;
+	}
+	
+	/// Something visible changed, the next frame must be drawn
+	inline void invalidate()
+	{
+		if(this->dirty.exchange(true, std::memory_order_acq_rel)) return;
+		this->notify();
+	}
+	
+	/// Draw a frame no later than when, for animations and blinking cursors that change without an event
+	inline void requestFrame(Clock::time_point when)
+	{
+		int64_t at = when.time_since_epoch().count(), current = this->scheduled.load(std::memory_order_relaxed);
+		while(at < current && !this->scheduled.compare_exchange_weak(current, at, std::memory_order_acq_rel));
+		if(at < current) this->notify();
+	}
+	
+	/// Frames are never started closer together than this, vsync usually paces them already but remote and offscreen targets don't
+	inline void setFrameInterval(Clock::duration interval)
+	{
+		this->interval = interval;
+	}
+	
+	/// True when a frame is pending and due, which is never sooner than the frame interval after the last one
+	inline bool needsRedraw() const
+	{
+		Clock::time_point deadline = this->nextDeadline();
+		return deadline != Clock::time_point::max() && deadline <= Clock::now();
+	}
+	
+	/// Call right before rendering, anything invalidated while the frame is drawn keeps the next frame pending
+	inline void beginFrame()
+	{
+		Clock::time_point now = Clock::now();
+		this->dirty.store(false, std::memory_order_release);
+		int64_t current = this->scheduled.load(std::memory_order_relaxed);
+		while(current <= now.time_since_epoch().count() && !this->scheduled.compare_exchange_weak(current, noFrame, std::memory_order_acq_rel));
+		this->lastFrame = now;
+		this->frames++;
+	}
+	
+	/// When the next frame should start, Clock::time_point::max() if nothing is pending
+	inline Clock::time_point nextDeadline() const
+	{
+		int64_t scheduled = this->scheduled.load(std::memory_order_acquire);
+		if(!this->dirty.load(std::memory_order_acquire) && scheduled == noFrame) return Clock::time_point::max();
+		Clock::time_point wanted = this->dirty.load(std::memory_order_acquire) ? Clock::now() : Clock::time_point(Clock::duration(scheduled));
+		return std::max(wanted, this->lastFrame + this->interval);
+	}
+	
+	/// For event waits with a timeout like SDL_WaitEventTimeout, -1 means nothing is pending so wait for input indefinitely
+	inline int32_t millisecondsUntilDeadline() const
+	{
+		Clock::time_point deadline = this->nextDeadline();
+		if(deadline == Clock::time_point::max()) return -1;
+		int64_t out = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now() + std::chrono::microseconds(999)).count();
+		return static_cast<int32_t>(std::clamp<int64_t>(out, 0, INT32_MAX));
+	}
+	
+	/// Sleep until the next frame is due or limit passes, waking early when another thread invalidates.  Returns needsRedraw()
+	inline bool waitUntilDeadline(Clock::time_point limit = Clock::time_point::max())
+	{
+		std::unique_lock<std::mutex> lock(this->mutex);
+		while(true)
+		{
+			Clock::time_point deadline = std::min(this->nextDeadline(), limit);
+			if(deadline != Clock::time_point::max() && Clock::now() >= deadline) break;
+			uint64_t wakes = this->wakes;
+			if(deadline == Clock::time_point::max()) this->wake.wait(lock, [&]{return this->wakes != wakes;});
+			else this->wake.wait_until(lock, deadline, [&]{return this->wakes != wakes;});
+		}
+		return this->needsRedraw();
+	}
+	
+	/// Called from whichever thread invalidates, so an app blocked waiting for input can be woken, eg by pushing an SDL user event
+	inline void setWakeCallback(std::function<void()> callback)
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->onWake = std::move(callback);
+	}
+	
+	/// Frames begun so far
+	inline uint64_t frameCount() const
+	{
+		return this->frames;
+	}
+
+private:
+	static constexpr int64_t noFrame = INT64_MAX;
+	
+	FramePacer() = default;
+	
+	inline void notify()
+	{
+		std::function<void()> callback;
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->wakes++;
+			callback = this->onWake;
+		}
+		this->wake.notify_all();
+		if(callback) callback();
+	}
+	
+	std::atomic<bool> dirty {true};
+	std::atomic<int64_t> scheduled {noFrame}; //Clock ticks of the earliest requested frame
+	Clock::duration interval = std::chrono::microseconds(16667);
+	Clock::time_point lastFrame {};
+	uint64_t frames = 0, wakes = 0;
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::function<void()> onWake;
+};
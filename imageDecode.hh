@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdio>
+#include <png.h>
+#include <jpeglib.h>
+#include <csetjmp>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/// Texels decoded from an image file, tightly packed rows with row 0 at the top
+struct DecodedImage
+{
+	uint32_t width = 0, height = 0, channels = 4;
+	std::vector<unsigned char> texels;
+};
+
+/// Decode PNG data into RGBA, false if it is corrupt
+inline bool decodePNG(unsigned char const *data, size_t size, DecodedImage &out)
+{
+	png_image image;
+	memset(&image, 0, sizeof(image));
+	image.version = PNG_IMAGE_VERSION;
+	if(!png_image_begin_read_from_memory(&image, data, size)) return false;
+	image.format = PNG_FORMAT_RGBA;
+	out.width = image.width;
+	out.height = image.height;
+	out.channels = 4;
+	out.texels.resize(PNG_IMAGE_SIZE(image));
+	if(png_image_finish_read(&image, nullptr, out.texels.data(), 0, nullptr)) return true;
+	out.texels.clear();
+	return false;
+}
+
+/// Decode JPEG data into RGB, false if it is corrupt
+inline bool decodeJPEG(unsigned char const *data, size_t size, DecodedImage &out)
+{
+	//libjpeg reports errors by calling error_exit, which mustn't return, so jump back out of the decode
+	struct Error
+	{
+		jpeg_error_mgr manager;
+		std::jmp_buf jump;
+	};
+	jpeg_decompress_struct info;
+	Error error;
+	info.err = jpeg_std_error(&error.manager);
+	error.manager.error_exit = [](j_common_ptr info){std::longjmp(reinterpret_cast<Error *>(info->err)->jump, 1);};
+	error.manager.output_message = [](j_common_ptr){};
+	if(setjmp(error.jump))
+	{
+		jpeg_destroy_decompress(&info);
+		out.texels.clear();
+		return false;
+	}
+	jpeg_create_decompress(&info);
+	jpeg_mem_src(&info, data, static_cast<unsigned long>(size));
+	jpeg_read_header(&info, TRUE);
+	info.out_color_space = JCS_RGB;
+	jpeg_start_decompress(&info);
+	out.width = info.output_width;
+	out.height = info.output_height;
+	out.channels = 3;
+	out.texels.resize(static_cast<size_t>(out.width) * out.height * 3);
+	while(info.output_scanline < info.output_height)
+	{
+		JSAMPROW row = &out.texels[static_cast<size_t>(info.output_scanline) * out.width * 3];
+		jpeg_read_scanlines(&info, &row, 1);
+	}
+	jpeg_finish_decompress(&info);
+	jpeg_destroy_decompress(&info);
+	return true;
+}
+
+/// Decode a PNG or JPEG, told apart by their signatures rather than by file name
+inline bool decodeImage(unsigned char const *data, size_t size, DecodedImage &out)
+{
+	static unsigned char constexpr pngSignature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+	if(size >= 8 && memcmp(data, pngSignature, 8) == 0) return decodePNG(data, size, out);
+	if(size >= 3 && data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF) return decodeJPEG(data, size, out);
+	return false;
+}
+
+/// Scale color by alpha in RGBA texels, for images drawn with premultiplied blending
+inline void premultiplyAlpha(unsigned char *texels, size_t count)
+{
+	for(size_t i = 0; i < count; i++, texels += 4)
+	{
+		uint32_t alpha = texels[3];
+		for(uint32_t c = 0; c < 3; c++) texels[c] = static_cast<unsigned char>((texels[c] * alpha + 127) / 255);
+	}
+}
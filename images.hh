@@ -0,0 +1,292 @@
+#pragma once
+
+#include "util.hh"
+#include "definitions.hh"
+#include "pixmap.hh"
+#include "mipmap.hh"
+#include "mappedFile.hh"
+#include "profiler.hh"
+#include "framePacing.hh"
+#include "imageDecode.hh"
+
+#include <string>
+#include <cstring>
+#include <vector>
+#include <deque>
+#include <atomic>
+#include <functional>
+#include <iris/vec4.hh>
+
+/// How ImageLoader prepares an image on its workers
+struct ImageOptions
+{
+	bool srgb = true; //The file's texels are sRGB encoded, as nearly every PNG and JPEG is
+	bool premultiply = false;
+	bool mips = false; //Build a MipChain to sample the image trilinearly
+	bool atlas = false; //Pack it into a shared ImageAtlas page, only for sRGB images no larger than ImageAtlas::maxImage and never with mips
+	uint32_t drawSize = 0; //With mips, only upload the levels sampled when drawn this size, ImageHandle::current().mips uploads the rest
+};
+
+/// Small images packed onto shelves of shared RGBA sRGB pages, so icons loaded one by one are drawn from a few textures.
+/// Each image's edge texels are repeated into the gutter around it, so linear filtering at its edge never reaches its neighbours.
+/// Only touched on the GL thread by ImageLoader::finalize()
+struct ImageAtlas final
+{
+	static constexpr uint32_t pageSize = 2048;
+	static constexpr uint32_t padding = 2; //A texel of each neighbour's extruded edge
+	static constexpr uint32_t maxImage = 256;
+	
+	/// Pack a width x height RGBA image, starting a new page when the current one is full.  Returns the page and sets where on it the image is in uvs
+	inline SP<Pixmap> const &insert(uint32_t width, uint32_t height, unsigned char const *texels, IR::vec4<float> &uvRect)
+	{
+		if(this->penX + width + padding > pageSize)
+		{
+			this->penX = padding;
+			this->penY += this->shelfHeight + padding;
+			this->shelfHeight = 0;
+		}
+		if(this->pages.empty() || this->penY + height + padding > pageSize)
+		{
+			this->pages.push_back(MS<Pixmap>(nullptr, pageSize, pageSize, true, true));
+			std::vector<unsigned char> clear(static_cast<size_t>(pageSize) * pageSize * 4, 0); //GL leaves new storage undefined
+			this->pages.back()->update(0, 0, pageSize, pageSize, clear.data());
+			this->penX = padding;
+			this->penY = padding;
+			this->shelfHeight = 0;
+		}
+		uint32_t x = this->penX, y = this->penY;
+		uvRect = {static_cast<float>(x) / pageSize, static_cast<float>(y) / pageSize, static_cast<float>(x + width) / pageSize, static_cast<float>(y + height) / pageSize};
+		//The image with a texel more on every side, clamped back to its edge
+		std::vector<unsigned char> extruded(static_cast<size_t>(width + 2) * (height + 2) * 4);
+		for(uint32_t row = 0; row < height + 2; row++)
+		{
+			unsigned char const *from = &texels[static_cast<size_t>(std::clamp(row, 1u, height) - 1) * width * 4];
+			unsigned char *to = &extruded[static_cast<size_t>(row) * (width + 2) * 4];
+			memcpy(to, from, 4);
+			memcpy(to + 4, from, static_cast<size_t>(width) * 4);
+			memcpy(to + (width + 1) * 4, from + (width - 1) * 4, 4);
+		}
+		this->pages.back()->update(x - 1, y - 1, width + 2, height + 2, extruded.data());
+		this->penX += width + padding;
+		this->shelfHeight = std::max(this->shelfHeight, height);
+		return this->pages.back();
+	}
+	
+	std::vector<SP<Pixmap>> pages;
+
+private:
+	uint32_t penX = padding, penY = padding, shelfHeight = 0;
+};
+
+/// What a widget draws for an image, uvRect is where in pixmap it is
+struct LoadedImage
+{
+	SP<Pixmap> pixmap;
+	IR::vec4<float> uvRect {0, 0, 1, 1};
+	uint32_t width = 0, height = 0;
+	SP<MipChain const> mips; //Kept when only some levels were uploaded, for Pixmap::uploadLevels()
+};
+
+/// A widget's handle to an image being loaded.  Until it has been uploaded current() is the loader's placeholder,
+/// so the first frame draws without waiting on the disk or the decoder
+struct ImageHandle
+{
+	inline LoadedImage const &current() const
+	{
+		return this->image;
+	}
+	
+	/// True once the image has replaced the placeholder
+	inline bool ready() const
+	{
+		return this->loaded;
+	}
+	
+	/// True if the file couldn't be read or decoded, current() then stays the placeholder
+	inline bool failed() const
+	{
+		return this->broken;
+	}
+
+private:
+	friend struct ImageLoader;
+	
+	LoadedImage image;
+	std::function<void(ImageHandle &)> onReady;
+	bool loaded = false, broken = false;
+};
+
+/// Reads PNG and JPEG files through mmap and decodes them on a worker pool, then the GL thread uploads them in finalize() a few at a time.
+/// Create it on the GL thread, it creates its placeholder pixmap straight away
+struct ImageLoader final
+{
+	/// placeholder is what handles show until their image arrives, a transparent texel when null
+	inline explicit ImageLoader(SP<Pixmap> placeholder = nullptr, size_t threadCount = std::max(2u, std::thread::hardware_concurrency()) - 1) : pool(threadCount)
+	{
+		this->placeholder = placeholder ? std::move(placeholder) : MS<Pixmap>(0, 0, 0, 0);
+	}
+	
+	/// Queue path to be read and decoded off-thread.  onReady is called on the GL thread by finalize() once the image is drawable or has failed,
+	/// the returned handle may be dropped early to cancel loading
+	inline SP<ImageHandle> load(std::string path, ImageOptions options = {}, std::function<void(ImageHandle &)> onReady = nullptr)
+	{
+		SP<ImageHandle> handle = MS<ImageHandle>();
+		handle->image.pixmap = this->placeholder;
+		handle->image.width = this->placeholder->width;
+		handle->image.height = this->placeholder->height;
+		handle->onReady = std::move(onReady);
+		this->loading++;
+		WP<ImageHandle> weakHandle = handle;
+		this->pool.enqueue([this, weakHandle, path = std::move(path), options]
+		{
+			Decoded result;
+			result.handle = weakHandle;
+			result.options = options;
+			if(!weakHandle.expired()) this->decode(path, result);
+			this->decodedSL.lock();
+			this->decoded.push_back(std::move(result));
+			this->decodedSL.unlock();
+			FramePacer::instance().invalidate(); //finalize() only runs when a frame is drawn
+		});
+		return handle;
+	}
+	
+	/// Must be called on the GL thread before drawing images.  Uploads decoded images in the order they finished until uploadBudget bytes have gone up,
+	/// at least one a frame however large, and leaves the rest for the frames after
+	inline void finalize(size_t uploadBudget = 8 * 1024 * 1024)
+	{
+		WUI_PROFILE_SCOPE("ImageLoader::finalize");
+		this->decodedSL.lock();
+		for(Decoded &result : this->decoded) this->waiting.push_back(std::move(result));
+		this->decoded.clear();
+		this->decodedSL.unlock();
+		size_t spent = 0;
+		while(!this->waiting.empty())
+		{
+			Decoded &next = this->waiting.front();
+			SP<ImageHandle> handle = next.handle.lock();
+			size_t cost = handle ? next.bytes() : 0;
+			if(spent && spent + cost > uploadBudget) break;
+			spent += cost;
+			if(handle) this->upload(next, *handle);
+			this->waiting.pop_front();
+			this->loading--;
+		}
+		if(!this->waiting.empty()) FramePacer::instance().invalidate(); //keep drawing frames until the rest are up
+	}
+	
+	/// Images queued that haven't been finalized yet
+	inline size_t pending() const
+	{
+		return this->loading.load();
+	}
+	
+	ImageAtlas atlas;
+
+private:
+	/// An image leaving the workers, texels when it is uploaded whole and mips when it was given a chain
+	struct Decoded
+	{
+		WP<ImageHandle> handle;
+		ImageOptions options;
+		DecodedImage image;
+		SP<MipChain> mips;
+		bool failed = true, packed = false;
+		
+		inline size_t bytes() const
+		{
+			if(this->mips) return this->mips->bytes(this->firstLevel());
+			return this->image.texels.size();
+		}
+		
+		inline uint32_t firstLevel() const
+		{
+			return this->options.drawSize ? this->mips->levelFor(this->options.drawSize, this->options.drawSize) : 0;
+		}
+	};
+	
+	/// On a worker, everything but the upload
+	inline void decode(std::string const &path, Decoded &out)
+	{
+		WUI_PROFILE_SCOPE("ImageLoader::decode");
+		MappedFile file;
+		if(!file.open(path)) return;
+		if(!decodeImage(file.data(), file.size(), out.image) || !out.image.width || !out.image.height)
+		{
+			printf("Error decoding image %s\n", path.data());
+			return;
+		}
+		file.close();
+		DecodedImage &image = out.image;
+		ImageOptions const &options = out.options;
+		out.packed = options.atlas && !options.mips && options.srgb && image.width <= ImageAtlas::maxImage && image.height <= ImageAtlas::maxImage;
+		if(out.packed && image.channels == 3) //Atlas pages are RGBA
+		{
+			size_t count = static_cast<size_t>(image.width) * image.height;
+			image.texels.resize(count * 4);
+			for(size_t i = count; i-- > 0;)
+			{
+				unsigned char *to = &image.texels[i * 4], *from = &image.texels[i * 3];
+				to[3] = 255;
+				to[2] = from[2];
+				to[1] = from[1];
+				to[0] = from[0];
+			}
+			image.channels = 4;
+		}
+		if(options.mips)
+		{
+			out.mips = MS<MipChain>();
+			out.mips->build(image.texels.data(), image.width, image.height, image.channels, options.srgb);
+			image.texels.clear();
+			image.texels.shrink_to_fit();
+			//Premultiplied after filtering, the chain already weights color by alpha
+			for(uint32_t level = 0; options.premultiply && image.channels == 4 && level < out.mips->levels.size(); level++)
+			{
+				premultiplyAlpha(out.mips->texels(level), static_cast<size_t>(out.mips->levels[level].width) * out.mips->levels[level].height);
+			}
+		}
+		else if(options.premultiply && image.channels == 4) premultiplyAlpha(image.texels.data(), static_cast<size_t>(image.width) * image.height);
+		out.failed = false;
+	}
+	
+	/// On the GL thread, make result drawable and swap it into handle
+	inline void upload(Decoded &result, ImageHandle &handle)
+	{
+		if(result.failed) handle.broken = true;
+		else
+		{
+			LoadedImage &image = handle.image;
+			image.width = result.image.width;
+			image.height = result.image.height;
+			image.uvRect = {0, 0, 1, 1};
+			image.mips = nullptr;
+			if(result.packed)
+			{
+				image.pixmap = this->atlas.insert(image.width, image.height, result.image.texels.data(), image.uvRect);
+			}
+			else if(result.mips)
+			{
+				uint32_t firstLevel = result.firstLevel();
+				image.pixmap = MS<Pixmap>(*result.mips, firstLevel);
+				if(firstLevel) image.mips = std::move(result.mips);
+			}
+			else
+			{
+				std::vector<unsigned char *> rows(image.height);
+				size_t rowBytes = static_cast<size_t>(image.width) * result.image.channels;
+				for(uint32_t row = 0; row < image.height; row++) rows[row] = &result.image.texels[row * rowBytes];
+				image.pixmap = MS<Pixmap>(rows.data(), image.width, image.height, result.image.channels == 4, result.options.srgb);
+			}
+			handle.loaded = true;
+		}
+		if(handle.onReady) handle.onReady(handle);
+	}
+	
+	SP<Pixmap> placeholder;
+	std::vector<Decoded> decoded;
+	std::deque<Decoded> waiting; //Decoded but over the upload budget, GL thread only
+	std::atomic<size_t> loading {0};
+	Spinlock decodedSL;
+	WorkerPool pool; //Declared last so workers are joined before anything they touch is destroyed
+};
@@ -8,7 +8,7 @@ namespace Iris
 	/// PI constant
 	template<typename T> T constexpr pi = static_cast<T>(3.141592653589793238462643383279502884197169399375105820974944592307816406286208998628034825342117067982148086513282306647093844609550582231725359408128481117450284102701938521105559644622948954930381964428810975665933446128475648233786783165271201909145649L);
 	
-	template<typename T> int sign(T in)
+	template<typename T> constexpr int sign(T in)
 	{
 		if (in < 0) return -1;
 		else return 1;
@@ -21,13 +21,13 @@ namespace Iris
 	}
 
 	/// Convert a degree angle into a radian angle
-	template<typename T> T degToRad(T degree)
+	template<typename T> constexpr T degToRad(T degree)
 	{
 		return degree * (pi<T> / static_cast<T>(180));
 	}
 
 	/// Convert a radian angle into a degree angle
-	template<typename T> T radToDeg(T radian)
+	template<typename T> constexpr T radToDeg(T radian)
 	{
 		return radian / (pi<T> / static_cast<T>(180));
 	}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <ctgmath>
+#include <cstring>
 
 namespace Iris
 {
@@ -43,31 +44,31 @@ namespace Iris
 		}
 		
 		/// Copy constructor
-		inline mat3x3<T>(mat3x3<T> const &other)
-		{
-			memcpy(&this->data[0][0], &other[0][0], sizeof(other.data));
-		}
+		inline constexpr mat3x3<T>(mat3x3<T> const &other) = default;
 		
 		/// Copy assignment operator
-		inline mat3x3<T> &operator=(mat4x4<T> const &other)
+		inline constexpr mat3x3<T> &operator=(mat3x3<T> const &other) = default;
+		
+		/// Take the upper left 3x3 of a 4x4 matrix
+		inline constexpr mat3x3<T> &operator=(mat4x4<T> const &other)
 		{
-			memcpy(&this->data[0][0], &other[0][0], sizeof(other.data));
+			*this = mat3x3<T>{other};
 			return *this;
 		}
 		
 		/// Subscript operators
-		inline T *operator[](size_t index)
+		inline constexpr T *operator[](size_t index)
 		{
 			return this->data[index];
 		}
 		
-		inline T const *operator[](size_t index) const
+		inline constexpr T const *operator[](size_t index) const
 		{
 			return this->data[index];
 		}
 		
 		/// Compare equality with another 3x3 matrix
-		inline bool operator==(mat3x3<T> const &other) const
+		inline constexpr bool operator==(mat3x3<T> const &other) const
 		{
 			return this->data[0][0] == other[0][0] && this->data[1][0] == other[1][0] && this->data[2][0] == other[2][0] &&
 			       this->data[0][1] == other[0][1] && this->data[1][1] == other[1][1] && this->data[2][1] == other[2][1] &&
@@ -75,7 +76,7 @@ namespace Iris
 		}
 		
 		/// Compare inequality with another 3x3 matrix
-		inline bool operator!=(mat3x3<T> const &other) const
+		inline constexpr bool operator!=(mat3x3<T> const &other) const
 		{
 			return this->data[0][0] != other[0][0] || this->data[1][0] != other[1][0] || this->data[2][0] != other[2][0] ||
 			       this->data[0][1] != other[0][1] || this->data[1][1] != other[1][1] || this->data[2][1] != other[2][1] ||
@@ -83,7 +84,7 @@ namespace Iris
 		}
 		
 		/// Multiply this 3x3 matrix by another
-		inline mat3x3<T> operator*(mat3x3<T> const &other) const
+		inline constexpr mat3x3<T> operator*(mat3x3<T> const &other) const
 		{
 			mat4x4<T> out;
 			out[0][0] = this->data[0][0] * other[0][0] + this->data[0][1] * other[1][0] + this->data[0][2] * other[2][0];
@@ -99,7 +100,7 @@ namespace Iris
 		}
 		
 		/// Get the determinant of this 3x3 matrix
-		inline T determinant() const
+		inline constexpr T determinant() const
 		{
 			return
 					this->data[0][0] * this->data[1][1] * this->data[2][2] -
@@ -111,7 +112,7 @@ namespace Iris
 		}
 		
 		/// Get a compound scaled 4x4 matrix from this matrix and a 3-dimensional vector
-		inline mat3x3<T> compoundScale(vec3<T> const &scaleVec) const
+		inline constexpr mat3x3<T> compoundScale(vec3<T> const &scaleVec) const
 		{
 			mat3x3<T> out;
 			out[0][0] = this->data[0][0] * scaleVec[0];
@@ -126,7 +127,7 @@ namespace Iris
 			return out;
 		}
 		
-		inline mat3x3<T> compoundScale(T const &scalar) const
+		inline constexpr mat3x3<T> compoundScale(T const &scalar) const
 		{
 			mat3x3<T> out;
 			out[0][0] = this->data[0][0] * scalar;
@@ -142,7 +143,7 @@ namespace Iris
 		}
 		
 		/// Get an inverted 3x3 matrix based on this one
-		inline mat3x3<T> invert() const
+		inline constexpr mat3x3<T> invert() const
 		{
 			mat3x3<T> out;
 			
@@ -160,7 +161,7 @@ namespace Iris
 		}
 		
 		/// Transpose this 3x3 matrix
-		inline mat3x3<T> transpose() const
+		inline constexpr mat3x3<T> transpose() const
 		{
 			mat3x3<T> out;
 			out[0][0] = this->data[0][0];
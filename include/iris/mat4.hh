@@ -2,8 +2,10 @@
 
 #include "vec3.hh"
 #include "general.hh"
+#include "simd.hh"
 
 #include <ctgmath>
+#include <cstring>
 
 namespace Iris
 {
@@ -89,27 +91,20 @@ namespace Iris
 		}
 		
 		/// Copy constructor
-		inline mat4x4<T>(mat4x4<T> const &other)
-		{
-			memcpy(&this->data[0][0], &other[0][0], sizeof(other.data));
-		}
+		inline constexpr mat4x4<T>(mat4x4<T> const &other) = default;
 		
 		/// Copy assignment operator
-		inline mat4x4<T> &operator=(mat4x4<T> const &other)
-		{
-			memcpy(&this->data[0][0], &other[0][0], sizeof(other.data));
-			return *this;
-		}
+		inline constexpr mat4x4<T> &operator=(mat4x4<T> const &other) = default;
 		
 		/// Subscript operators
-		inline T *operator[](size_t index)
+		inline constexpr T *operator[](size_t index)
 		{ return this->data[index]; }
 		
-		inline T const *operator[](size_t index) const
+		inline constexpr T const *operator[](size_t index) const
 		{ return this->data[index]; }
 		
 		/// Compare equality with another mat4x4
-		inline bool operator==(mat4x4<T> const &other) const
+		inline constexpr bool operator==(mat4x4<T> const &other) const
 		{
 			return this->data[0][0] == other[0][0] && this->data[1][0] == other[1][0] && this->data[2][0] == other[2][0] && this->data[3][0] == other[3][0] &&
 			       this->data[0][1] == other[0][1] && this->data[1][1] == other[1][1] && this->data[2][1] == other[2][1] && this->data[3][1] == other[3][1] &&
@@ -118,7 +113,7 @@ namespace Iris
 		}
 		
 		/// Compare inequality with another mat4x4
-		inline bool operator!=(mat4x4<T> const &other) const
+		inline constexpr bool operator!=(mat4x4<T> const &other) const
 		{
 			return this->data[0][0] != other[0][0] || this->data[1][0] != other[1][0] || this->data[2][0] != other[2][0] || this->data[3][0] != other[3][0] ||
 			       this->data[0][1] != other[0][1] || this->data[1][1] != other[1][1] || this->data[2][1] != other[2][1] || this->data[3][1] != other[3][1] ||
@@ -127,9 +122,14 @@ namespace Iris
 		}
 		
 		/// Multiply this 4x4 matrix by another
-		inline mat4x4<T> operator*(mat4x4<T> const &other) const
+		inline constexpr mat4x4<T> operator*(mat4x4<T> const &other) const
 		{
 			mat4x4<T> out;
+			if constexpr(std::is_same_v<T, float> && simd::enabled) if(!simd::constantEvaluated())
+			{
+				simd::mat4Multiply<simd::Native>(&this->data[0][0], &other.data[0][0], &out.data[0][0]);
+				return out;
+			}
 			out[0][0] = this->data[0][0] * other[0][0] + this->data[0][1] * other[1][0] + this->data[0][2] * other[2][0] + this->data[0][3] * other[3][0];
 			out[0][1] = this->data[0][0] * other[0][1] + this->data[0][1] * other[1][1] + this->data[0][2] * other[2][1] + this->data[0][3] * other[3][1];
 			out[0][2] = this->data[0][0] * other[0][2] + this->data[0][1] * other[1][2] + this->data[0][2] * other[2][2] + this->data[0][3] * other[3][2];
@@ -149,8 +149,14 @@ namespace Iris
 			return out;
 		}
 		
-		inline vec4<T> operator*(vec4<T> const &vec)
+		inline constexpr vec4<T> operator*(vec4<T> const &vec) const
 		{
+			if constexpr(std::is_same_v<T, float> && simd::enabled) if(!simd::constantEvaluated())
+			{
+				vec4<T> out;
+				simd::vec4Transform<simd::Native>(&this->data[0][0], vec.data, out.data, 1);
+				return out;
+			}
 			return vec4<T>{
 					vec[0] * this->data[0][0] + vec[1] * this->data[1][0] + vec[2] * this->data[2][0] + vec[3] * this->data[3][0],
 					vec[0] * this->data[0][1] + vec[1] * this->data[1][1] + vec[2] * this->data[2][1] + vec[3] * this->data[3][1],
@@ -159,8 +165,37 @@ namespace Iris
 			};
 		}
 		
+		/// Transform count vec4s like operator*, in and out may be the same array
+		inline void transform(vec4<T> const *in, vec4<T> *out, size_t count) const
+		{
+			if constexpr(std::is_same_v<T, float> && simd::enabled)
+			{
+				static_assert(sizeof(vec4<T>) == sizeof(T) * 4, "vec4 must be tightly packed");
+				simd::vec4Transform<simd::Native>(&this->data[0][0], in[0].data, out[0].data, count);
+				return;
+			}
+			for(size_t i = 0; i < count; i++) out[i] = *this * in[i];
+		}
+		
+		/// Transform count 2D points as vec4(x, y, 0, 1) keeping x and y, for affine matrices like the UI's, in and out may be the same array
+		inline void transform(vec2<T> const *in, vec2<T> *out, size_t count) const
+		{
+			if constexpr(std::is_same_v<T, float>)
+			{
+				static_assert(sizeof(vec2<T>) == sizeof(T) * 2, "vec2 must be tightly packed");
+				simd::vec2Transform<simd::Native>(&this->data[0][0], in[0].data, out[0].data, count);
+				return;
+			}
+			for(size_t i = 0; i < count; i++)
+			{
+				T x = in[i][0], y = in[i][1];
+				out[i][0] = x * this->data[0][0] + y * this->data[1][0] + this->data[3][0];
+				out[i][1] = x * this->data[0][1] + y * this->data[1][1] + this->data[3][1];
+			}
+		}
+		
 		/// Get the determinant of this 4x4 matrix
-		inline T determinant() const
+		inline constexpr T determinant() const
 		{
 			return
 					this->data[0][3] * this->data[1][2] * this->data[2][1] * this->data[3][0] - this->data[0][2] * this->data[1][3] * this->data[2][1] * this->data[3][0] - this->data[0][3] * this->data[1][1] * this->data[2][2] * this->data[3][0] + this->data[0][1] * this->data[1][3] * this->data[2][2] * this->data[3][0] +
@@ -171,7 +206,7 @@ namespace Iris
 					this->data[0][2] * this->data[1][0] * this->data[2][1] * this->data[3][3] - this->data[0][0] * this->data[1][2] * this->data[2][1] * this->data[3][3] - this->data[0][1] * this->data[1][0] * this->data[2][2] * this->data[3][3] + this->data[0][0] * this->data[1][1] * this->data[2][2] * this->data[3][3];
 		}
 		
-		inline static mat4x4<T> translateMat(vec3<T> const &in)
+		inline constexpr static mat4x4<T> translateMat(vec3<T> const &in)
 		{
 			mat4x4<T> out{};
 			out[3][0] = in[0];
@@ -180,13 +215,13 @@ namespace Iris
 			return out;
 		}
 		
-		inline static mat4x4<T> rotateMat(quat<T> const &in)
+		inline constexpr static mat4x4<T> rotateMat(quat<T> const &in)
 		{
 			return mat4x4<T>{in};
 		}
 		
 		/// Convert a vec3 scale into a mat4x4 representation
-		inline static mat4x4<T> scaleMat(vec3<T> const &scale)
+		inline constexpr static mat4x4<T> scaleMat(vec3<T> const &scale)
 		{
 			mat4x4<T> out{};
 			out[0][0] = scale[0];
@@ -195,7 +230,7 @@ namespace Iris
 			return out;
 		}
 		
-		inline static mat4x4<T> scaleMat(T scalar)
+		inline constexpr static mat4x4<T> scaleMat(T scalar)
 		{
 			mat4x4<T> out;
 			out[0][0] = scalar;
@@ -204,56 +239,58 @@ namespace Iris
 			return out;
 		}
 		
-		/// Invert this mat4x4
-		inline void invert()
+		/// Invert this mat4x4, a singular matrix becomes identity
+		inline constexpr void invert()
 		{
-			this->data[0][0] = this->data[1][2] * this->data[2][3] * this->data[3][1] - this->data[1][3] * this->data[2][2] * this->data[3][1] + this->data[1][3] * this->data[2][1] * this->data[3][2] - this->data[1][1] * this->data[2][3] * this->data[3][2] - this->data[1][2] * this->data[2][1] * this->data[3][3] + this->data[1][1] * this->data[2][2] * this->data[3][3];
-			this->data[0][1] = this->data[0][3] * this->data[2][2] * this->data[3][1] - this->data[0][2] * this->data[2][3] * this->data[3][1] - this->data[0][3] * this->data[2][1] * this->data[3][2] + this->data[0][1] * this->data[2][3] * this->data[3][2] + this->data[0][2] * this->data[2][1] * this->data[3][3] - this->data[0][1] * this->data[2][2] * this->data[3][3];
-			this->data[0][2] = this->data[0][2] * this->data[1][3] * this->data[3][1] - this->data[0][3] * this->data[1][2] * this->data[3][1] + this->data[0][3] * this->data[1][1] * this->data[3][2] - this->data[0][1] * this->data[1][3] * this->data[3][2] - this->data[0][2] * this->data[1][1] * this->data[3][3] + this->data[0][1] * this->data[1][2] * this->data[3][3];
-			this->data[0][3] = this->data[0][3] * this->data[1][2] * this->data[2][1] - this->data[0][2] * this->data[1][3] * this->data[2][1] - this->data[0][3] * this->data[1][1] * this->data[2][2] + this->data[0][1] * this->data[1][3] * this->data[2][2] + this->data[0][2] * this->data[1][1] * this->data[2][3] - this->data[0][1] * this->data[1][2] * this->data[2][3];
-			this->data[1][0] = this->data[1][3] * this->data[2][2] * this->data[3][0] - this->data[1][2] * this->data[2][3] * this->data[3][0] - this->data[1][3] * this->data[2][0] * this->data[3][2] + this->data[1][0] * this->data[2][3] * this->data[3][2] + this->data[1][2] * this->data[2][0] * this->data[3][3] - this->data[1][0] * this->data[2][2] * this->data[3][3];
-			this->data[1][1] = this->data[0][2] * this->data[2][3] * this->data[3][0] - this->data[0][3] * this->data[2][2] * this->data[3][0] + this->data[0][3] * this->data[2][0] * this->data[3][2] - this->data[0][0] * this->data[2][3] * this->data[3][2] - this->data[0][2] * this->data[2][0] * this->data[3][3] + this->data[0][0] * this->data[2][2] * this->data[3][3];
-			this->data[1][2] = this->data[0][3] * this->data[1][2] * this->data[3][0] - this->data[0][2] * this->data[1][3] * this->data[3][0] - this->data[0][3] * this->data[1][0] * this->data[3][2] + this->data[0][0] * this->data[1][3] * this->data[3][2] + this->data[0][2] * this->data[1][0] * this->data[3][3] - this->data[0][0] * this->data[1][2] * this->data[3][3];
-			this->data[1][3] = this->data[0][2] * this->data[1][3] * this->data[2][0] - this->data[0][3] * this->data[1][2] * this->data[2][0] + this->data[0][3] * this->data[1][0] * this->data[2][2] - this->data[0][0] * this->data[1][3] * this->data[2][2] - this->data[0][2] * this->data[1][0] * this->data[2][3] + this->data[0][0] * this->data[1][2] * this->data[2][3];
-			this->data[2][0] = this->data[1][1] * this->data[2][3] * this->data[3][0] - this->data[1][3] * this->data[2][1] * this->data[3][0] + this->data[1][3] * this->data[2][0] * this->data[3][1] - this->data[1][0] * this->data[2][3] * this->data[3][1] - this->data[1][1] * this->data[2][0] * this->data[3][3] + this->data[1][0] * this->data[2][1] * this->data[3][3];
-			this->data[2][1] = this->data[0][3] * this->data[2][1] * this->data[3][0] - this->data[0][1] * this->data[2][3] * this->data[3][0] - this->data[0][3] * this->data[2][0] * this->data[3][1] + this->data[0][0] * this->data[2][3] * this->data[3][1] + this->data[0][1] * this->data[2][0] * this->data[3][3] - this->data[0][0] * this->data[2][1] * this->data[3][3];
-			this->data[2][2] = this->data[0][1] * this->data[1][3] * this->data[3][0] - this->data[0][3] * this->data[1][1] * this->data[3][0] + this->data[0][3] * this->data[1][0] * this->data[3][1] - this->data[0][0] * this->data[1][3] * this->data[3][1] - this->data[0][1] * this->data[1][0] * this->data[3][3] + this->data[0][0] * this->data[1][1] * this->data[3][3];
-			this->data[2][3] = this->data[0][3] * this->data[1][1] * this->data[2][0] - this->data[0][1] * this->data[1][3] * this->data[2][0] - this->data[0][3] * this->data[1][0] * this->data[2][1] + this->data[0][0] * this->data[1][3] * this->data[2][1] + this->data[0][1] * this->data[1][0] * this->data[2][3] - this->data[0][0] * this->data[1][1] * this->data[2][3];
-			this->data[3][0] = this->data[1][2] * this->data[2][1] * this->data[3][0] - this->data[1][1] * this->data[2][2] * this->data[3][0] - this->data[1][2] * this->data[2][0] * this->data[3][1] + this->data[1][0] * this->data[2][2] * this->data[3][1] + this->data[1][1] * this->data[2][0] * this->data[3][2] - this->data[1][0] * this->data[2][1] * this->data[3][2];
-			this->data[3][1] = this->data[0][1] * this->data[2][2] * this->data[3][0] - this->data[0][2] * this->data[2][1] * this->data[3][0] + this->data[0][2] * this->data[2][0] * this->data[3][1] - this->data[0][0] * this->data[2][2] * this->data[3][1] - this->data[0][1] * this->data[2][0] * this->data[3][2] + this->data[0][0] * this->data[2][1] * this->data[3][2];
-			this->data[3][2] = this->data[0][2] * this->data[1][1] * this->data[3][0] - this->data[0][1] * this->data[1][2] * this->data[3][0] - this->data[0][2] * this->data[1][0] * this->data[3][1] + this->data[0][0] * this->data[1][2] * this->data[3][1] + this->data[0][1] * this->data[1][0] * this->data[3][2] - this->data[0][0] * this->data[1][1] * this->data[3][2];
-			this->data[3][3] = this->data[0][1] * this->data[1][2] * this->data[2][0] - this->data[0][2] * this->data[1][1] * this->data[2][0] + this->data[0][2] * this->data[1][0] * this->data[2][1] - this->data[0][0] * this->data[1][2] * this->data[2][1] - this->data[0][1] * this->data[1][0] * this->data[2][2] + this->data[0][0] * this->data[1][1] * this->data[2][2];
-			*this = *this * scaleMat(vec3<T>{1 / this->determinant()});
+			*this = this->inverse();
 		}
 		
-		/// Get a new inverted mat4x4 from this one
-		inline mat4x4<T> inverse() const
+		/// Get a new inverted mat4x4 from this one, identity if this one is singular
+		inline constexpr mat4x4<T> inverse() const
 		{
 			mat4x4<T> out;
-			out[0][0] = this->data[1][2] * this->data[2][3] * this->data[3][1] - this->data[1][3] * this->data[2][2] * this->data[3][1] + this->data[1][3] * this->data[2][1] * this->data[3][2] - this->data[1][1] * this->data[2][3] * this->data[3][2] - this->data[1][2] * this->data[2][1] * this->data[3][3] + this->data[1][1] * this->data[2][2] * this->data[3][3];
-			out[0][1] = this->data[0][3] * this->data[2][2] * this->data[3][1] - this->data[0][2] * this->data[2][3] * this->data[3][1] - this->data[0][3] * this->data[2][1] * this->data[3][2] + this->data[0][1] * this->data[2][3] * this->data[3][2] + this->data[0][2] * this->data[2][1] * this->data[3][3] - this->data[0][1] * this->data[2][2] * this->data[3][3];
-			out[0][2] = this->data[0][2] * this->data[1][3] * this->data[3][1] - this->data[0][3] * this->data[1][2] * this->data[3][1] + this->data[0][3] * this->data[1][1] * this->data[3][2] - this->data[0][1] * this->data[1][3] * this->data[3][2] - this->data[0][2] * this->data[1][1] * this->data[3][3] + this->data[0][1] * this->data[1][2] * this->data[3][3];
-			out[0][3] = this->data[0][3] * this->data[1][2] * this->data[2][1] - this->data[0][2] * this->data[1][3] * this->data[2][1] - this->data[0][3] * this->data[1][1] * this->data[2][2] + this->data[0][1] * this->data[1][3] * this->data[2][2] + this->data[0][2] * this->data[1][1] * this->data[2][3] - this->data[0][1] * this->data[1][2] * this->data[2][3];
-			out[1][0] = this->data[1][3] * this->data[2][2] * this->data[3][0] - this->data[1][2] * this->data[2][3] * this->data[3][0] - this->data[1][3] * this->data[2][0] * this->data[3][2] + this->data[1][0] * this->data[2][3] * this->data[3][2] + this->data[1][2] * this->data[2][0] * this->data[3][3] - this->data[1][0] * this->data[2][2] * this->data[3][3];
-			out[1][1] = this->data[0][2] * this->data[2][3] * this->data[3][0] - this->data[0][3] * this->data[2][2] * this->data[3][0] + this->data[0][3] * this->data[2][0] * this->data[3][2] - this->data[0][0] * this->data[2][3] * this->data[3][2] - this->data[0][2] * this->data[2][0] * this->data[3][3] + this->data[0][0] * this->data[2][2] * this->data[3][3];
-			out[1][2] = this->data[0][3] * this->data[1][2] * this->data[3][0] - this->data[0][2] * this->data[1][3] * this->data[3][0] - this->data[0][3] * this->data[1][0] * this->data[3][2] + this->data[0][0] * this->data[1][3] * this->data[3][2] + this->data[0][2] * this->data[1][0] * this->data[3][3] - this->data[0][0] * this->data[1][2] * this->data[3][3];
-			out[1][3] = this->data[0][2] * this->data[1][3] * this->data[2][0] - this->data[0][3] * this->data[1][2] * this->data[2][0] + this->data[0][3] * this->data[1][0] * this->data[2][2] - this->data[0][0] * this->data[1][3] * this->data[2][2] - this->data[0][2] * this->data[1][0] * this->data[2][3] + this->data[0][0] * this->data[1][2] * this->data[2][3];
-			out[2][0] = this->data[1][1] * this->data[2][3] * this->data[3][0] - this->data[1][3] * this->data[2][1] * this->data[3][0] + this->data[1][3] * this->data[2][0] * this->data[3][1] - this->data[1][0] * this->data[2][3] * this->data[3][1] - this->data[1][1] * this->data[2][0] * this->data[3][3] + this->data[1][0] * this->data[2][1] * this->data[3][3];
-			out[2][1] = this->data[0][3] * this->data[2][1] * this->data[3][0] - this->data[0][1] * this->data[2][3] * this->data[3][0] - this->data[0][3] * this->data[2][0] * this->data[3][1] + this->data[0][0] * this->data[2][3] * this->data[3][1] + this->data[0][1] * this->data[2][0] * this->data[3][3] - this->data[0][0] * this->data[2][1] * this->data[3][3];
-			out[2][2] = this->data[0][1] * this->data[1][3] * this->data[3][0] - this->data[0][3] * this->data[1][1] * this->data[3][0] + this->data[0][3] * this->data[1][0] * this->data[3][1] - this->data[0][0] * this->data[1][3] * this->data[3][1] - this->data[0][1] * this->data[1][0] * this->data[3][3] + this->data[0][0] * this->data[1][1] * this->data[3][3];
-			out[2][3] = this->data[0][3] * this->data[1][1] * this->data[2][0] - this->data[0][1] * this->data[1][3] * this->data[2][0] - this->data[0][3] * this->data[1][0] * this->data[2][1] + this->data[0][0] * this->data[1][3] * this->data[2][1] + this->data[0][1] * this->data[1][0] * this->data[2][3] - this->data[0][0] * this->data[1][1] * this->data[2][3];
-			out[3][0] = this->data[1][2] * this->data[2][1] * this->data[3][0] - this->data[1][1] * this->data[2][2] * this->data[3][0] - this->data[1][2] * this->data[2][0] * this->data[3][1] + this->data[1][0] * this->data[2][2] * this->data[3][1] + this->data[1][1] * this->data[2][0] * this->data[3][2] - this->data[1][0] * this->data[2][1] * this->data[3][2];
-			out[3][1] = this->data[0][1] * this->data[2][2] * this->data[3][0] - this->data[0][2] * this->data[2][1] * this->data[3][0] + this->data[0][2] * this->data[2][0] * this->data[3][1] - this->data[0][0] * this->data[2][2] * this->data[3][1] - this->data[0][1] * this->data[2][0] * this->data[3][2] + this->data[0][0] * this->data[2][1] * this->data[3][2];
-			out[3][2] = this->data[0][2] * this->data[1][1] * this->data[3][0] - this->data[0][1] * this->data[1][2] * this->data[3][0] - this->data[0][2] * this->data[1][0] * this->data[3][1] + this->data[0][0] * this->data[1][2] * this->data[3][1] + this->data[0][1] * this->data[1][0] * this->data[3][2] - this->data[0][0] * this->data[1][1] * this->data[3][2];
-			out[3][3] = this->data[0][1] * this->data[1][2] * this->data[2][0] - this->data[0][2] * this->data[1][1] * this->data[2][0] + this->data[0][2] * this->data[1][0] * this->data[2][1] - this->data[0][0] * this->data[1][2] * this->data[2][1] - this->data[0][1] * this->data[1][0] * this->data[2][2] + this->data[0][0] * this->data[1][1] * this->data[2][2];
-			out = out * scaleMat(vec3<T>{1 / out.determinant()});
+			if constexpr(std::is_same_v<T, float> && simd::enabled) if(!simd::constantEvaluated())
+			{
+				simd::mat4Inverse<simd::Native>(&this->data[0][0], &out.data[0][0]);
+				return out;
+			}
+			T const (&a)[4][4] = this->data;
+			//2x2 determinants of the top and bottom row pairs
+			T s0 = a[0][0] * a[1][1] - a[1][0] * a[0][1], s1 = a[0][0] * a[1][2] - a[1][0] * a[0][2], s2 = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+			T s3 = a[0][1] * a[1][2] - a[1][1] * a[0][2], s4 = a[0][1] * a[1][3] - a[1][1] * a[0][3], s5 = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+			T c0 = a[2][0] * a[3][1] - a[3][0] * a[2][1], c1 = a[2][0] * a[3][2] - a[3][0] * a[2][2], c2 = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+			T c3 = a[2][1] * a[3][2] - a[3][1] * a[2][2], c4 = a[2][1] * a[3][3] - a[3][1] * a[2][3], c5 = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+			T det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+			if(det == 0) return out;
+			T invDet = static_cast<T>(1) / det;
+			out[0][0] = (a[1][1] * c5 - a[1][2] * c4 + a[1][3] * c3) * invDet;
+			out[0][1] = (-a[0][1] * c5 + a[0][2] * c4 - a[0][3] * c3) * invDet;
+			out[0][2] = (a[3][1] * s5 - a[3][2] * s4 + a[3][3] * s3) * invDet;
+			out[0][3] = (-a[2][1] * s5 + a[2][2] * s4 - a[2][3] * s3) * invDet;
+			out[1][0] = (-a[1][0] * c5 + a[1][2] * c2 - a[1][3] * c1) * invDet;
+			out[1][1] = (a[0][0] * c5 - a[0][2] * c2 + a[0][3] * c1) * invDet;
+			out[1][2] = (-a[3][0] * s5 + a[3][2] * s2 - a[3][3] * s1) * invDet;
+			out[1][3] = (a[2][0] * s5 - a[2][2] * s2 + a[2][3] * s1) * invDet;
+			out[2][0] = (a[1][0] * c4 - a[1][1] * c2 + a[1][3] * c0) * invDet;
+			out[2][1] = (-a[0][0] * c4 + a[0][1] * c2 - a[0][3] * c0) * invDet;
+			out[2][2] = (a[3][0] * s4 - a[3][1] * s2 + a[3][3] * s0) * invDet;
+			out[2][3] = (-a[2][0] * s4 + a[2][1] * s2 - a[2][3] * s0) * invDet;
+			out[3][0] = (-a[1][0] * c3 + a[1][1] * c1 - a[1][2] * c0) * invDet;
+			out[3][1] = (a[0][0] * c3 - a[0][1] * c1 + a[0][2] * c0) * invDet;
+			out[3][2] = (-a[3][0] * s3 + a[3][1] * s1 - a[3][2] * s0) * invDet;
+			out[3][3] = (a[2][0] * s3 - a[2][1] * s1 + a[2][2] * s0) * invDet;
 			return out;
 		}
 		
 		/// Transpose this 4x4 matrix
-		inline mat4x4<T> transpose() const
+		inline constexpr mat4x4<T> transpose() const
 		{
 			mat4x4<T> out;
+			if constexpr(std::is_same_v<T, float> && simd::enabled) if(!simd::constantEvaluated())
+			{
+				simd::mat4Transpose<simd::Native>(&this->data[0][0], &out.data[0][0]);
+				return out;
+			}
 			out[0][0] = this->data[0][0];
 			out[0][1] = this->data[1][0];
 			out[0][2] = this->data[2][0];
@@ -273,7 +310,7 @@ namespace Iris
 			return out;
 		}
 		
-		inline static mat4x4<T> modelMatrix(vec3<T> const &position, quat<T> const &rotation, vec3<T> const &scale)
+		inline constexpr static mat4x4<T> modelMatrix(vec3<T> const &position, quat<T> const &rotation, vec3<T> const &scale)
 		{
 			mat4x4<T> t = translateMat(position);
 			mat4x4<T> r = rotateMat(rotation);
@@ -281,7 +318,7 @@ namespace Iris
 			return s * r * t;
 		}
 		
-		inline static mat4x4<T> modelMatrixText(vec3<T> const &position, quat<T> const &rotation, vec3<T> const &scale)
+		inline constexpr static mat4x4<T> modelMatrixText(vec3<T> const &position, quat<T> const &rotation, vec3<T> const &scale)
 		{
 			mat4x4<T> t = translateMat(position);
 			mat4x4<T> r = rotateMat(rotation);
@@ -289,7 +326,7 @@ namespace Iris
 			return s * t * r;
 		}
 		
-		inline static mat4x4<T> modelMatrix(vec3<T> const &position, vec3<T> const &origin, quat<T> const &rotation, vec3<T> const &scale)
+		inline constexpr static mat4x4<T> modelMatrix(vec3<T> const &position, vec3<T> const &origin, quat<T> const &rotation, vec3<T> const &scale)
 		{
 			mat4x4<T> tOffset = translateMat(origin);
 			mat4x4<T> r = rotateMat(rotation);
@@ -318,7 +355,7 @@ namespace Iris
 			return out;
 		}
 		
-		inline static mat4x4<T> orthoProjectionMatrix(T left, T right, T top, T bottom, T zNear, T zFar)
+		inline constexpr static mat4x4<T> orthoProjectionMatrix(T left, T right, T top, T bottom, T zNear, T zFar)
 		{
 			mat4x4<T> out{};
 			out[0][0] = static_cast<T>(2) / (right - left);
@@ -330,7 +367,7 @@ namespace Iris
 			return out;
 		}
 		
-		inline static mat4x4<T> modelViewProjectionMatrix(mat4x4<T> const &model, mat4x4<T> const &view, mat4x4<T> const &projection)
+		inline constexpr static mat4x4<T> modelViewProjectionMatrix(mat4x4<T> const &model, mat4x4<T> const &view, mat4x4<T> const &projection)
 		{
 			return model * view * projection;
 		}
@@ -3,6 +3,8 @@
 #include "vec4.hh"
 #include "general.hh"
 
+#include <cstring>
+
 namespace Iris
 {
 	template<typename T> struct mat4x4;
@@ -13,42 +15,42 @@ namespace Iris
 		T data[4]{0, 0, 0, 1};
 		
 		/// Get a reference to one of the contained values
-		inline T &x()
+		inline constexpr T &x()
 		{
 			return this->data[0];
 		}
 		
-		inline T &y()
+		inline constexpr T &y()
 		{
 			return this->data[1];
 		}
 		
-		inline T &z()
+		inline constexpr T &z()
 		{
 			return this->data[2];
 		}
 		
-		inline T &w()
+		inline constexpr T &w()
 		{
 			return this->data[3];
 		}
 		
-		inline T const &x() const
+		inline constexpr T const &x() const
 		{
 			return this->data[0];
 		}
 		
-		inline T const &y() const
+		inline constexpr T const &y() const
 		{
 			return this->data[1];
 		}
 		
-		inline T const &z() const
+		inline constexpr T const &z() const
 		{
 			return this->data[2];
 		}
 		
-		inline T const &w() const
+		inline constexpr T const &w() const
 		{
 			return this->data[3];
 		}
@@ -103,37 +105,30 @@ namespace Iris
 		}
 		
 		/// Copy constructor
-		inline quat<T>(quat<T> const &other)
-		{
-			memcpy(&this->data[0], &other.data[0], sizeof(other.data));
-		}
+		inline constexpr quat<T>(quat<T> const &other) = default;
 		
 		/// Copy assignment operator
-		inline quat<T> &operator=(quat<T> const &other)
-		{
-			memcpy(&this->data[0], &other.data[0], sizeof(other.data));
-			return *this;
-		}
+		inline constexpr quat<T> &operator=(quat<T> const &other) = default;
 		
 		/// Subscript operators
-		inline T &operator[](size_t index)
+		inline constexpr T &operator[](size_t index)
 		{
 			return this->data[index];
 		}
 		
-		inline T const &operator[](size_t index) const
+		inline constexpr T const &operator[](size_t index) const
 		{
 			return this->data[index];
 		}
 		
 		/// Compare equality of two quaternions
-		inline bool operator==(quat<T> const &other) const
+		inline constexpr bool operator==(quat<T> const &other) const
 		{
 			return this->data[0] == other[0] && this->data[1] == other[1] && this->data[2] == other[2] && this->data[3] == other[3];
 		}
 		
 		/// Compare inequality of two quaternions
-		inline bool operator!=(quat<T> const &other) const
+		inline constexpr bool operator!=(quat<T> const &other) const
 		{
 			return this->data[0] != other[0] || this->data[1] != other[1] || this->data[2] != other[2] || this->data[3] != other[3];
 		}
@@ -149,7 +144,7 @@ namespace Iris
 		}
 		
 		/// Multiply this quaternion by a 3-dimensional vector
-		inline vec3<T> operator*(vec3<T> const &other) const
+		inline constexpr vec3<T> operator*(vec3<T> const &other) const
 		{
 			vec3<T> q = {this->data[0], this->data[1], this->data[2]};
 			vec3<T> c = other.cross(q);
@@ -165,7 +160,7 @@ namespace Iris
 		}
 		
 		/// Conjugate this quaternion
-		inline void conjugate()
+		inline constexpr void conjugate()
 		{
 			this->data[0] = -this->data[0];
 			this->data[1] = -this->data[1];
@@ -173,7 +168,7 @@ namespace Iris
 		}
 		
 		/// Get a new conjugated quaternion
-		inline quat<T> conjugated() const
+		inline constexpr quat<T> conjugated() const
 		{
 			return quat<T>{-this->data[0], -this->data[1], -this->data[2], this->data[3]};
 		}
@@ -202,7 +197,7 @@ namespace Iris
 		}
 		
 		/// Get the dot product of this and another quaternion
-		inline T dot(quat<T> const &other) const
+		inline constexpr T dot(quat<T> const &other) const
 		{
 			return this->data[3] * other[3] + this->data[0] * other[0] + this->data[1] * other[1] + this->data[2] * other[2];
 		}
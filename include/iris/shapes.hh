@@ -14,7 +14,7 @@ namespace Iris
 		inline constexpr linesegment2D(vec2<T> const &p1, vec2<T> const &p2) : point1(p1), point2(p2) {}
 		
 		/// Reconstruct this line segment
-		inline void construct(vec2<T> const &p1, vec2<T> const &p2)
+		inline constexpr void construct(vec2<T> const &p1, vec2<T> const &p2)
 		{
 			this->point1 = p1;
 			this->point2 = p2;
@@ -72,7 +72,7 @@ namespace Iris
 		}
 		
 		/// Reconstruct this AABB
-		inline void construct(T minX, T maxX, T minY, T maxY)
+		inline constexpr void construct(T minX, T maxX, T minY, T maxY)
 		{
 			this->minX = minX;
 			this->maxX = maxX;
@@ -82,7 +82,7 @@ namespace Iris
 			this->centerY = (maxY - minY) / static_cast<T>(2.0);
 		}
 		
-		inline void offset(T xOffset, T yOffset)
+		inline constexpr void offset(T xOffset, T yOffset)
 		{
 			this->minX += xOffset;
 			this->maxX += xOffset;
@@ -93,13 +93,13 @@ namespace Iris
 		}
 		
 		/// Check if this AABB contains a given point
-		inline bool containsPoint(T x, T y)
+		inline constexpr bool containsPoint(T x, T y) const
 		{
 			return x > this->minX && x < this->maxX && y > this->minY && y < this->maxY;
 		}
 		
 		/// AABB-aabb collision
-		inline bool isIntersecting(aabb2D<T> const &other)
+		inline constexpr bool isIntersecting(aabb2D<T> const &other) const
 		{
 			return (this->minX < other.maxX) != (this->maxX < other.minX) && (this->minY < other.maxY) != (this->maxY < other.minY);
 		}
@@ -121,12 +121,12 @@ namespace Iris
 		}
 		
 		/// Predict an intersection with another AABB
-		inline bool predictIntersection(T xOffset, T yOffset, aabb2D<T> const &other)
+		inline constexpr bool predictIntersection(T xOffset, T yOffset, aabb2D<T> const &other) const
 		{
 			return (this->minX + xOffset < other.maxX) != (this->maxX + xOffset < other.minX) && (this->minY + yOffset < other.maxY) != (this->maxY + yOffset < other.minY);
 		}
 		
-		T minX, minY, maxX, maxY, centerX, centerY;
+		T minX {}, minY {}, maxX {}, maxY {}, centerX {}, centerY {};
 	};
 
 	/// 3-dimensional axis aligned bounding box
@@ -134,11 +134,11 @@ namespace Iris
 	{
 		inline constexpr aabb3D() = default;
 		
-		inline constexpr aabb3D(T minX, T maxX, T minY, T maxY, T minZ, T maxZ) : minX(minX), maxX(maxX), minY(minY), maxY(maxY), minZ(minZ), maxZ(maxZ)
+		inline constexpr aabb3D(T minX, T maxX, T minY, T maxY, T minZ, T maxZ) : minX(minX), minY(minY), minZ(minZ), maxX(maxX), maxY(maxY), maxZ(maxZ)
 		{}
 		
 		/// Construct/reconstruct this AABB
-		inline void construct(T minX, T maxX, T minY, T maxY, T minZ, T maxZ)
+		inline constexpr void construct(T minX, T maxX, T minY, T maxY, T minZ, T maxZ)
 		{
 			this->minX = minX;
 			this->maxX = maxX;
@@ -152,24 +152,24 @@ namespace Iris
 		}
 		
 		/// Check if this AABB contains a given point
-		inline bool containsPoint(T x, T y, T z)
+		inline constexpr bool containsPoint(T x, T y, T z) const
 		{
 			return x > this->minX && x < this->maxX && y > this->minY && y < this->maxY && z > this->minZ && z < this->maxZ;
 		}
 		
 		/// Check if this AABB is intersecting with another
-		inline bool isIntersecting(aabb3D<T> const &other)
+		inline constexpr bool isIntersecting(aabb3D<T> const &other) const
 		{
 			return (this->minX < other.maxX) != (this->maxX < other.minX) && (this->minY < other.maxY) != (this->maxY < other.minY) && (this->minZ < other.maxZ) != (this->maxZ < other.minZ);
 		}
 		
 		/// Predict an intersection with another AABB
-		inline bool predictIntersection(T xOffset, T yOffset, T zOffset, aabb3D<T> const &other)
+		inline constexpr bool predictIntersection(T xOffset, T yOffset, T zOffset, aabb3D<T> const &other) const
 		{
 			return (this->minX + xOffset < other.maxX) != (this->maxX + xOffset < other.minX) && (this->minY + yOffset < other.maxY) != (this->maxY + yOffset < other.minY) && (this->minZ + zOffset < other.maxZ) != (this->maxZ + zOffset < other.minZ);
 		}
 		
-		T minX, minY, minZ, maxX, maxY, maxZ, centerX, centerY, centerZ;
+		T minX {}, minY {}, minZ {}, maxX {}, maxY {}, maxZ {}, centerX {}, centerY {}, centerZ {};
 	};
 	
 	/// A mathematical circle
@@ -184,7 +184,7 @@ namespace Iris
 		}
 		
 		/// Reconstruct this circle
-		inline void construct(vec2<T> const &center, T radius)
+		inline constexpr void construct(vec2<T> const &center, T radius)
 		{
 			this->center = center, this->radius = radius;
 		}
@@ -256,7 +256,7 @@ namespace Iris
 		}
 		
 		vec2<T> center;
-		T radius;
+		T radius {};
 	};
 	
 	template<typename T> struct capsule //TODO finish
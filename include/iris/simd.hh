@@ -0,0 +1,252 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if !defined(IRIS_NO_SIMD) && (defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+#define IRIS_SIMD_SSE
+#include <immintrin.h>
+#elif !defined(IRIS_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define IRIS_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+/// 4 wide float kernels for mat4x4<float> and vec4<float>, written once against a backend.
+/// Each backend provides the same static functions on its f32x4 type, Native is the best one this target was compiled for.
+/// Define IRIS_NO_SIMD to force the scalar backend everywhere
+namespace Iris
+{
+	namespace simd
+	{
+		/// Plain C++, always available and the reference the others are checked against
+		struct Scalar
+		{
+			struct f32x4
+			{
+				float v[4];
+			};
+			
+			inline static f32x4 load(float const *in) { return {{in[0], in[1], in[2], in[3]}}; }
+			inline static void store(float *out, f32x4 const &in) { out[0] = in.v[0]; out[1] = in.v[1]; out[2] = in.v[2]; out[3] = in.v[3]; }
+			inline static f32x4 set(float x, float y, float z, float w) { return {{x, y, z, w}}; }
+			inline static f32x4 set1(float in) { return {{in, in, in, in}}; }
+			inline static f32x4 add(f32x4 const &a, f32x4 const &b) { return {{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}}; }
+			inline static f32x4 sub(f32x4 const &a, f32x4 const &b) { return {{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}}; }
+			inline static f32x4 mul(f32x4 const &a, f32x4 const &b) { return {{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]}}; }
+			/// a * b + c
+			inline static f32x4 madd(f32x4 const &a, f32x4 const &b, f32x4 const &c) { return add(mul(a, b), c); }
+			/// Lanes a and b of x then lanes c and d of y, like _mm_shuffle_ps
+			template<int a, int b, int c, int d> inline static f32x4 shuffle(f32x4 const &x, f32x4 const &y) { return {{x.v[a], x.v[b], y.v[c], y.v[d]}}; }
+			template<int lane> inline static f32x4 splat(f32x4 const &in) { return set1(in.v[lane]); }
+			/// Comparisons give 1 in lanes where they hold, combine them with both() and read them with mask()
+			inline static f32x4 lessThan(f32x4 const &a, f32x4 const &b) { return {{a.v[0] < b.v[0] ? 1.0f : 0.0f, a.v[1] < b.v[1] ? 1.0f : 0.0f, a.v[2] < b.v[2] ? 1.0f : 0.0f, a.v[3] < b.v[3] ? 1.0f : 0.0f}}; }
+			inline static f32x4 both(f32x4 const &a, f32x4 const &b) { return mul(a, b); }
+			/// Bit n set where lane n of a comparison held
+			inline static uint32_t mask(f32x4 const &in) { return (in.v[0] != 0) | (in.v[1] != 0) << 1 | (in.v[2] != 0) << 2 | (in.v[3] != 0) << 3; }
+		};
+
+#if defined(IRIS_SIMD_SSE)
+		struct SSE
+		{
+			using f32x4 = __m128;
+			
+			inline static f32x4 load(float const *in) { return _mm_loadu_ps(in); }
+			inline static void store(float *out, f32x4 in) { _mm_storeu_ps(out, in); }
+			inline static f32x4 set(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+			inline static f32x4 set1(float in) { return _mm_set1_ps(in); }
+			inline static f32x4 add(f32x4 a, f32x4 b) { return _mm_add_ps(a, b); }
+			inline static f32x4 sub(f32x4 a, f32x4 b) { return _mm_sub_ps(a, b); }
+			inline static f32x4 mul(f32x4 a, f32x4 b) { return _mm_mul_ps(a, b); }
+			
+			inline static f32x4 madd(f32x4 a, f32x4 b, f32x4 c)
+			{
+#if defined(__FMA__)
+				return _mm_fmadd_ps(a, b, c);
+#else
+				return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+			}
+			
+			template<int a, int b, int c, int d> inline static f32x4 shuffle(f32x4 x, f32x4 y) { return _mm_shuffle_ps(x, y, _MM_SHUFFLE(d, c, b, a)); }
+			template<int lane> inline static f32x4 splat(f32x4 in) { return _mm_shuffle_ps(in, in, _MM_SHUFFLE(lane, lane, lane, lane)); }
+			inline static f32x4 lessThan(f32x4 a, f32x4 b) { return _mm_cmplt_ps(a, b); }
+			inline static f32x4 both(f32x4 a, f32x4 b) { return _mm_and_ps(a, b); }
+			inline static uint32_t mask(f32x4 in) { return static_cast<uint32_t>(_mm_movemask_ps(in)); }
+		};
+		
+		using Native = SSE;
+#elif defined(IRIS_SIMD_NEON)
+		struct NEON
+		{
+			using f32x4 = float32x4_t;
+			
+			inline static f32x4 load(float const *in) { return vld1q_f32(in); }
+			inline static void store(float *out, f32x4 in) { vst1q_f32(out, in); }
+			inline static f32x4 set(float x, float y, float z, float w) { float in[4] = {x, y, z, w}; return vld1q_f32(in); }
+			inline static f32x4 set1(float in) { return vdupq_n_f32(in); }
+			inline static f32x4 add(f32x4 a, f32x4 b) { return vaddq_f32(a, b); }
+			inline static f32x4 sub(f32x4 a, f32x4 b) { return vsubq_f32(a, b); }
+			inline static f32x4 mul(f32x4 a, f32x4 b) { return vmulq_f32(a, b); }
+			inline static f32x4 madd(f32x4 a, f32x4 b, f32x4 c) { return vmlaq_f32(c, a, b); }
+			
+			template<int a, int b, int c, int d> inline static f32x4 shuffle(f32x4 x, f32x4 y)
+			{
+				return set(vgetq_lane_f32(x, a), vgetq_lane_f32(x, b), vgetq_lane_f32(y, c), vgetq_lane_f32(y, d));
+			}
+			
+			template<int lane> inline static f32x4 splat(f32x4 in) { return vdupq_n_f32(vgetq_lane_f32(in, lane)); }
+			inline static f32x4 lessThan(f32x4 a, f32x4 b) { return vreinterpretq_f32_u32(vcltq_f32(a, b)); }
+			inline static f32x4 both(f32x4 a, f32x4 b) { return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+			
+			inline static uint32_t mask(f32x4 in)
+			{
+				uint32x4_t bits = vshrq_n_u32(vreinterpretq_u32_f32(in), 31);
+				return vgetq_lane_u32(bits, 0) | vgetq_lane_u32(bits, 1) << 1 | vgetq_lane_u32(bits, 2) << 2 | vgetq_lane_u32(bits, 3) << 3;
+			}
+		};
+		
+		using Native = NEON;
+#else
+		using Native = Scalar;
+#endif
+
+		/// Whether Native is anything better than Scalar
+		static constexpr bool enabled = !std::is_same_v<Native, Scalar>;
+		
+		/// True while the compiler evaluates a constant expression, intrinsics can't run there so callers take their scalar path instead.
+		/// Without the builtin this is always false, and float matrix math only works at runtime unless IRIS_NO_SIMD is defined
+		inline constexpr bool constantEvaluated()
+		{
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+			return __builtin_is_constant_evaluated();
+#else
+			return false;
+#endif
+		}
+		
+		/// out = a * b for row dominant 4x4 matrices, out may not alias a or b
+		template<typename B> inline void mat4Multiply(float const *a, float const *b, float *out)
+		{
+			typename B::f32x4 b0 = B::load(b), b1 = B::load(b + 4), b2 = B::load(b + 8), b3 = B::load(b + 12);
+			for(size_t row = 0; row < 4; row++)
+			{
+				typename B::f32x4 r = B::load(a + row * 4);
+				typename B::f32x4 acc = B::mul(B::template splat<0>(r), b0);
+				acc = B::madd(B::template splat<1>(r), b1, acc);
+				acc = B::madd(B::template splat<2>(r), b2, acc);
+				acc = B::madd(B::template splat<3>(r), b3, acc);
+				B::store(out + row * 4, acc);
+			}
+		}
+		
+		template<typename B> inline void mat4Transpose(float const *in, float *out)
+		{
+			typename B::f32x4 r0 = B::load(in), r1 = B::load(in + 4), r2 = B::load(in + 8), r3 = B::load(in + 12);
+			typename B::f32x4 t0 = B::template shuffle<0, 1, 0, 1>(r0, r1), t1 = B::template shuffle<2, 3, 2, 3>(r0, r1);
+			typename B::f32x4 t2 = B::template shuffle<0, 1, 0, 1>(r2, r3), t3 = B::template shuffle<2, 3, 2, 3>(r2, r3);
+			B::store(out, B::template shuffle<0, 2, 0, 2>(t0, t2));
+			B::store(out + 4, B::template shuffle<1, 3, 1, 3>(t0, t2));
+			B::store(out + 8, B::template shuffle<0, 2, 0, 2>(t1, t3));
+			B::store(out + 12, B::template shuffle<1, 3, 1, 3>(t1, t3));
+		}
+		
+		/// Inverse from the 2x2 sub-determinants of the top and bottom row pairs, returns false and leaves out untouched if in is singular
+		template<typename B> inline bool mat4Inverse(float const *in, float *out)
+		{
+			typename B::f32x4 r0 = B::load(in), r1 = B::load(in + 4), r2 = B::load(in + 8), r3 = B::load(in + 12);
+			//s0 s1 s2 s3 and s4 s5 s4 s5 from rows 0 and 1, c0 c1 c2 c3 and c4 c5 c4 c5 from rows 2 and 3
+			typename B::f32x4 s03 = B::sub(B::mul(B::template shuffle<0, 0, 0, 1>(r0, r0), B::template shuffle<1, 2, 3, 2>(r1, r1)),
+			                               B::mul(B::template shuffle<1, 2, 3, 2>(r0, r0), B::template shuffle<0, 0, 0, 1>(r1, r1)));
+			typename B::f32x4 s45 = B::sub(B::mul(B::template shuffle<1, 2, 1, 2>(r0, r0), B::template splat<3>(r1)),
+			                               B::mul(B::template splat<3>(r0), B::template shuffle<1, 2, 1, 2>(r1, r1)));
+			typename B::f32x4 c03 = B::sub(B::mul(B::template shuffle<0, 0, 0, 1>(r2, r2), B::template shuffle<1, 2, 3, 2>(r3, r3)),
+			                               B::mul(B::template shuffle<1, 2, 3, 2>(r2, r2), B::template shuffle<0, 0, 0, 1>(r3, r3)));
+			typename B::f32x4 c45 = B::sub(B::mul(B::template shuffle<1, 2, 1, 2>(r2, r2), B::template splat<3>(r3)),
+			                               B::mul(B::template splat<3>(r2), B::template shuffle<1, 2, 1, 2>(r3, r3)));
+			float s[4], sHigh[4], c[4], cHigh[4];
+			B::store(s, s03);
+			B::store(sHigh, s45);
+			B::store(c, c03);
+			B::store(cHigh, c45);
+			float det = s[0] * cHigh[1] - s[1] * cHigh[0] + s[2] * c[3] + s[3] * c[2] - sHigh[0] * c[1] + sHigh[1] * c[0];
+			if(det == 0) return false;
+			//Columns of the input in row order 1 0 3 2, each output row is a sum of these times the matching determinants
+			typename B::f32x4 t0 = B::template shuffle<0, 1, 0, 1>(r0, r1), t1 = B::template shuffle<2, 3, 2, 3>(r0, r1);
+			typename B::f32x4 t2 = B::template shuffle<0, 1, 0, 1>(r2, r3), t3 = B::template shuffle<2, 3, 2, 3>(r2, r3);
+			typename B::f32x4 x0 = B::template shuffle<1, 0, 3, 2>(B::template shuffle<0, 2, 0, 2>(t0, t2), B::template shuffle<0, 2, 0, 2>(t0, t2));
+			typename B::f32x4 x1 = B::template shuffle<1, 0, 3, 2>(B::template shuffle<1, 3, 1, 3>(t0, t2), B::template shuffle<1, 3, 1, 3>(t0, t2));
+			typename B::f32x4 x2 = B::template shuffle<1, 0, 3, 2>(B::template shuffle<0, 2, 0, 2>(t1, t3), B::template shuffle<0, 2, 0, 2>(t1, t3));
+			typename B::f32x4 x3 = B::template shuffle<1, 0, 3, 2>(B::template shuffle<1, 3, 1, 3>(t1, t3), B::template shuffle<1, 3, 1, 3>(t1, t3));
+			typename B::f32x4 y0 = B::template shuffle<0, 0, 0, 0>(c03, s03), y1 = B::template shuffle<1, 1, 1, 1>(c03, s03);
+			typename B::f32x4 y2 = B::template shuffle<2, 2, 2, 2>(c03, s03), y3 = B::template shuffle<3, 3, 3, 3>(c03, s03);
+			typename B::f32x4 y4 = B::template shuffle<0, 0, 0, 0>(c45, s45), y5 = B::template shuffle<1, 1, 1, 1>(c45, s45);
+			float invDet = 1.0f / det;
+			typename B::f32x4 even = B::set(invDet, -invDet, invDet, -invDet), odd = B::set(-invDet, invDet, -invDet, invDet);
+			B::store(out, B::mul(B::madd(x3, y3, B::sub(B::mul(x1, y5), B::mul(x2, y4))), even));
+			B::store(out + 4, B::mul(B::madd(x3, y1, B::sub(B::mul(x0, y5), B::mul(x2, y2))), odd));
+			B::store(out + 8, B::mul(B::madd(x3, y0, B::sub(B::mul(x0, y4), B::mul(x1, y2))), even));
+			B::store(out + 12, B::mul(B::madd(x2, y0, B::sub(B::mul(x0, y3), B::mul(x1, y1))), odd));
+			return true;
+		}
+		
+		/// count vec4s through a row dominant matrix the way mat4x4 * vec4 does, in and out may alias
+		template<typename B> inline void vec4Transform(float const *m, float const *in, float *out, size_t count)
+		{
+			typename B::f32x4 m0 = B::load(m), m1 = B::load(m + 4), m2 = B::load(m + 8), m3 = B::load(m + 12);
+			for(size_t i = 0; i < count; i++, in += 4, out += 4)
+			{
+				typename B::f32x4 v = B::load(in);
+				typename B::f32x4 acc = B::mul(B::template splat<0>(v), m0);
+				acc = B::madd(B::template splat<1>(v), m1, acc);
+				acc = B::madd(B::template splat<2>(v), m2, acc);
+				B::store(out, B::madd(B::template splat<3>(v), m3, acc));
+			}
+		}
+		
+		/// count 2D points as vec4(x, y, 0, 1), keeping x and y of the result without a perspective divide, in and out may alias
+		template<typename B> inline void vec2Transform(float const *m, float const *in, float *out, size_t count)
+		{
+			typename B::f32x4 m0 = B::load(m), m1 = B::load(m + 4), m3 = B::load(m + 12);
+			//Two points per iteration, the x and y rows are interleaved so each result lands where its input came from
+			typename B::f32x4 row0 = B::template shuffle<0, 1, 0, 1>(m0, m0), row1 = B::template shuffle<0, 1, 0, 1>(m1, m1), row3 = B::template shuffle<0, 1, 0, 1>(m3, m3);
+			size_t i = 0;
+			for(; i + 2 <= count; i += 2)
+			{
+				typename B::f32x4 v = B::load(in + i * 2);
+				typename B::f32x4 acc = B::madd(B::template shuffle<0, 0, 2, 2>(v, v), row0, row3);
+				B::store(out + i * 2, B::madd(B::template shuffle<1, 1, 3, 3>(v, v), row1, acc));
+			}
+			for(; i < count; i++)
+			{
+				float x = in[i * 2], y = in[i * 2 + 1];
+				out[i * 2] = x * m[0] + y * m[4] + m[12];
+				out[i * 2 + 1] = x * m[1] + y * m[5] + m[13];
+			}
+		}
+		
+		/// Which of count rects, stored as min and max columns, overlap clip (minX, minY, maxX, maxY).  Touching edges don't count.
+		/// Calls emit(first, bits) for each group of 4 rects starting at first, bit n set when rect first + n overlaps, bits past count are 0
+		template<typename B, typename F> inline void rectOverlap(float const *minX, float const *minY, float const *maxX, float const *maxY, size_t count, float const (&clip)[4], F const &emit)
+		{
+			typename B::f32x4 clipMinX = B::set1(clip[0]), clipMinY = B::set1(clip[1]), clipMaxX = B::set1(clip[2]), clipMaxY = B::set1(clip[3]);
+			auto test = [&](typename B::f32x4 x0, typename B::f32x4 y0, typename B::f32x4 x1, typename B::f32x4 y1)
+			{
+				return B::mask(B::both(B::both(B::lessThan(x0, clipMaxX), B::lessThan(clipMinX, x1)), B::both(B::lessThan(y0, clipMaxY), B::lessThan(clipMinY, y1))));
+			};
+			size_t i = 0;
+			for(; i + 4 <= count; i += 4) emit(i, test(B::load(minX + i), B::load(minY + i), B::load(maxX + i), B::load(maxY + i)));
+			if(i == count) return;
+			//Copy the last partial group out so the loads stay in bounds, and drop the bits of the lanes past count
+			float tail[4][4] {};
+			for(size_t lane = 0; i + lane < count; lane++)
+			{
+				tail[0][lane] = minX[i + lane];
+				tail[1][lane] = minY[i + lane];
+				tail[2][lane] = maxX[i + lane];
+				tail[3][lane] = maxY[i + lane];
+			}
+			emit(i, test(B::load(tail[0]), B::load(tail[1]), B::load(tail[2]), B::load(tail[3])) & ((1u << (count - i)) - 1));
+		}
+	}
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <ctgmath>
+#include <cstring>
 
 namespace Iris
 {
@@ -8,16 +9,16 @@ namespace Iris
 	{
 		T data[2]{0, 0};
 		
-		inline T &x() { return this->data[0]; }
-		inline T &y() { return this->data[1]; }
-		inline T const &x() const { return this->data[0]; }
-		inline T const &y() const { return this->data[1]; }
+		inline constexpr T &x() { return this->data[0]; }
+		inline constexpr T &y() { return this->data[1]; }
+		inline constexpr T const &x() const { return this->data[0]; }
+		inline constexpr T const &y() const { return this->data[1]; }
 		
 		// 2-way Swizzling (sort of) 2 permutations
-		inline vec2<T> xx() { return vec2<T>{this->data[0], this->data[0]}; }
-		inline vec2<T> yy() { return vec2<T>{this->data[1], this->data[1]}; }
-		inline vec2<T> xx() const { return vec2<T>{this->data[0], this->data[0]}; }
-		inline vec2<T> yy() const { return vec2<T>{this->data[1], this->data[1]}; }
+		inline constexpr vec2<T> xx() { return vec2<T>{this->data[0], this->data[0]}; }
+		inline constexpr vec2<T> yy() { return vec2<T>{this->data[1], this->data[1]}; }
+		inline constexpr vec2<T> xx() const { return vec2<T>{this->data[0], this->data[0]}; }
+		inline constexpr vec2<T> yy() const { return vec2<T>{this->data[1], this->data[1]}; }
 		
 		inline constexpr vec2<T>() = default;
 		
@@ -39,118 +40,111 @@ namespace Iris
 			this->data[1] = scalar;
 		}
 		
-		inline vec2<T>(vec2<T> const &other)
-		{
-			memcpy(&this->data[0], &other.data[0], sizeof(other.data));
-		}
+		inline constexpr vec2<T>(vec2<T> const &other) = default;
 		
-		inline vec2<T> &operator=(vec2<T> const &other)
-		{
-			memcpy(&this->data[0], &other.data[0], sizeof(other.data));
-			return *this;
-		}
+		inline constexpr vec2<T> &operator=(vec2<T> const &other) = default;
 		
-		inline T &operator[](size_t index)
+		inline constexpr T &operator[](size_t index)
 		{
 			return this->data[index];
 		}
 		
-		inline T const &operator[](size_t index) const
+		inline constexpr T const &operator[](size_t index) const
 		{
 			return this->data[index];
 		}
 		
-		inline bool operator==(vec2<T> const &other) const
+		inline constexpr bool operator==(vec2<T> const &other) const
 		{
 			return this->data[0] == other[0] && this->data[1] == other[1];
 		}
 		
-		inline bool operator!=(vec2<T> const &other) const
+		inline constexpr bool operator!=(vec2<T> const &other) const
 		{
 			return this->data[0] != other[0] || this->data[1] != other[1];
 		}
 		
-		inline vec2<T> operator+(vec2<T> const &other) const
+		inline constexpr vec2<T> operator+(vec2<T> const &other) const
 		{
 			return vec2<T>{this->data[0] + other[0], this->data[1] + other[1]};
 		}
 		
-		inline vec2<T> operator+(T const &scalar) const
+		inline constexpr vec2<T> operator+(T const &scalar) const
 		{
 			return vec2<T>{static_cast<T>(this->data[0] + scalar), static_cast<T>(this->data[1] + scalar)};
 		}
 		
-		inline vec2<T> operator-(vec2<T> const &other) const
+		inline constexpr vec2<T> operator-(vec2<T> const &other) const
 		{
 			return vec2<T>{this->data[0] - other[0], this->data[1] - other[1]};
 		}
 		
-		inline vec2<T> operator-(T const &scalar) const
+		inline constexpr vec2<T> operator-(T const &scalar) const
 		{
 			return vec2<T>{static_cast<T>(this->data[0] - scalar), static_cast<T>(this->data[1] - scalar)};
 		}
 		
-		inline vec2<T> operator-() const
+		inline constexpr vec2<T> operator-() const
 		{
 			return vec2<T>{-this->data[0], -this->data[1]};
 		}
 		
-		inline vec2<T> operator*(vec2<T> const &other) const
+		inline constexpr vec2<T> operator*(vec2<T> const &other) const
 		{
 			return vec2<T>{this->data[0] * other[0], this->data[1] * other[1]};
 		}
 		
-		inline vec2<T> operator*(T scalar) const
+		inline constexpr vec2<T> operator*(T scalar) const
 		{
 			return vec2<T>{static_cast<T>(this->data[0] * scalar), static_cast<T>(this->data[1] * scalar)};
 		}
 		
-		inline vec2<T> operator/(vec2<T> const &other) const
+		inline constexpr vec2<T> operator/(vec2<T> const &other) const
 		{
 			return vec2<T>{this->data[0] / other[0], this->data[1] / other[1]};
 		}
 		
-		inline vec2<T> operator/(T const &scalar) const
+		inline constexpr vec2<T> operator/(T const &scalar) const
 		{
 			return vec2<T>{static_cast<T>(this->data[0] / scalar), static_cast<T>(this->data[1] / scalar)};
 		}
 		
-		inline vec2<T> &operator+=(vec2<T> const &other)
+		inline constexpr vec2<T> &operator+=(vec2<T> const &other)
 		{
 			this->data[0] += other[0];
 			this->data[1] += other[1];
 			return *this;
 		}
 		
-		inline vec2<T> &operator-=(vec2<T> const &other)
+		inline constexpr vec2<T> &operator-=(vec2<T> const &other)
 		{
 			this->data[0] -= other[0];
 			this->data[1] -= other[1];
 			return *this;
 		}
 		
-		inline vec2<T> &operator*=(vec2<T> const &other)
+		inline constexpr vec2<T> &operator*=(vec2<T> const &other)
 		{
 			this->data[0] *= other[0];
 			this->data[1] *= other[1];
 			return *this;
 		}
 		
-		inline vec2<T> &operator/=(vec2<T> const &other)
+		inline constexpr vec2<T> &operator/=(vec2<T> const &other)
 		{
 			this->data[0] /= other[0];
 			this->data[1] /= other[1];
 			return *this;
 		}
 		
-		inline vec2<T> &operator++()
+		inline constexpr vec2<T> &operator++()
 		{
 			this->data[0]++;
 			this->data[1]++;
 			return *this;
 		}
 		
-		inline vec2<T> &operator++(int)
+		inline constexpr vec2<T> operator++(int)
 		{
 			vec2<T> out = *this;
 			this->data[0]++;
@@ -158,14 +152,14 @@ namespace Iris
 			return out;
 		}
 		
-		inline vec2<T> &operator--()
+		inline constexpr vec2<T> &operator--()
 		{
 			this->data[0]--;
 			this->data[1]--;
 			return *this;
 		}
 		
-		inline vec2<T> &operator--(int)
+		inline constexpr vec2<T> operator--(int)
 		{
 			vec2<T> out = *this;
 			this->data[0]--;
@@ -173,24 +167,24 @@ namespace Iris
 			return out;
 		}
 		
-		inline void set(T x, T y)
+		inline constexpr void set(T x, T y)
 		{
 			this->data[0] = x;
 			this->data[1] = y;
 		}
 		
-		inline void setAll(T value)
+		inline constexpr void setAll(T value)
 		{
 			this->set(value, value);
 		}
 		
-		inline void invert()
+		inline constexpr void invert()
 		{
 			this->data[0] = -this->data[0];
 			this->data[1] = -this->data[1];
 		}
 		
-		inline vec2<T> inverse() const
+		inline constexpr vec2<T> inverse() const
 		{
 			return {-this->data[0], -this->data[1]};
 		}
@@ -200,9 +194,9 @@ namespace Iris
 			return std::sqrt(this->data[0] * this->data[0] + this->data[1] * this->data[1]);
 		}
 		
-		inline T dot(vec2<T> const &b) const
+		inline constexpr T dot(vec2<T> const &b) const
 		{
-			return this->data[0] * b.x + this->data[1] * b.y;
+			return this->data[0] * b.x() + this->data[1] * b.y();
 		}
 		
 		inline void normalize()
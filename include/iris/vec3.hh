@@ -2,6 +2,8 @@
 
 #include "vec2.hh"
 
+#include <cstring>
+
 namespace Iris
 {
 	template<typename T> struct vec4;
@@ -13,146 +15,146 @@ namespace Iris
 		T data[3]{0, 0, 0};
 		
 		/// Get a reference to one of the contained values
-		inline T &x() { return this->data[0]; }
-		inline T &y() { return this->data[1]; }
-		inline T &z() { return this->data[2]; }
-		inline T const &x() const { return this->data[0]; }
-		inline T const &y() const { return this->data[1]; }
-		inline T const &z() const { return this->data[2]; }
-		
-		inline T &r() { return this->data[0]; }
-		inline T &g() { return this->data[1]; }
-		inline T &b() { return this->data[2]; }
-		inline T const &r() const { return this->data[0]; }
-		inline T const &g() const { return this->data[1]; }
-		inline T const &b() const { return this->data[2]; }
+		inline constexpr T &x() { return this->data[0]; }
+		inline constexpr T &y() { return this->data[1]; }
+		inline constexpr T &z() { return this->data[2]; }
+		inline constexpr T const &x() const { return this->data[0]; }
+		inline constexpr T const &y() const { return this->data[1]; }
+		inline constexpr T const &z() const { return this->data[2]; }
+		
+		inline constexpr T &r() { return this->data[0]; }
+		inline constexpr T &g() { return this->data[1]; }
+		inline constexpr T &b() { return this->data[2]; }
+		inline constexpr T const &r() const { return this->data[0]; }
+		inline constexpr T const &g() const { return this->data[1]; }
+		inline constexpr T const &b() const { return this->data[2]; }
 		
 		// 3-way Swizzling (sort of), 26 permutations (excluded xyz)
-		inline vec3<T> xxx() { return vec3<T>{this->data[0]}; }
-		inline vec3<T> yyy() { return vec3<T>{this->data[1]}; }
-		inline vec3<T> zzz() { return vec3<T>{this->data[2]}; }
-		inline vec3<T> zyx() { return vec3<T>{this->data[2], this->data[1], this->data[0]}; }
-		inline vec3<T> xxy() { return vec3<T>{this->data[0], this->data[0], this->data[1]}; }
-		inline vec3<T> xxz() { return vec3<T>{this->data[0], this->data[0], this->data[2]}; }
-		inline vec3<T> yyx() { return vec3<T>{this->data[1], this->data[1], this->data[0]}; }
-		inline vec3<T> yyz() { return vec3<T>{this->data[0], this->data[1], this->data[2]}; }
-		inline vec3<T> zzx() { return vec3<T>{this->data[2], this->data[2], this->data[0]}; }
-		inline vec3<T> zzy() { return vec3<T>{this->data[2], this->data[2], this->data[1]}; }
-		inline vec3<T> xyy() { return vec3<T>{this->data[0], this->data[1], this->data[1]}; }
-		inline vec3<T> xzz() { return vec3<T>{this->data[0], this->data[2], this->data[2]}; }
-		inline vec3<T> yxx() { return vec3<T>{this->data[1], this->data[0], this->data[0]}; }
-		inline vec3<T> yzz() { return vec3<T>{this->data[1], this->data[2], this->data[2]}; }
-		inline vec3<T> zxx() { return vec3<T>{this->data[2], this->data[0], this->data[0]}; }
-		inline vec3<T> zyy() { return vec3<T>{this->data[2], this->data[1], this->data[1]}; }
-		inline vec3<T> xyx() { return vec3<T>{this->data[0], this->data[1], this->data[0]}; }
-		inline vec3<T> xzx() { return vec3<T>{this->data[0], this->data[2], this->data[0]}; }
-		inline vec3<T> yxy() { return vec3<T>{this->data[1], this->data[0], this->data[1]}; }
-		inline vec3<T> yzy() { return vec3<T>{this->data[1], this->data[2], this->data[1]}; }
-		inline vec3<T> zxz() { return vec3<T>{this->data[2], this->data[0], this->data[2]}; }
-		inline vec3<T> zyz() { return vec3<T>{this->data[2], this->data[1], this->data[2]}; }
-		inline vec3<T> xzy() { return vec3<T>{this->data[0], this->data[2], this->data[1]}; }
-		inline vec3<T> yzx() { return vec3<T>{this->data[1], this->data[2], this->data[0]}; }
-		inline vec3<T> zxy() { return vec3<T>{this->data[2], this->data[0], this->data[1]}; }
-		inline vec3<T> yxz() { return vec3<T>{this->data[1], this->data[0], this->data[2]}; }
-		inline vec3<T> xxx() const { return vec3<T>{this->data[0]}; }
-		inline vec3<T> yyy() const { return vec3<T>{this->data[1]}; }
-		inline vec3<T> zzz() const { return vec3<T>{this->data[2]}; }
-		inline vec3<T> zyx() const { return vec3<T>{this->data[2], this->data[1], this->data[0]}; }
-		inline vec3<T> xxy() const { return vec3<T>{this->data[0], this->data[0], this->data[1]}; }
-		inline vec3<T> xxz() const { return vec3<T>{this->data[0], this->data[0], this->data[2]}; }
-		inline vec3<T> yyx() const { return vec3<T>{this->data[1], this->data[1], this->data[0]}; }
-		inline vec3<T> yyz() const { return vec3<T>{this->data[0], this->data[1], this->data[2]}; }
-		inline vec3<T> zzx() const { return vec3<T>{this->data[2], this->data[2], this->data[0]}; }
-		inline vec3<T> zzy() const { return vec3<T>{this->data[2], this->data[2], this->data[1]}; }
-		inline vec3<T> xyy() const { return vec3<T>{this->data[0], this->data[1], this->data[1]}; }
-		inline vec3<T> xzz() const { return vec3<T>{this->data[0], this->data[2], this->data[2]}; }
-		inline vec3<T> yxx() const { return vec3<T>{this->data[1], this->data[0], this->data[0]}; }
-		inline vec3<T> yzz() const { return vec3<T>{this->data[1], this->data[2], this->data[2]}; }
-		inline vec3<T> zxx() const { return vec3<T>{this->data[2], this->data[0], this->data[0]}; }
-		inline vec3<T> zyy() const { return vec3<T>{this->data[2], this->data[1], this->data[1]}; }
-		inline vec3<T> xyx() const { return vec3<T>{this->data[0], this->data[1], this->data[0]}; }
-		inline vec3<T> xzx() const { return vec3<T>{this->data[0], this->data[2], this->data[0]}; }
-		inline vec3<T> yxy() const { return vec3<T>{this->data[1], this->data[0], this->data[1]}; }
-		inline vec3<T> yzy() const { return vec3<T>{this->data[1], this->data[2], this->data[1]}; }
-		inline vec3<T> zxz() const { return vec3<T>{this->data[2], this->data[0], this->data[2]}; }
-		inline vec3<T> zyz() const { return vec3<T>{this->data[2], this->data[1], this->data[2]}; }
-		inline vec3<T> xzy() const { return vec3<T>{this->data[0], this->data[2], this->data[1]}; }
-		inline vec3<T> yzx() const { return vec3<T>{this->data[1], this->data[2], this->data[0]}; }
-		inline vec3<T> zxy() const { return vec3<T>{this->data[2], this->data[0], this->data[1]}; }
-		inline vec3<T> yxz() const { return vec3<T>{this->data[1], this->data[0], this->data[2]}; }
-		
-		inline vec3<T> rrr() { return vec3<T>{this->data[0]}; }
-		inline vec3<T> ggg() { return vec3<T>{this->data[1]}; }
-		inline vec3<T> bbb() { return vec3<T>{this->data[2]}; }
-		inline vec3<T> bgr() { return vec3<T>{this->data[2], this->data[1], this->data[0]}; }
-		inline vec3<T> rrg() { return vec3<T>{this->data[0], this->data[0], this->data[1]}; }
-		inline vec3<T> rrb() { return vec3<T>{this->data[0], this->data[0], this->data[2]}; }
-		inline vec3<T> ggr() { return vec3<T>{this->data[1], this->data[1], this->data[0]}; }
-		inline vec3<T> ggb() { return vec3<T>{this->data[0], this->data[1], this->data[2]}; }
-		inline vec3<T> bbr() { return vec3<T>{this->data[2], this->data[2], this->data[0]}; }
-		inline vec3<T> bbg() { return vec3<T>{this->data[2], this->data[2], this->data[1]}; }
-		inline vec3<T> rgg() { return vec3<T>{this->data[0], this->data[1], this->data[1]}; }
-		inline vec3<T> rbb() { return vec3<T>{this->data[0], this->data[2], this->data[2]}; }
-		inline vec3<T> grr() { return vec3<T>{this->data[1], this->data[0], this->data[0]}; }
-		inline vec3<T> gbb() { return vec3<T>{this->data[1], this->data[2], this->data[2]}; }
-		inline vec3<T> brr() { return vec3<T>{this->data[2], this->data[0], this->data[0]}; }
-		inline vec3<T> bgg() { return vec3<T>{this->data[2], this->data[1], this->data[1]}; }
-		inline vec3<T> rgr() { return vec3<T>{this->data[0], this->data[1], this->data[0]}; }
-		inline vec3<T> rbr() { return vec3<T>{this->data[0], this->data[2], this->data[0]}; }
-		inline vec3<T> grg() { return vec3<T>{this->data[1], this->data[0], this->data[1]}; }
-		inline vec3<T> gbg() { return vec3<T>{this->data[1], this->data[2], this->data[1]}; }
-		inline vec3<T> brb() { return vec3<T>{this->data[2], this->data[0], this->data[2]}; }
-		inline vec3<T> bgb() { return vec3<T>{this->data[2], this->data[1], this->data[2]}; }
-		inline vec3<T> rbg() { return vec3<T>{this->data[0], this->data[2], this->data[1]}; }
-		inline vec3<T> gbr() { return vec3<T>{this->data[1], this->data[2], this->data[0]}; }
-		inline vec3<T> brg() { return vec3<T>{this->data[2], this->data[0], this->data[1]}; }
-		inline vec3<T> grb() { return vec3<T>{this->data[1], this->data[0], this->data[2]}; }
-		inline vec3<T> rrr() const { return vec3<T>{this->data[0]}; }
-		inline vec3<T> ggg() const { return vec3<T>{this->data[1]}; }
-		inline vec3<T> bbb() const { return vec3<T>{this->data[2]}; }
-		inline vec3<T> bgr() const { return vec3<T>{this->data[2], this->data[1], this->data[0]}; }
-		inline vec3<T> rrg() const { return vec3<T>{this->data[0], this->data[0], this->data[1]}; }
-		inline vec3<T> rrb() const { return vec3<T>{this->data[0], this->data[0], this->data[2]}; }
-		inline vec3<T> ggr() const { return vec3<T>{this->data[1], this->data[1], this->data[0]}; }
-		inline vec3<T> ggb() const { return vec3<T>{this->data[0], this->data[1], this->data[2]}; }
-		inline vec3<T> bbr() const { return vec3<T>{this->data[2], this->data[2], this->data[0]}; }
-		inline vec3<T> bbg() const { return vec3<T>{this->data[2], this->data[2], this->data[1]}; }
-		inline vec3<T> rgg() const { return vec3<T>{this->data[0], this->data[1], this->data[1]}; }
-		inline vec3<T> rbb() const { return vec3<T>{this->data[0], this->data[2], this->data[2]}; }
-		inline vec3<T> grr() const { return vec3<T>{this->data[1], this->data[0], this->data[0]}; }
-		inline vec3<T> gbb() const { return vec3<T>{this->data[1], this->data[2], this->data[2]}; }
-		inline vec3<T> brr() const { return vec3<T>{this->data[2], this->data[0], this->data[0]}; }
-		inline vec3<T> bgg() const { return vec3<T>{this->data[2], this->data[1], this->data[1]}; }
-		inline vec3<T> rgr() const { return vec3<T>{this->data[0], this->data[1], this->data[0]}; }
-		inline vec3<T> rbr() const { return vec3<T>{this->data[0], this->data[2], this->data[0]}; }
-		inline vec3<T> grg() const { return vec3<T>{this->data[1], this->data[0], this->data[1]}; }
-		inline vec3<T> gbg() const { return vec3<T>{this->data[1], this->data[2], this->data[1]}; }
-		inline vec3<T> brb() const { return vec3<T>{this->data[2], this->data[0], this->data[2]}; }
-		inline vec3<T> bgb() const { return vec3<T>{this->data[2], this->data[1], this->data[2]}; }
-		inline vec3<T> rbg() const { return vec3<T>{this->data[0], this->data[2], this->data[1]}; }
-		inline vec3<T> gbr() const { return vec3<T>{this->data[1], this->data[2], this->data[0]}; }
-		inline vec3<T> brg() const { return vec3<T>{this->data[2], this->data[0], this->data[1]}; }
-		inline vec3<T> grb() const { return vec3<T>{this->data[1], this->data[0], this->data[2]}; }
+		inline constexpr vec3<T> xxx() { return vec3<T>{this->data[0]}; }
+		inline constexpr vec3<T> yyy() { return vec3<T>{this->data[1]}; }
+		inline constexpr vec3<T> zzz() { return vec3<T>{this->data[2]}; }
+		inline constexpr vec3<T> zyx() { return vec3<T>{this->data[2], this->data[1], this->data[0]}; }
+		inline constexpr vec3<T> xxy() { return vec3<T>{this->data[0], this->data[0], this->data[1]}; }
+		inline constexpr vec3<T> xxz() { return vec3<T>{this->data[0], this->data[0], this->data[2]}; }
+		inline constexpr vec3<T> yyx() { return vec3<T>{this->data[1], this->data[1], this->data[0]}; }
+		inline constexpr vec3<T> yyz() { return vec3<T>{this->data[0], this->data[1], this->data[2]}; }
+		inline constexpr vec3<T> zzx() { return vec3<T>{this->data[2], this->data[2], this->data[0]}; }
+		inline constexpr vec3<T> zzy() { return vec3<T>{this->data[2], this->data[2], this->data[1]}; }
+		inline constexpr vec3<T> xyy() { return vec3<T>{this->data[0], this->data[1], this->data[1]}; }
+		inline constexpr vec3<T> xzz() { return vec3<T>{this->data[0], this->data[2], this->data[2]}; }
+		inline constexpr vec3<T> yxx() { return vec3<T>{this->data[1], this->data[0], this->data[0]}; }
+		inline constexpr vec3<T> yzz() { return vec3<T>{this->data[1], this->data[2], this->data[2]}; }
+		inline constexpr vec3<T> zxx() { return vec3<T>{this->data[2], this->data[0], this->data[0]}; }
+		inline constexpr vec3<T> zyy() { return vec3<T>{this->data[2], this->data[1], this->data[1]}; }
+		inline constexpr vec3<T> xyx() { return vec3<T>{this->data[0], this->data[1], this->data[0]}; }
+		inline constexpr vec3<T> xzx() { return vec3<T>{this->data[0], this->data[2], this->data[0]}; }
+		inline constexpr vec3<T> yxy() { return vec3<T>{this->data[1], this->data[0], this->data[1]}; }
+		inline constexpr vec3<T> yzy() { return vec3<T>{this->data[1], this->data[2], this->data[1]}; }
+		inline constexpr vec3<T> zxz() { return vec3<T>{this->data[2], this->data[0], this->data[2]}; }
+		inline constexpr vec3<T> zyz() { return vec3<T>{this->data[2], this->data[1], this->data[2]}; }
+		inline constexpr vec3<T> xzy() { return vec3<T>{this->data[0], this->data[2], this->data[1]}; }
+		inline constexpr vec3<T> yzx() { return vec3<T>{this->data[1], this->data[2], this->data[0]}; }
+		inline constexpr vec3<T> zxy() { return vec3<T>{this->data[2], this->data[0], this->data[1]}; }
+		inline constexpr vec3<T> yxz() { return vec3<T>{this->data[1], this->data[0], this->data[2]}; }
+		inline constexpr vec3<T> xxx() const { return vec3<T>{this->data[0]}; }
+		inline constexpr vec3<T> yyy() const { return vec3<T>{this->data[1]}; }
+		inline constexpr vec3<T> zzz() const { return vec3<T>{this->data[2]}; }
+		inline constexpr vec3<T> zyx() const { return vec3<T>{this->data[2], this->data[1], this->data[0]}; }
+		inline constexpr vec3<T> xxy() const { return vec3<T>{this->data[0], this->data[0], this->data[1]}; }
+		inline constexpr vec3<T> xxz() const { return vec3<T>{this->data[0], this->data[0], this->data[2]}; }
+		inline constexpr vec3<T> yyx() const { return vec3<T>{this->data[1], this->data[1], this->data[0]}; }
+		inline constexpr vec3<T> yyz() const { return vec3<T>{this->data[0], this->data[1], this->data[2]}; }
+		inline constexpr vec3<T> zzx() const { return vec3<T>{this->data[2], this->data[2], this->data[0]}; }
+		inline constexpr vec3<T> zzy() const { return vec3<T>{this->data[2], this->data[2], this->data[1]}; }
+		inline constexpr vec3<T> xyy() const { return vec3<T>{this->data[0], this->data[1], this->data[1]}; }
+		inline constexpr vec3<T> xzz() const { return vec3<T>{this->data[0], this->data[2], this->data[2]}; }
+		inline constexpr vec3<T> yxx() const { return vec3<T>{this->data[1], this->data[0], this->data[0]}; }
+		inline constexpr vec3<T> yzz() const { return vec3<T>{this->data[1], this->data[2], this->data[2]}; }
+		inline constexpr vec3<T> zxx() const { return vec3<T>{this->data[2], this->data[0], this->data[0]}; }
+		inline constexpr vec3<T> zyy() const { return vec3<T>{this->data[2], this->data[1], this->data[1]}; }
+		inline constexpr vec3<T> xyx() const { return vec3<T>{this->data[0], this->data[1], this->data[0]}; }
+		inline constexpr vec3<T> xzx() const { return vec3<T>{this->data[0], this->data[2], this->data[0]}; }
+		inline constexpr vec3<T> yxy() const { return vec3<T>{this->data[1], this->data[0], this->data[1]}; }
+		inline constexpr vec3<T> yzy() const { return vec3<T>{this->data[1], this->data[2], this->data[1]}; }
+		inline constexpr vec3<T> zxz() const { return vec3<T>{this->data[2], this->data[0], this->data[2]}; }
+		inline constexpr vec3<T> zyz() const { return vec3<T>{this->data[2], this->data[1], this->data[2]}; }
+		inline constexpr vec3<T> xzy() const { return vec3<T>{this->data[0], this->data[2], this->data[1]}; }
+		inline constexpr vec3<T> yzx() const { return vec3<T>{this->data[1], this->data[2], this->data[0]}; }
+		inline constexpr vec3<T> zxy() const { return vec3<T>{this->data[2], this->data[0], this->data[1]}; }
+		inline constexpr vec3<T> yxz() const { return vec3<T>{this->data[1], this->data[0], this->data[2]}; }
+		
+		inline constexpr vec3<T> rrr() { return vec3<T>{this->data[0]}; }
+		inline constexpr vec3<T> ggg() { return vec3<T>{this->data[1]}; }
+		inline constexpr vec3<T> bbb() { return vec3<T>{this->data[2]}; }
+		inline constexpr vec3<T> bgr() { return vec3<T>{this->data[2], this->data[1], this->data[0]}; }
+		inline constexpr vec3<T> rrg() { return vec3<T>{this->data[0], this->data[0], this->data[1]}; }
+		inline constexpr vec3<T> rrb() { return vec3<T>{this->data[0], this->data[0], this->data[2]}; }
+		inline constexpr vec3<T> ggr() { return vec3<T>{this->data[1], this->data[1], this->data[0]}; }
+		inline constexpr vec3<T> ggb() { return vec3<T>{this->data[0], this->data[1], this->data[2]}; }
+		inline constexpr vec3<T> bbr() { return vec3<T>{this->data[2], this->data[2], this->data[0]}; }
+		inline constexpr vec3<T> bbg() { return vec3<T>{this->data[2], this->data[2], this->data[1]}; }
+		inline constexpr vec3<T> rgg() { return vec3<T>{this->data[0], this->data[1], this->data[1]}; }
+		inline constexpr vec3<T> rbb() { return vec3<T>{this->data[0], this->data[2], this->data[2]}; }
+		inline constexpr vec3<T> grr() { return vec3<T>{this->data[1], this->data[0], this->data[0]}; }
+		inline constexpr vec3<T> gbb() { return vec3<T>{this->data[1], this->data[2], this->data[2]}; }
+		inline constexpr vec3<T> brr() { return vec3<T>{this->data[2], this->data[0], this->data[0]}; }
+		inline constexpr vec3<T> bgg() { return vec3<T>{this->data[2], this->data[1], this->data[1]}; }
+		inline constexpr vec3<T> rgr() { return vec3<T>{this->data[0], this->data[1], this->data[0]}; }
+		inline constexpr vec3<T> rbr() { return vec3<T>{this->data[0], this->data[2], this->data[0]}; }
+		inline constexpr vec3<T> grg() { return vec3<T>{this->data[1], this->data[0], this->data[1]}; }
+		inline constexpr vec3<T> gbg() { return vec3<T>{this->data[1], this->data[2], this->data[1]}; }
+		inline constexpr vec3<T> brb() { return vec3<T>{this->data[2], this->data[0], this->data[2]}; }
+		inline constexpr vec3<T> bgb() { return vec3<T>{this->data[2], this->data[1], this->data[2]}; }
+		inline constexpr vec3<T> rbg() { return vec3<T>{this->data[0], this->data[2], this->data[1]}; }
+		inline constexpr vec3<T> gbr() { return vec3<T>{this->data[1], this->data[2], this->data[0]}; }
+		inline constexpr vec3<T> brg() { return vec3<T>{this->data[2], this->data[0], this->data[1]}; }
+		inline constexpr vec3<T> grb() { return vec3<T>{this->data[1], this->data[0], this->data[2]}; }
+		inline constexpr vec3<T> rrr() const { return vec3<T>{this->data[0]}; }
+		inline constexpr vec3<T> ggg() const { return vec3<T>{this->data[1]}; }
+		inline constexpr vec3<T> bbb() const { return vec3<T>{this->data[2]}; }
+		inline constexpr vec3<T> bgr() const { return vec3<T>{this->data[2], this->data[1], this->data[0]}; }
+		inline constexpr vec3<T> rrg() const { return vec3<T>{this->data[0], this->data[0], this->data[1]}; }
+		inline constexpr vec3<T> rrb() const { return vec3<T>{this->data[0], this->data[0], this->data[2]}; }
+		inline constexpr vec3<T> ggr() const { return vec3<T>{this->data[1], this->data[1], this->data[0]}; }
+		inline constexpr vec3<T> ggb() const { return vec3<T>{this->data[0], this->data[1], this->data[2]}; }
+		inline constexpr vec3<T> bbr() const { return vec3<T>{this->data[2], this->data[2], this->data[0]}; }
+		inline constexpr vec3<T> bbg() const { return vec3<T>{this->data[2], this->data[2], this->data[1]}; }
+		inline constexpr vec3<T> rgg() const { return vec3<T>{this->data[0], this->data[1], this->data[1]}; }
+		inline constexpr vec3<T> rbb() const { return vec3<T>{this->data[0], this->data[2], this->data[2]}; }
+		inline constexpr vec3<T> grr() const { return vec3<T>{this->data[1], this->data[0], this->data[0]}; }
+		inline constexpr vec3<T> gbb() const { return vec3<T>{this->data[1], this->data[2], this->data[2]}; }
+		inline constexpr vec3<T> brr() const { return vec3<T>{this->data[2], this->data[0], this->data[0]}; }
+		inline constexpr vec3<T> bgg() const { return vec3<T>{this->data[2], this->data[1], this->data[1]}; }
+		inline constexpr vec3<T> rgr() const { return vec3<T>{this->data[0], this->data[1], this->data[0]}; }
+		inline constexpr vec3<T> rbr() const { return vec3<T>{this->data[0], this->data[2], this->data[0]}; }
+		inline constexpr vec3<T> grg() const { return vec3<T>{this->data[1], this->data[0], this->data[1]}; }
+		inline constexpr vec3<T> gbg() const { return vec3<T>{this->data[1], this->data[2], this->data[1]}; }
+		inline constexpr vec3<T> brb() const { return vec3<T>{this->data[2], this->data[0], this->data[2]}; }
+		inline constexpr vec3<T> bgb() const { return vec3<T>{this->data[2], this->data[1], this->data[2]}; }
+		inline constexpr vec3<T> rbg() const { return vec3<T>{this->data[0], this->data[2], this->data[1]}; }
+		inline constexpr vec3<T> gbr() const { return vec3<T>{this->data[1], this->data[2], this->data[0]}; }
+		inline constexpr vec3<T> brg() const { return vec3<T>{this->data[2], this->data[0], this->data[1]}; }
+		inline constexpr vec3<T> grb() const { return vec3<T>{this->data[1], this->data[0], this->data[2]}; }
 		
 		// 2-way Swizzling (sort of), 9 permutations
-		inline vec2<T> xx() { return vec2<T>{this->data[0], this->data[0]}; }
-		inline vec2<T> xy() { return vec2<T>{this->data[0], this->data[1]}; }
-		inline vec2<T> xz() { return vec2<T>{this->data[0], this->data[2]}; }
-		inline vec2<T> yy() { return vec2<T>{this->data[1], this->data[1]}; }
-		inline vec2<T> yx() { return vec2<T>{this->data[1], this->data[0]}; }
-		inline vec2<T> yz() { return vec2<T>{this->data[1], this->data[2]}; }
-		inline vec2<T> zz() { return vec2<T>{this->data[2], this->data[2]}; }
-		inline vec2<T> zx() { return vec2<T>{this->data[2], this->data[0]}; }
-		inline vec2<T> zy() { return vec2<T>{this->data[2], this->data[1]}; }
-		inline vec2<T> xx() const { return vec2<T>{this->data[0], this->data[0]}; }
-		inline vec2<T> xy() const { return vec2<T>{this->data[0], this->data[1]}; }
-		inline vec2<T> xz() const { return vec2<T>{this->data[0], this->data[2]}; }
-		inline vec2<T> yy() const { return vec2<T>{this->data[1], this->data[1]}; }
-		inline vec2<T> yx() const { return vec2<T>{this->data[1], this->data[0]}; }
-		inline vec2<T> yz() const { return vec2<T>{this->data[1], this->data[2]}; }
-		inline vec2<T> zz() const { return vec2<T>{this->data[2], this->data[2]}; }
-		inline vec2<T> zx() const { return vec2<T>{this->data[2], this->data[0]}; }
-		inline vec2<T> zy() const { return vec2<T>{this->data[2], this->data[1]}; }
+		inline constexpr vec2<T> xx() { return vec2<T>{this->data[0], this->data[0]}; }
+		inline constexpr vec2<T> xy() { return vec2<T>{this->data[0], this->data[1]}; }
+		inline constexpr vec2<T> xz() { return vec2<T>{this->data[0], this->data[2]}; }
+		inline constexpr vec2<T> yy() { return vec2<T>{this->data[1], this->data[1]}; }
+		inline constexpr vec2<T> yx() { return vec2<T>{this->data[1], this->data[0]}; }
+		inline constexpr vec2<T> yz() { return vec2<T>{this->data[1], this->data[2]}; }
+		inline constexpr vec2<T> zz() { return vec2<T>{this->data[2], this->data[2]}; }
+		inline constexpr vec2<T> zx() { return vec2<T>{this->data[2], this->data[0]}; }
+		inline constexpr vec2<T> zy() { return vec2<T>{this->data[2], this->data[1]}; }
+		inline constexpr vec2<T> xx() const { return vec2<T>{this->data[0], this->data[0]}; }
+		inline constexpr vec2<T> xy() const { return vec2<T>{this->data[0], this->data[1]}; }
+		inline constexpr vec2<T> xz() const { return vec2<T>{this->data[0], this->data[2]}; }
+		inline constexpr vec2<T> yy() const { return vec2<T>{this->data[1], this->data[1]}; }
+		inline constexpr vec2<T> yx() const { return vec2<T>{this->data[1], this->data[0]}; }
+		inline constexpr vec2<T> yz() const { return vec2<T>{this->data[1], this->data[2]}; }
+		inline constexpr vec2<T> zz() const { return vec2<T>{this->data[2], this->data[2]}; }
+		inline constexpr vec2<T> zx() const { return vec2<T>{this->data[2], this->data[0]}; }
+		inline constexpr vec2<T> zy() const { return vec2<T>{this->data[2], this->data[1]}; }
 		
 		inline constexpr vec3<T>() = default;
 		
@@ -194,84 +196,77 @@ namespace Iris
 		}
 		
 		/// Copy constructor
-		inline vec3<T>(vec3<T> const &other)
-		{
-			memcpy(&this->data[0], &other[0], sizeof(other.data));
-		}
+		inline constexpr vec3<T>(vec3<T> const &other) = default;
 		
 		/// Copy assignment operator
-		inline vec3<T> &operator=(vec3<T> const &other)
-		{
-			memcpy(&this->data[0], &other.data[0], sizeof(other.data));
-			return *this;
-		}
+		inline constexpr vec3<T> &operator=(vec3<T> const &other) = default;
 		
 		/// Subscript operator
-		inline T &operator[](size_t index)
+		inline constexpr T &operator[](size_t index)
 		{
 			return this->data[index];
 		}
 		
-		inline T const &operator[](size_t index) const
+		inline constexpr T const &operator[](size_t index) const
 		{
 			return this->data[index];
 		}
 		
 		/// Compare equality with another v3
-		inline bool operator==(vec3<T> const &other) const
+		inline constexpr bool operator==(vec3<T> const &other) const
 		{
 			return this->data[0] == other[0] && this->data[1] == other[1] && this->data[2] == other[2];
 		}
 		
 		/// Compare inequality with another v3
-		inline bool operator!=(vec3<T> const &other) const
+		inline constexpr bool operator!=(vec3<T> const &other) const
 		{
 			return this->data[0] != other[0] || this->data[1] != other[1] || this->data[2] != other[2];
 		}
 		
 		/// Add this v3 to another
-		inline vec3<T> operator+(vec3<T> const &other) const
+		inline constexpr vec3<T> operator+(vec3<T> const &other) const
 		{
 			return vec3<T>{this->data[0] + other[0], this->data[1] + other[1], this->data[2] + other[2]};
 		}
 		
 		/// Add a scalar number to this v3
-		inline vec3<T> operator+(T const &scalar) const
+		inline constexpr vec3<T> operator+(T const &scalar) const
 		{
 			return vec3<T>{static_cast<T>(this->data[0] + scalar), static_cast<T>(this->data[1] + scalar), static_cast<T>(this->data[2] + scalar)};
 		}
 		
 		/// Subtract this v3 from another
-		inline vec3<T> operator-(vec3<T> const &other) const
+		inline constexpr vec3<T> operator-(vec3<T> const &other) const
 		{
 			return vec3<T>{this->data[0] - other[0], this->data[1] - other[1], this->data[2] - other[2]};
 		}
 		
 		/// Subtract a scalar number from this v3
-		inline vec3<T> operator-(T const &scalar) const
+		inline constexpr vec3<T> operator-(T const &scalar) const
 		{
 			return vec3<T>{static_cast<T>(this->data[0] - scalar), static_cast<T>(this->data[1] - scalar), static_cast<T>(this->data[2] - scalar)};
 		}
 		
 		/// Negate this v3
-		inline vec3<T> operator-() const
+		inline constexpr vec3<T> operator-() const
 		{
 			return vec3<T>{-this->data[0], -this->data[1], -this->data[2]};
 		}
 		
 		/// Multiply this v3 with another
-		inline vec3<T> operator*(vec3<T> const &other) const
+		inline constexpr vec3<T> operator*(vec3<T> const &other) const
 		{
 			return vec3<T>{this->data[0] * other[0], this->data[1] * other[1], this->data[2] * other[2]};
 		}
 		
 		/// Multiply this v3 by a scalar number
-		inline vec3<T> operator*(T scalar) const
+		inline constexpr vec3<T> operator*(T scalar) const
 		{
 			return vec3<T>{static_cast<T>(this->data[0] * scalar), static_cast<T>(this->data[1] * scalar), static_cast<T>(this->data[2] * scalar)};
 		}
 		
-		inline vec3<T> operator*(quat<T> const &in)
+		inline constexpr vec3<T> operator*(quat<T> const &in)
 		{
 			vec3<T> q{in[0], in[1], in[2]};
 			vec3<T> w1 = this->cross(q) * static_cast<T>(2);
@@ -279,19 +274,19 @@ namespace Iris
 		}
 		
 		/// Divide this v3 by another
-		inline vec3<T> operator/(vec3<T> const &other) const
+		inline constexpr vec3<T> operator/(vec3<T> const &other) const
 		{
 			return vec3<T>{this->data[0] / other[0], this->data[1] / other[1], this->data[2] / other[2]};
 		}
 		
 		/// Divide this v3 by a scalar number
-		inline vec3<T> operator/(T const &scalar) const
+		inline constexpr vec3<T> operator/(T const &scalar) const
 		{
 			return vec3<T>{static_cast<T>(this->data[0] / scalar), static_cast<T>(this->data[1] / scalar), static_cast<T>(this->data[2] / scalar)};
 		}
 		
 		/// Compound add this v3 to another
-		inline vec3<T> operator+=(vec3<T> const &other)
+		inline constexpr vec3<T> operator+=(vec3<T> const &other)
 		{
 			this->data[0] += other[0];
 			this->data[1] += other[1];
@@ -300,7 +295,7 @@ namespace Iris
 		}
 		
 		/// Compound subtract this v3 from another
-		inline vec3<T> operator-=(vec3<T> const &other)
+		inline constexpr vec3<T> operator-=(vec3<T> const &other)
 		{
 			this->data[0] -= other[0];
 			this->data[1] -= other[1];
@@ -309,7 +304,7 @@ namespace Iris
 		}
 		
 		/// Compound multiply this v3 with another
-		inline vec3<T> operator*=(vec3<T> const &other)
+		inline constexpr vec3<T> operator*=(vec3<T> const &other)
 		{
 			this->data[0] *= other[0];
 			this->data[1] *= other[1];
@@ -318,7 +313,7 @@ namespace Iris
 		}
 		
 		/// Compound divide this v3 by another
-		inline vec3<T> operator/=(vec3<T> const &other)
+		inline constexpr vec3<T> operator/=(vec3<T> const &other)
 		{
 			this->data[0] /= other[0];
 			this->data[1] /= other[1];
@@ -327,7 +322,7 @@ namespace Iris
 		}
 		
 		/// Increment all values in this v3 (prefix)
-		inline vec3<T> &operator++()
+		inline constexpr vec3<T> &operator++()
 		{
 			this->data[0]++;
 			this->data[1]++;
@@ -336,7 +331,7 @@ namespace Iris
 		}
 		
 		/// Increment all values in this v3 (postfix)
-		inline vec3<T> &operator++(int)
+		inline constexpr vec3<T> operator++(int)
 		{
 			vec3<T> out = *this;
 			this->data[0]++;
@@ -346,7 +341,7 @@ namespace Iris
 		}
 		
 		/// Decrement all values in this v3 (prefix)
-		inline vec3<T> &operator--()
+		inline constexpr vec3<T> &operator--()
 		{
 			this->data[0]--;
 			this->data[1]--;
@@ -355,7 +350,7 @@ namespace Iris
 		}
 		
 		/// Decrement all values in this v3 (postfix)
-		inline vec3<T> &operator--(int)
+		inline constexpr vec3<T> operator--(int)
 		{
 			vec3<T> out = *this;
 			this->data[0]--;
@@ -365,7 +360,7 @@ namespace Iris
 		}
 		
 		/// Set all values individually
-		inline void set(T const &x, T const &y, T const &z)
+		inline constexpr void set(T const &x, T const &y, T const &z)
 		{
 			this->data[0] = x;
 			this->data[1] = y;
@@ -373,13 +368,13 @@ namespace Iris
 		}
 		
 		/// Set all values to one given value
-		inline void setAll(T const &value)
+		inline constexpr void setAll(T const &value)
 		{
 			this->set(value, value, value);
 		}
 		
 		/// Invert sign on all values
-		inline void invert()
+		inline constexpr void invert()
 		{
 			this->data[0] = -this->data[0];
 			this->data[1] = -this->data[1];
@@ -387,7 +382,7 @@ namespace Iris
 		}
 		
 		/// Get an inverted v3
-		inline vec3<T> inverse() const
+		inline constexpr vec3<T> inverse() const
 		{
 			return vec3<T>{-this->data[0], -this->data[1], -this->data[2]};
 		}
@@ -399,11 +394,11 @@ namespace Iris
 		}
 		
 		/// Get the dot product of this v3 and another
-		inline T dot(vec3<T> const &b) const
+		inline constexpr T dot(vec3<T> const &b) const
 		{ return this->data[0] * b[0] + this->data[1] * b[1] + this->data[2] * b[2]; }
 		
 		/// Get the cross product of this v3 and another
-		inline vec3<T> cross(vec3<T> const &b) const
+		inline constexpr vec3<T> cross(vec3<T> const &b) const
 		{
 			vec3<T> out;
 			out[0] = this->data[1] * b[2] - this->data[2] * b[1];
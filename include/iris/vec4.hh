@@ -1,6 +1,7 @@
 #pragma once
 
 #include <ctgmath>
+#include <cstring>
 
 namespace Iris
 {
@@ -15,65 +16,65 @@ namespace Iris
 		T data[4]{0, 0, 0, 0};
 		
 		/// Get a reference to one of the contained values
-		inline T &x() { return this->data[0]; }
-		inline T &y() { return this->data[1]; }
-		inline T &z() { return this->data[2]; }
-		inline T &w() { return this->data[3]; }
-		inline T const &x() const { return this->data[0]; }
-		inline T const &y() const { return this->data[1]; }
-		inline T const &z() const { return this->data[2]; }
-		inline T const &w() const { return this->data[3]; }
-		inline T &r() { return this->data[0]; }
-		inline T &g() { return this->data[1]; }
-		inline T &b() { return this->data[2]; }
-		inline T &a() { return this->data[3]; }
-		inline T const &r() const { return this->data[0]; }
-		inline T const &g() const { return this->data[1]; }
-		inline T const &b() const { return this->data[2]; }
-		inline T const &a() const { return this->data[3]; }
+		inline constexpr T &x() { return this->data[0]; }
+		inline constexpr T &y() { return this->data[1]; }
+		inline constexpr T &z() { return this->data[2]; }
+		inline constexpr T &w() { return this->data[3]; }
+		inline constexpr T const &x() const { return this->data[0]; }
+		inline constexpr T const &y() const { return this->data[1]; }
+		inline constexpr T const &z() const { return this->data[2]; }
+		inline constexpr T const &w() const { return this->data[3]; }
+		inline constexpr T &r() { return this->data[0]; }
+		inline constexpr T &g() { return this->data[1]; }
+		inline constexpr T &b() { return this->data[2]; }
+		inline constexpr T &a() { return this->data[3]; }
+		inline constexpr T const &r() const { return this->data[0]; }
+		inline constexpr T const &g() const { return this->data[1]; }
+		inline constexpr T const &b() const { return this->data[2]; }
+		inline constexpr T const &a() const { return this->data[3]; }
 		
 		//TODO do it
 		/// 4-way Swizzling (sort of), 256 permutations
 		
 		//TODO finish it
 		/// 3-way Swizzling (sort of), 64 permutations 
-		inline vec3<T> xyz() { return vec3<T>{this->data[0], this->data[1], this->data[2]}; }
+		inline constexpr vec3<T> xyz() { return vec3<T>{this->data[0], this->data[1], this->data[2]}; }
 		
-		inline vec3<T> xyz() const { return vec3<T>{this->data[0], this->data[1], this->data[2]}; }
+		inline constexpr vec3<T> xyz() const { return vec3<T>{this->data[0], this->data[1], this->data[2]}; }
 		
 		/// 2-way Swizzling (sort of), 16 permutations
-		inline vec2<T> xx() { return vec2<T>{this->data[0], this->data[0]}; }
-		inline vec2<T> yy() { return vec2<T>{this->data[1], this->data[1]}; }
-		inline vec2<T> zz() { return vec2<T>{this->data[2], this->data[2]}; }
-		inline vec2<T> ww() { return vec2<T>{this->data[3], this->data[3]}; }
-		inline vec2<T> xy() { return vec2<T>{this->data[0], this->data[1]}; }
-		inline vec2<T> xz() { return vec2<T>{this->data[0], this->data[2]}; }
-		inline vec2<T> xw() { return vec2<T>{this->data[0], this->data[3]}; }
-		inline vec2<T> yx() { return vec2<T>{this->data[1], this->data[0]}; }
-		inline vec2<T> yz() { return vec2<T>{this->data[1], this->data[2]}; }
-		inline vec2<T> yw() { return vec2<T>{this->data[1], this->data[3]}; }
-		inline vec2<T> zx() { return vec2<T>{this->data[2], this->data[0]}; }
-		inline vec2<T> zy() { return vec2<T>{this->data[2], this->data[1]}; }
-		inline vec2<T> zw() { return vec2<T>{this->data[2], this->data[3]}; }
-		inline vec2<T> wx() { return vec2<T>{this->data[3], this->data[0]}; }
-		inline vec2<T> wy() { return vec2<T>{this->data[3], this->data[1]}; }
-		inline vec2<T> wz() { return vec2<T>{this->data[3], this->data[2]}; }
-		inline vec2<T> xx() const { return vec2<T>{this->data[0], this->data[0]}; }
-		inline vec2<T> yy() const { return vec2<T>{this->data[1], this->data[1]}; }
-		inline vec2<T> zz() const { return vec2<T>{this->data[2], this->data[2]}; }
-		inline vec2<T> ww() const { return vec2<T>{this->data[3], this->data[3]}; }
-		inline vec2<T> xy() const { return vec2<T>{this->data[0], this->data[1]}; }
-		inline vec2<T> xz() const { return vec2<T>{this->data[0], this->data[2]}; }
-		inline vec2<T> xw() const { return vec2<T>{this->data[0], this->data[3]}; }
-		inline vec2<T> yx() const { return vec2<T>{this->data[1], this->data[0]}; }
-		inline vec2<T> yz() const { return vec2<T>{this->data[1], this->data[2]}; }
-		inline vec2<T> yw() const { return vec2<T>{this->data[1], this->data[3]}; }
-		inline vec2<T> zx() const { return vec2<T>{this->data[2], this->data[0]}; }
-		inline vec2<T> zy() const { return vec2<T>{this->data[2], this->data[1]}; }
-		inline vec2<T> zw() const { return vec2<T>{this->data[2], this->data[3]}; }
-		inline vec2<T> wx() const { return vec2<T>{this->data[3], this->data[0]}; }
-		inline vec2<T> wy() const { return vec2<T>{this->data[3], this->data[1]}; }
-		inline vec2<T> wz() const { return vec2<T>{this->data[3], this->data[2]}; }
+		inline constexpr vec2<T> xx() { return vec2<T>{this->data[0], this->data[0]}; }
+		inline constexpr vec2<T> yy() { return vec2<T>{this->data[1], this->data[1]}; }
+		inline constexpr vec2<T> zz() { return vec2<T>{this->data[2], this->data[2]}; }
+		inline constexpr vec2<T> ww() { return vec2<T>{this->data[3], this->data[3]}; }
+		inline constexpr vec2<T> xy() { return vec2<T>{this->data[0], this->data[1]}; }
+		inline constexpr vec2<T> xz() { return vec2<T>{this->data[0], this->data[2]}; }
+		inline constexpr vec2<T> xw() { return vec2<T>{this->data[0], this->data[3]}; }
+		inline constexpr vec2<T> yx() { return vec2<T>{this->data[1], this->data[0]}; }
+		inline constexpr vec2<T> yz() { return vec2<T>{this->data[1], this->data[2]}; }
+		inline constexpr vec2<T> yw() { return vec2<T>{this->data[1], this->data[3]}; }
+		inline constexpr vec2<T> zx() { return vec2<T>{this->data[2], this->data[0]}; }
+		inline constexpr vec2<T> zy() { return vec2<T>{this->data[2], this->data[1]}; }
+		inline constexpr vec2<T> zw() { return vec2<T>{this->data[2], this->data[3]}; }
+		inline constexpr vec2<T> wx() { return vec2<T>{this->data[3], this->data[0]}; }
+		inline constexpr vec2<T> wy() { return vec2<T>{this->data[3], this->data[1]}; }
+		inline constexpr vec2<T> wz() { return vec2<T>{this->data[3], this->data[2]}; }
+		inline constexpr vec2<T> xx() const { return vec2<T>{this->data[0], this->data[0]}; }
+		inline constexpr vec2<T> yy() const { return vec2<T>{this->data[1], this->data[1]}; }
+		inline constexpr vec2<T> zz() const { return vec2<T>{this->data[2], this->data[2]}; }
+		inline constexpr vec2<T> ww() const { return vec2<T>{this->data[3], this->data[3]}; }
+		inline constexpr vec2<T> xy() const { return vec2<T>{this->data[0], this->data[1]}; }
+		inline constexpr vec2<T> xz() const { return vec2<T>{this->data[0], this->data[2]}; }
+		inline constexpr vec2<T> xw() const { return vec2<T>{this->data[0], this->data[3]}; }
+		inline constexpr vec2<T> yx() const { return vec2<T>{this->data[1], this->data[0]}; }
+		inline constexpr vec2<T> yz() const { return vec2<T>{this->data[1], this->data[2]}; }
+		inline constexpr vec2<T> yw() const { return vec2<T>{this->data[1], this->data[3]}; }
+		inline constexpr vec2<T> zx() const { return vec2<T>{this->data[2], this->data[0]}; }
+		inline constexpr vec2<T> zy() const { return vec2<T>{this->data[2], this->data[1]}; }
+		inline constexpr vec2<T> zw() const { return vec2<T>{this->data[2], this->data[3]}; }
+		inline constexpr vec2<T> wx() const { return vec2<T>{this->data[3], this->data[0]}; }
+		inline constexpr vec2<T> wy() const { return vec2<T>{this->data[3], this->data[1]}; }
+		inline constexpr vec2<T> wz() const { return vec2<T>{this->data[3], this->data[2]}; }
 		
 		inline constexpr vec4<T>() = default;
 		
@@ -127,84 +128,77 @@ namespace Iris
 		}
 		
 		/// Copy constructor
-		inline vec4<T>(vec4<T> const &other)
-		{
-			memcpy(&this->data[0], &other.data[0], sizeof(other.data));
-		}
+		inline constexpr vec4<T>(vec4<T> const &other) = default;
 		
 		/// Copy assignment operator
-		inline vec4<T> &operator=(vec4<T> const &other)
-		{
-			memcpy(&this->data[0], &other.data[0], sizeof(other.data));
-			return *this;
-		}
+		inline constexpr vec4<T> &operator=(vec4<T> const &other) = default;
 		
 		/// Subscript operator
-		inline T &operator[](size_t index)
+		inline constexpr T &operator[](size_t index)
 		{
 			return this->data[index];
 		}
 		
-		inline T const &operator[](size_t index) const
+		inline constexpr T const &operator[](size_t index) const
 		{
 			return this->data[index];
 		}
 		
 		/// Compare equality with another v4
-		inline bool operator==(vec4<T> const &other) const
+		inline constexpr bool operator==(vec4<T> const &other) const
 		{
 			return this->data[0] == other[0] && this->data[1] == other[1] && this->data[2] == other[2] && this->data[3] == other[3];
 		}
 		
 		/// Compare inequality with another v4
-		inline bool operator!=(vec4<T> const &other) const
+		inline constexpr bool operator!=(vec4<T> const &other) const
 		{
 			return this->data[0] != other[0] || this->data[1] != other[1] || this->data[2] != other[2] || this->data[3] != other[3];
 		}
 		
 		/// Add this v4 to another
-		inline vec4<T> operator+(vec4<T> const &other) const
+		inline constexpr vec4<T> operator+(vec4<T> const &other) const
 		{
 			return vec4<T>{this->data[0] + other[0], this->data[1] + other[1], this->data[2] + other[2], this->data[3] + other[3]};
 		}
 		
 		/// Add a scalar number to this v4
-		inline vec4<T> operator+(T const &scalar) const
+		inline constexpr vec4<T> operator+(T const &scalar) const
 		{
 			return vec4<T>{static_cast<T>(this->data[0] + scalar), static_cast<T>(this->data[1] + scalar), static_cast<T>(this->data[2] + scalar), static_cast<T>(this->data[3] + scalar)};
 		}
 		
 		/// Subtract this v4 from another
-		inline vec4<T> operator-(vec4<T> const &other) const
+		inline constexpr vec4<T> operator-(vec4<T> const &other) const
 		{
 			return vec4<T>{this->data[0] - other[0], this->data[1] - other[1], this->data[2] - other[2], this->data[3] - other[3]};
 		}
 		
 		/// Subtract a scalar number from this v4
-		inline vec4<T> operator-(T const &scalar) const
+		inline constexpr vec4<T> operator-(T const &scalar) const
 		{
 			return vec4<T>{static_cast<T>(this->data[0] - scalar), static_cast<T>(this->data[1] - scalar), static_cast<T>(this->data[2] - scalar), static_cast<T>(this->data[3] - scalar)};
 		}
 		
 		/// Negate this v4
-		inline vec4<T> operator-() const
+		inline constexpr vec4<T> operator-() const
 		{
 			return vec4<T>{-this->data[0], -this->data[1], -this->data[2], -this->data[3]};
 		}
 		
 		/// Multiply this v4 with another
-		inline vec4<T> operator*(vec4<T> const &other) const
+		inline constexpr vec4<T> operator*(vec4<T> const &other) const
 		{
 			return vec4<T>{this->data[0] * other[0], this->data[1] * other[1], this->data[2] * other[2], this->data[3] * other[3]};
 		}
 		
 		/// Multiply this v4 by a scalar number
-		inline vec4<T> operator*(T scalar) const
+		inline constexpr vec4<T> operator*(T scalar) const
 		{
 			return vec4<T>{static_cast<T>(this->data[0] * scalar), static_cast<T>(this->data[1] * scalar), static_cast<T>(this->data[2] * scalar), static_cast<T>(this->data[3] * scalar)};
 		}
 		
-		inline vec4<T> operator*(mat4x4<T> const &mat)
+		inline constexpr vec4<T> operator*(mat4x4<T> const &mat)
 		{
 			return vec4<T>{
 					this->data[0] * mat[0][0] + this->data[1] * mat[0][1] + this->data[2] * mat[0][2] + this->data[3] * mat[0][3],
@@ -215,19 +209,19 @@ namespace Iris
 		}
 		
 		/// Divide this v4 by another
-		inline vec4<T> operator/(vec4<T> const &other) const
+		inline constexpr vec4<T> operator/(vec4<T> const &other) const
 		{
 			return vec4<T>{this->data[0] / other[0], this->data[1] / other[1], this->data[2] / other[2], this->data[3] / other[3]};
 		}
 		
 		/// Divide this v4 by a scalar number
-		inline vec4<T> operator/(T const &scalar) const
+		inline constexpr vec4<T> operator/(T const &scalar) const
 		{
 			return vec4<T>{static_cast<T>(this->data[0] / scalar), static_cast<T>(this->data[1] / scalar), static_cast<T>(this->data[2] / scalar), static_cast<T>(this->data[3] / scalar)};
 		}
 		
 		/// Compound add this v4 to another
-		inline vec4<T> operator+=(vec4<T> const &other)
+		inline constexpr vec4<T> operator+=(vec4<T> const &other)
 		{
 			this->data[0] += other[0];
 			this->data[1] += other[1];
@@ -237,7 +231,7 @@ namespace Iris
 		}
 		
 		/// Compound subtract this v4 from another
-		inline vec4<T> operator-=(vec4<T> const &other)
+		inline constexpr vec4<T> operator-=(vec4<T> const &other)
 		{
 			this->data[0] -= other[0];
 			this->data[1] -= other[1];
@@ -247,7 +241,7 @@ namespace Iris
 		}
 		
 		/// Compound multiply this v4 with another
-		inline vec4<T> operator*=(vec4<T> const &other)
+		inline constexpr vec4<T> operator*=(vec4<T> const &other)
 		{
 			this->data[0] *= other[0];
 			this->data[1] *= other[1];
@@ -257,7 +251,7 @@ namespace Iris
 		}
 		
 		/// Compound divide this v4 by another
-		inline vec4<T> operator/=(vec4<T> const &other)
+		inline constexpr vec4<T> operator/=(vec4<T> const &other)
 		{
 			this->data[0] /= other[0];
 			this->data[1] /= other[1];
@@ -267,7 +261,7 @@ namespace Iris
 		}
 		
 		/// Increment all values in this v4 (prefix)
-		inline vec4<T> &operator++()
+		inline constexpr vec4<T> &operator++()
 		{
 			this->data[0]++;
 			this->data[1]++;
@@ -277,7 +271,7 @@ namespace Iris
 		}
 		
 		/// Increment all values in this v4 (postfix)
-		inline vec4<T> &operator++(int)
+		inline constexpr vec4<T> operator++(int)
 		{
 			vec4<T> out = *this;
 			this->data[0]++;
@@ -288,7 +282,7 @@ namespace Iris
 		}
 		
 		/// Decrement all values in this v4 (prefix)
-		inline vec4<T> &operator--()
+		inline constexpr vec4<T> &operator--()
 		{
 			this->data[0]--;
 			this->data[1]--;
@@ -298,7 +292,7 @@ namespace Iris
 		}
 		
 		/// Decrement all values in this v4 (postfix)
-		inline vec4<T> &operator--(int)
+		inline constexpr vec4<T> operator--(int)
 		{
 			vec4<T> out = *this;
 			this->data[0]--;
@@ -309,7 +303,7 @@ namespace Iris
 		}
 		
 		/// Set all values individually
-		inline void set(T x, T y, T z, T w)
+		inline constexpr void set(T x, T y, T z, T w)
 		{
 			this->data[0] = x;
 			this->data[1] = y;
@@ -318,13 +312,13 @@ namespace Iris
 		}
 		
 		/// Set all values to one given value
-		inline void setAll(T value)
+		inline constexpr void setAll(T value)
 		{
 			this->set(value, value, value, value);
 		}
 		
 		/// Invert sign on all values
-		inline void invert()
+		inline constexpr void invert()
 		{
 			this->data[0] = -this->data[0];
 			this->data[1] = -this->data[1];
@@ -333,7 +327,7 @@ namespace Iris
 		}
 		
 		/// Get an inverted v4
-		inline vec4<T> inverse() const
+		inline constexpr vec4<T> inverse() const
 		{
 			return vec4<T>{-this->data[0], -this->data[1], -this->data[2], -this->data[3]};
 		}
@@ -345,9 +339,9 @@ namespace Iris
 		}
 		
 		/// Get the dot product of this v4 and another
-		inline T dot(vec4<T> const &b) const
+		inline constexpr T dot(vec4<T> const &b) const
 		{
-			return this->data[3] * b.w + this->data[0] * b.x + this->data[1] * b.y + this->data[2] * b.z;
+			return this->data[3] * b.w() + this->data[0] * b.x() + this->data[1] * b.y() + this->data[2] * b.z();
 		}
 		
 		/// Normalize this v4
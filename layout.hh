@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <iris/vec2.hh>
+
+/// What a layout knows about each child.  pos is the top left corner with y up like Widget::pos, arrange() writes pos and size
+struct LayoutItem
+{
+	IR::vec2<int32_t> minSize, pos, size;
+	float stretch = 1;
+};
+
+struct Layout
+{
+protected:
+	Layout() = default;
+	
+	/// Split free space between items by their stretch, the shares always add up to exactly free
+	template <typename F> inline static void distribute(int32_t free, LayoutItem *items, size_t count, F const &apply)
+	{
+		float totalStretch = 0;
+		for(size_t i = 0; i < count; i++) totalStretch += std::max(items[i].stretch, 0.0f);
+		float accumulated = 0;
+		int32_t given = 0;
+		for(size_t i = 0; i < count; i++)
+		{
+			accumulated += std::max(items[i].stretch, 0.0f);
+			int32_t upTo = free > 0 && totalStretch > 0 ? static_cast<int32_t>(static_cast<float>(free) * (accumulated / totalStretch)) : 0;
+			apply(items[i], upTo - given);
+			given = upTo;
+		}
+	}
+
+public:
+	virtual ~Layout() = default;
+	
+	/// Place count items inside the rect with its top left corner at pos
+	virtual void arrange(IR::vec2<int32_t> const &pos, IR::vec2<int32_t> const &size, LayoutItem *items, size_t count) = 0;
+	
+	int32_t margin = 0, spacing = 0;
+};
+
+/*Layouts--------------------------------------------------------------------------------------------------------------------------------*/
+
+/// Stacks items top to bottom, each as wide as the layout, height left over is shared by stretch
+struct VBoxLayout : public Layout
+{
+	inline void arrange(IR::vec2<int32_t> const &pos, IR::vec2<int32_t> const &size, LayoutItem *items, size_t count) override
+	{
+		if(!count) return;
+		int32_t width = size.x() - 2 * this->margin, used = this->spacing * static_cast<int32_t>(count - 1);
+		for(size_t i = 0; i < count; i++) used += items[i].minSize.y();
+		int32_t y = pos.y() - this->margin;
+		distribute(size.y() - 2 * this->margin - used, items, count, [&](LayoutItem &item, int32_t extra)
+		{
+			item.size = {std::max(width, item.minSize.x()), item.minSize.y() + extra};
+			item.pos = {pos.x() + this->margin, y};
+			y -= item.size.y() + this->spacing;
+		});
+	}
+};
+
+/// Places items left to right, each as tall as the layout, width left over is shared by stretch
+struct HBoxLayout : public Layout
+{
+	inline void arrange(IR::vec2<int32_t> const &pos, IR::vec2<int32_t> const &size, LayoutItem *items, size_t count) override
+	{
+		if(!count) return;
+		int32_t height = size.y() - 2 * this->margin, used = this->spacing * static_cast<int32_t>(count - 1);
+		for(size_t i = 0; i < count; i++) used += items[i].minSize.x();
+		int32_t x = pos.x() + this->margin;
+		distribute(size.x() - 2 * this->margin - used, items, count, [&](LayoutItem &item, int32_t extra)
+		{
+			item.size = {item.minSize.x() + extra, std::max(height, item.minSize.y())};
+			item.pos = {x, pos.y() - this->margin};
+			x += item.size.x() + this->spacing;
+		});
+	}
+};
+
+/// Places items left to right and wraps onto a new row when one is full, width left over in a row is shared by stretch
+struct FlexBoxLayout : public Layout
+{
+	inline void arrange(IR::vec2<int32_t> const &pos, IR::vec2<int32_t> const &size, LayoutItem *items, size_t count) override
+	{
+		int32_t width = size.x() - 2 * this->margin, y = pos.y() - this->margin;
+		for(size_t first = 0; first < count;)
+		{
+			size_t last = first;
+			int32_t used = items[first].minSize.x(), rowHeight = items[first].minSize.y();
+			while(last + 1 < count && used + this->spacing + items[last + 1].minSize.x() <= width)
+			{
+				last++;
+				used += this->spacing + items[last].minSize.x();
+				rowHeight = std::max(rowHeight, items[last].minSize.y());
+			}
+			int32_t x = pos.x() + this->margin;
+			distribute(width - used, items + first, last - first + 1, [&](LayoutItem &item, int32_t extra)
+			{
+				item.size = {item.minSize.x() + extra, rowHeight};
+				item.pos = {x, y};
+				x += item.size.x() + this->spacing;
+			});
+			y -= rowHeight + this->spacing;
+			first = last + 1;
+		}
+	}
+};
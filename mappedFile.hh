@@ -0,0 +1,128 @@
+#pragma once
+
+#include <string>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/// A whole file mapped read only into memory, its pages are read in by the OS as they're touched rather than copied up front
+struct MappedFile final
+{
+	inline MappedFile() = default;
+	
+	inline explicit MappedFile(std::string const &filePath)
+	{
+		this->open(filePath);
+	}
+	
+	inline MappedFile(MappedFile &&other) noexcept
+	{
+		*this = std::move(other);
+	}
+	
+	inline MappedFile &operator=(MappedFile &&other) noexcept
+	{
+		if(this == &other) return *this;
+		this->close();
+		this->bytes = other.bytes;
+		this->length = other.length;
+		other.bytes = nullptr;
+		other.length = 0;
+		return *this;
+	}
+	
+	MappedFile(MappedFile const &) = delete;
+	MappedFile &operator=(MappedFile const &) = delete;
+	
+	inline ~MappedFile()
+	{
+		this->close();
+	}
+	
+	/// Map filePath, false if it can't be opened.  Empty files open with no data
+	inline bool open(std::string const &filePath)
+	{
+		this->close();
+#if defined(_WIN32)
+		HANDLE file = CreateFileA(filePath.data(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if(file == INVALID_HANDLE_VALUE)
+		{
+			printf("Error opening file %s\n", filePath.data());
+			return false;
+		}
+		LARGE_INTEGER size;
+		GetFileSizeEx(file, &size);
+		this->length = static_cast<size_t>(size.QuadPart);
+		if(this->length)
+		{
+			HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if(mapping)
+			{
+				this->bytes = static_cast<unsigned char const *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+				CloseHandle(mapping);
+			}
+		}
+		CloseHandle(file);
+#else
+		int file = ::open(filePath.data(), O_RDONLY);
+		if(file < 0)
+		{
+			printf("Error opening file %s\n", filePath.data());
+			return false;
+		}
+		struct stat info;
+		this->length = fstat(file, &info) == 0 ? static_cast<size_t>(info.st_size) : 0;
+		if(this->length)
+		{
+			void *mapped = mmap(nullptr, this->length, PROT_READ, MAP_PRIVATE, file, 0);
+			this->bytes = mapped == MAP_FAILED ? nullptr : static_cast<unsigned char const *>(mapped);
+		}
+		::close(file);
+#endif
+		if(this->length && !this->bytes)
+		{
+			printf("Error mapping file %s\n", filePath.data());
+			this->length = 0;
+			return false;
+		}
+		return true;
+	}
+	
+	inline void close()
+	{
+		if(!this->bytes) return;
+#if defined(_WIN32)
+		UnmapViewOfFile(this->bytes);
+#else
+		munmap(const_cast<unsigned char *>(this->bytes), this->length);
+#endif
+		this->bytes = nullptr;
+		this->length = 0;
+	}
+	
+	inline unsigned char const *data() const
+	{
+		return this->bytes;
+	}
+	
+	inline size_t size() const
+	{
+		return this->length;
+	}
+
+private:
+	unsigned char const *bytes = nullptr;
+	size_t length = 0;
+};
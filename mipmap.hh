@@ -0,0 +1,267 @@
+#pragma once
+
+#include "util.hh"
+
+#include <vector>
+#include <cmath>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <iris/simd.hh>
+
+/// How MipChain filters each level from the one before it.  BOX averages the texels a level's texel covers,
+/// LANCZOS is a 2 lobe Lanczos window over twice that, sharper and slower
+enum struct MipFilter
+{
+	BOX, LANCZOS
+};
+
+/// Every mip level of an RGB8 or RGBA8 image built on the CPU, level 0 is the image itself.
+/// Levels are filtered in linear light when the image is srgb, and color is weighted by alpha so transparent texels don't darken edges.
+/// The filter is separable and runs the 4 channels of a texel at once in iris' SIMD lanes, give build() a pool to split each pass's rows across it
+struct MipChain
+{
+	struct Level
+	{
+		uint32_t width, height;
+		size_t offset;
+	};
+	
+	/// Levels down to 1x1 for an image of width x height, halving and rounding down like GL
+	inline static uint32_t levelCount(uint32_t width, uint32_t height)
+	{
+		uint32_t out = 1;
+		for(uint32_t size = std::max(width, height); size > 1; size >>= 1) out++;
+		return out;
+	}
+	
+	/// Build from tightly packed rows of channels bytes per texel, 3 or 4, with row 0 at the top.
+	/// Meant for load time on a worker, pool may be any pool including the one build() runs on, the calling thread takes rows too
+	inline void build(unsigned char const *texels, uint32_t width, uint32_t height, uint32_t channels, bool srgb, MipFilter filter = MipFilter::BOX, WorkerPool *pool = nullptr)
+	{
+		this->levels.clear();
+		this->data.clear();
+		this->channels = channels;
+		this->srgb = srgb;
+		if(!width || !height || (channels != 3 && channels != 4)) return;
+		uint32_t count = levelCount(width, height);
+		size_t total = 0;
+		for(uint32_t i = 0; i < count; i++)
+		{
+			Level level {std::max(width >> i, 1u), std::max(height >> i, 1u), total};
+			this->levels.push_back(level);
+			total += static_cast<size_t>(level.width) * level.height * channels;
+		}
+		this->data.resize(total);
+		std::copy(texels, texels + static_cast<size_t>(width) * height * channels, this->data.begin());
+		
+		//Linear, alpha weighted RGBA of the last level and the horizontally filtered rows of the next
+		std::vector<float> current(static_cast<size_t>(width) * height * 4), across;
+		float const *decode = srgb ? srgbToLinear() : unormToFloat();
+		parallelRows(pool, height, [&](uint32_t row)
+		{
+			for(uint32_t x = 0; x < width; x++)
+			{
+				unsigned char const *in = &texels[(static_cast<size_t>(row) * width + x) * channels];
+				float *out = &current[(static_cast<size_t>(row) * width + x) * 4];
+				out[3] = channels == 4 ? unormToFloat()[in[3]] : 1;
+				for(uint32_t c = 0; c < 3; c++) out[c] = decode[in[c]] * out[3];
+			}
+		});
+		std::vector<float> next;
+		std::vector<Tap> tapsX, tapsY;
+		for(uint32_t i = 1; i < count; i++)
+		{
+			Level const &from = this->levels[i - 1], &to = this->levels[i];
+			size_t spanX = taps(from.width, to.width, filter, tapsX), spanY = taps(from.height, to.height, filter, tapsY);
+			across.resize(static_cast<size_t>(to.width) * from.height * 4);
+			next.resize(static_cast<size_t>(to.width) * to.height * 4);
+			parallelRows(pool, from.height, [&](uint32_t row)
+			{
+				for(uint32_t x = 0; x < to.width; x++) convolve(&current[static_cast<size_t>(row) * from.width * 4], 4, &tapsX[x * spanX], spanX, &across[(static_cast<size_t>(row) * to.width + x) * 4]);
+			});
+			parallelRows(pool, to.height, [&](uint32_t row)
+			{
+				size_t stride = static_cast<size_t>(to.width) * 4;
+				for(uint32_t x = 0; x < to.width; x++) convolve(&across[x * 4], stride, &tapsY[row * spanY], spanY, &next[(static_cast<size_t>(row) * to.width + x) * 4]);
+				this->encodeRow(&next[row * stride], to.width, &this->data[to.offset + static_cast<size_t>(row) * to.width * channels]);
+			});
+			std::swap(current, next);
+		}
+	}
+	
+	/// The smallest level still at least width x height, a widget drawn that size only samples it and the levels after it
+	inline uint32_t levelFor(uint32_t width, uint32_t height) const
+	{
+		uint32_t out = 0;
+		while(out + 1 < this->levels.size() && this->levels[out + 1].width >= width && this->levels[out + 1].height >= height) out++;
+		return out;
+	}
+	
+	inline unsigned char const *texels(uint32_t level) const
+	{
+		return &this->data[this->levels[level].offset];
+	}
+	
+	inline unsigned char *texels(uint32_t level)
+	{
+		return &this->data[this->levels[level].offset];
+	}
+	
+	/// Bytes of firstLevel and every level after it, what uploading from firstLevel costs
+	inline size_t bytes(uint32_t firstLevel = 0) const
+	{
+		return firstLevel < this->levels.size() ? this->data.size() - this->levels[firstLevel].offset : 0;
+	}
+	
+	std::vector<Level> levels;
+	uint32_t channels = 4;
+	bool srgb = false;
+
+private:
+	using Lanes = Iris::simd::Native;
+	
+	/// A source texel and its weight in an output texel
+	struct Tap
+	{
+		uint32_t index;
+		float weight;
+	};
+	
+	inline static float const *unormToFloat()
+	{
+		static float const *table = []
+		{
+			static float out[256];
+			for(uint32_t i = 0; i < 256; i++) out[i] = static_cast<float>(i) / 255.0f;
+			return out;
+		}();
+		return table;
+	}
+	
+	inline static float const *srgbToLinear()
+	{
+		static float const *table = []
+		{
+			static float out[256];
+			for(uint32_t i = 0; i < 256; i++)
+			{
+				float value = static_cast<float>(i) / 255.0f;
+				out[i] = value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+			}
+			return out;
+		}();
+		return table;
+	}
+	
+	static size_t constexpr encodeSteps = 4096;
+	
+	/// sRGB bytes of linear values in steps of 1/encodeSteps
+	inline static unsigned char const *linearToSrgb()
+	{
+		static unsigned char const *table = []
+		{
+			static unsigned char out[encodeSteps + 1];
+			for(size_t i = 0; i <= encodeSteps; i++)
+			{
+				float value = static_cast<float>(i) / encodeSteps;
+				value = value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1 / 2.4f) - 0.055f;
+				out[i] = static_cast<unsigned char>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+			}
+			return out;
+		}();
+		return table;
+	}
+	
+	inline static float lanczos(float x)
+	{
+		x = std::abs(x);
+		if(x < 1e-5f) return 1;
+		if(x >= 2) return 0;
+		float pi = 3.14159265f * x;
+		return 2 * std::sin(pi) * std::sin(pi / 2) / (pi * pi);
+	}
+	
+	/// The taps of every output texel along an axis of from texels filtered to to, span of them each, normalized and clamped to the edge
+	inline static size_t taps(uint32_t from, uint32_t to, MipFilter filter, std::vector<Tap> &out)
+	{
+		float scale = static_cast<float>(from) / static_cast<float>(to), support = filter == MipFilter::BOX ? scale / 2 : scale * 2;
+		size_t span = static_cast<size_t>(std::ceil(support * 2)) + 1;
+		out.assign(span * to, {0, 0});
+		for(uint32_t i = 0; i < to; i++)
+		{
+			float center = (static_cast<float>(i) + 0.5f) * scale, sum = 0;
+			int32_t first = static_cast<int32_t>(std::floor(center - support));
+			Tap *taps = &out[i * span];
+			for(size_t t = 0; t < span; t++)
+			{
+				int32_t source = first + static_cast<int32_t>(t);
+				float weight;
+				if(filter == MipFilter::BOX) weight = std::max(std::min(static_cast<float>(source + 1), center + support) - std::max(static_cast<float>(source), center - support), 0.0f);
+				else weight = lanczos((static_cast<float>(source) + 0.5f - center) / scale);
+				taps[t] = {static_cast<uint32_t>(std::clamp(source, 0, static_cast<int32_t>(from) - 1)), weight};
+				sum += weight;
+			}
+			for(size_t t = 0; t < span; t++) taps[t].weight /= sum;
+		}
+		return span;
+	}
+	
+	/// One output texel, the sum of its taps' RGBA texels from in, stride floats apart
+	inline static void convolve(float const *in, size_t stride, Tap const *taps, size_t span, float *out)
+	{
+		Lanes::f32x4 sum = Lanes::set1(0);
+		for(size_t t = 0; t < span; t++) if(taps[t].weight != 0) sum = Lanes::madd(Lanes::load(&in[taps[t].index * stride]), Lanes::set1(taps[t].weight), sum);
+		Lanes::store(out, sum);
+	}
+	
+	/// Undo the alpha weighting and gamma of a row of filtered texels into bytes
+	inline void encodeRow(float const *in, uint32_t width, unsigned char *out) const
+	{
+		unsigned char const *encode = linearToSrgb();
+		for(uint32_t x = 0; x < width; x++, in += 4, out += this->channels)
+		{
+			float alpha = std::clamp(in[3], 0.0f, 1.0f), unweight = alpha > 0 ? 1 / alpha : 0;
+			for(uint32_t c = 0; c < 3; c++)
+			{
+				float value = std::clamp(in[c] * unweight, 0.0f, 1.0f);
+				out[c] = this->srgb ? encode[static_cast<size_t>(value * encodeSteps + 0.5f)] : static_cast<unsigned char>(value * 255.0f + 0.5f);
+			}
+			if(this->channels == 4) out[3] = static_cast<unsigned char>(alpha * 255.0f + 0.5f);
+		}
+	}
+	
+	/// Run job on every row in [0, rows), split across pool and the calling thread
+	template <typename F> inline static void parallelRows(WorkerPool *pool, uint32_t rows, F const &job)
+	{
+		uint32_t constexpr chunk = 16;
+		uint32_t chunks = (rows + chunk - 1) / chunk;
+		if(!pool || chunks < 2)
+		{
+			for(uint32_t row = 0; row < rows; row++) job(row);
+			return;
+		}
+		//Workers that only get to their job after the rows are done must find nothing to do, so the counters outlive this call
+		struct Progress
+		{
+			std::atomic<uint32_t> next {0}, done {0};
+		};
+		SP<Progress> progress = MS<Progress>();
+		auto work = [progress, rows, chunks, &job]
+		{
+			for(uint32_t at = progress->next++; at < chunks; at = progress->next++)
+			{
+				for(uint32_t row = at * chunk; row < std::min(rows, (at + 1) * chunk); row++) job(row);
+				progress->done++;
+			}
+		};
+		size_t helpers = std::min<size_t>(pool->threadCount(), chunks - 1);
+		for(size_t i = 0; i < helpers; i++) pool->enqueue(work);
+		work();
+		while(progress->done.load() < chunks) std::this_thread::yield();
+	}
+	
+	std::vector<unsigned char> data;
+};
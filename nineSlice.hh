@@ -0,0 +1,67 @@
+#pragma once
+
+#include "renderTypes.hh"
+
+#include <cstddef>
+#include <cstdint>
+
+/// Texels kept unstretched along each edge of a nine-slice image
+struct NineSliceInsets
+{
+	uint32_t left = 0, top = 0, right = 0, bottom = 0;
+};
+
+/// An image drawn at any size from one texture.  The corners keep their size, the edges stretch along their length and the center stretches both ways.
+/// width and height are the image's size in texels and uvRect where it is in the texture, for images packed in an atlas
+struct NineSlice
+{
+	/// The quads drawing the image over rect, x y width height with y up like QuadInstance::rect, into out and how many there are.
+	/// Slices with no area are left out, and when rect is smaller than the insets the corners shrink in proportion to fit
+	inline constexpr size_t expand(IR::vec4<float> const &rect, IR::vec4<float> const &color, float layer, QuadInstance *out) const
+	{
+		float xs[4] {}, ys[4] {}, us[4] {}, vs[4] {};
+		edges(rect.x(), rect.z(), static_cast<float>(this->insets.left), static_cast<float>(this->insets.right), 1, xs);
+		edges(rect.y(), rect.w(), static_cast<float>(this->insets.top), static_cast<float>(this->insets.bottom), -1, ys);
+		float texelU = this->width ? (this->uvRect.z() - this->uvRect.x()) / static_cast<float>(this->width) : 0;
+		float texelV = this->height ? (this->uvRect.w() - this->uvRect.y()) / static_cast<float>(this->height) : 0;
+		us[0] = this->uvRect.x();
+		us[1] = this->uvRect.x() + static_cast<float>(this->insets.left) * texelU;
+		us[2] = this->uvRect.z() - static_cast<float>(this->insets.right) * texelU;
+		us[3] = this->uvRect.z();
+		vs[0] = this->uvRect.y();
+		vs[1] = this->uvRect.y() + static_cast<float>(this->insets.top) * texelV;
+		vs[2] = this->uvRect.w() - static_cast<float>(this->insets.bottom) * texelV;
+		vs[3] = this->uvRect.w();
+		size_t count = 0;
+		for(size_t row = 0; row < 3; row++)
+		{
+			for(size_t column = 0; column < 3; column++)
+			{
+				float width = xs[column + 1] - xs[column], height = ys[row] - ys[row + 1];
+				if(width <= 0 || height <= 0) continue;
+				out[count++] = {{xs[column], ys[row], width, height}, {us[column], vs[row], us[column + 1], vs[row + 1]}, color, layer};
+			}
+		}
+		return count;
+	}
+	
+	uint32_t width = 0, height = 0;
+	NineSliceInsets insets;
+	IR::vec4<float> uvRect {0, 0, 1, 1};
+
+private:
+	/// The 4 edges of the slices along one axis from start, direction 1 for x and -1 for y which runs down from the top
+	inline static constexpr void edges(float start, float length, float before, float after, float direction, float *out)
+	{
+		if(before + after > length)
+		{
+			float scale = length > 0 ? length / (before + after) : 0;
+			before *= scale;
+			after *= scale;
+		}
+		out[0] = start;
+		out[1] = start + before * direction;
+		out[2] = start + (length - after) * direction;
+		out[3] = start + length * direction;
+	}
+};
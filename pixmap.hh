@@ -1,29 +1,27 @@
 #pragma once
 
-#include "version.hh"
+#include "device.hh"
+#include "profiler.hh"
+#include "nineSlice.hh"
+#include "mipmap.hh"
+#include "assetBundle.hh"
 
 #include <string>
 #include <iris/vec2.hh>
 
-#if defined(_USEGL45)
 struct Pixmap
 {
-	/// Pixmap from data
+	/// Pixmap from data, a null pixmap allocates storage to be filled later with update()
 	inline Pixmap(unsigned char **pixmap, size_t width, size_t height, bool hasAlpha = false, bool srgb = false)
 	{
 		if(width == 0 || height == 0) return;
 		this->width = static_cast<uint32_t>(width);
 		this->height = static_cast<uint32_t>(height);
 		this->srgb = srgb;
-		this->colorFormat = hasAlpha ? static_cast<char>(2) : static_cast<char>(6);
-		glCreateTextures(GL_TEXTURE_2D, 1, &this->texHandle);
-		glTextureStorage2D(this->texHandle, 1, this->colorFormat == 2 ? (srgb ? GL_SRGB8 : GL_RGB8) : (srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8), this->width, this->height);
-		for(uint32_t i = 0; i < this->height; i++)
-		{
-			glTextureSubImage2D(this->texHandle, 0, 0, i, this->width, 1, this->colorFormat == 2 ? GL_RGB : GL_RGBA, GL_UNSIGNED_BYTE, pixmap[i]);
-		}
-		glTextureParameteri(this->texHandle, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTextureParameteri(this->texHandle, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		this->colorFormat = hasAlpha ? static_cast<char>(6) : static_cast<char>(2);
+		this->texHandle = Device::createTexture(this->width, this->height, this->format(), srgb);
+		for(uint32_t i = 0; pixmap && i < this->height; i++) Device::updateTexture(this->texHandle, 0, i, this->width, 1, this->format(), pixmap[i]);
+		CommandEncoder::current().edited();
 	}
 	
 	/// Pixmap from solid color
@@ -33,108 +31,114 @@ struct Pixmap
 		this->height = 1;
 		this->srgb = srgb;
 		this->colorFormat = alpha == 255 ? static_cast<char>(2) : static_cast<char>(6);
-		unsigned char **pixmap = new unsigned char *;
-		pixmap[0] = new unsigned char[alpha == 255 ? 3 : 4];
-		pixmap[0][0] = red;
-		pixmap[0][1] = green;
-		pixmap[0][2] = blue;
-		if(alpha != 255) pixmap[0][3] = alpha;
-		glCreateTextures(GL_TEXTURE_2D, 1, &this->texHandle);
-		glTextureStorage2D(this->texHandle, 1, this->colorFormat == 2 ? (srgb ? GL_SRGB8 : GL_RGB8) : (srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8), 1, 1);
-		for(uint32_t i = 0; i < 1; i++) glTextureSubImage2D(this->texHandle, 0, 0, i, 1, 1, this->colorFormat == 2 ? GL_RGB : GL_RGBA, GL_UNSIGNED_BYTE, pixmap[i]);
+		unsigned char texel[4] = {red, green, blue, alpha};
+		this->texHandle = Device::createTexture(1, 1, this->format(), srgb);
+		Device::updateTexture(this->texHandle, 0, 0, 1, 1, this->format(), texel);
+		CommandEncoder::current().edited();
 	}
 	
-	inline ~Pixmap()
+	/// Pixmap sampling every level of chain trilinearly, only firstLevel and the levels after it are uploaded.
+	/// Pass chain.levelFor() the size a widget draws it at to skip the levels it would never sample, uploadLevels() adds them when it grows
+	inline Pixmap(MipChain const &chain, uint32_t firstLevel = 0)
 	{
-		glDeleteTextures(1, &this->texHandle);
+		if(chain.levels.empty()) return;
+		this->width = chain.levels[0].width;
+		this->height = chain.levels[0].height;
+		this->srgb = chain.srgb;
+		this->colorFormat = chain.channels == 4 ? static_cast<char>(6) : static_cast<char>(2);
+		this->mipLevels = static_cast<uint32_t>(chain.levels.size());
+		this->baseLevel = this->mipLevels;
+		this->texHandle = Device::createTexture(this->width, this->height, this->format(), this->srgb, this->mipLevels);
+		this->uploadLevels(chain, firstLevel);
 	}
 	
-	inline void setInterp(int32_t min, int32_t mag)
+	/// Pixmap from a texture stored decoded in an AssetBundle, every level goes up straight from the bundle's mapping
+	inline explicit Pixmap(BundleTexture const &texture)
 	{
-		glTextureParameteri(this->texHandle, GL_TEXTURE_MIN_FILTER, min);
-		glTextureParameteri(this->texHandle, GL_TEXTURE_MAG_FILTER, mag);
+		if(!texture.width || !texture.height || !texture.levelCount) return;
+		this->width = texture.width;
+		this->height = texture.height;
+		this->srgb = texture.srgb;
+		this->colorFormat = texture.channels == 4 ? static_cast<char>(6) : static_cast<char>(2);
+		this->mipLevels = texture.levelCount;
+		this->texHandle = Device::createTexture(this->width, this->height, this->format(), this->srgb, this->mipLevels);
+		if(this->mipLevels > 1) Device::setTextureLevels(this->texHandle, 0, this->mipLevels - 1);
+		for(uint32_t level = 0; level < this->mipLevels; level++)
+		{
+			uint32_t width, height;
+			unsigned char const *texels = texture.level(level, width, height);
+			this->uploadLevel(level, width, height, texture.channels, texels);
+		}
+		CommandEncoder::current().edited();
 	}
 	
-	inline void setAnisotropy(uint32_t level)
+	inline ~Pixmap()
 	{
-		glTextureParameterf(this->texHandle, GL_TEXTURE_MAX_ANISOTROPY, level);
+		if(!this->width) return;
+		CommandEncoder::current().forgetTexture(this->texHandle);
+		Device::destroyTexture(this->texHandle);
 	}
 	
-	inline void bind(uint32_t target = 0)
+	inline void setInterp(int32_t min, int32_t mag)
 	{
-		glBindTextureUnit(target, this->texHandle);
+		Device::setTextureFilter(this->texHandle, min, mag);
+		CommandEncoder::current().edited();
 	}
 	
-	char colorFormat;
-	bool srgb = true;
-	uint32_t texHandle = 0, width = 0, height = 0;
-};
-#elif defined(_USEGL33)
-struct Pixmap
-{
-	/// Pixmap from data
-	inline Pixmap(unsigned char **pixmap, size_t width, size_t height, bool hasAlpha = false, bool srgb = false)
+	inline void setAnisotropy(uint32_t level)
 	{
-		if(width == 0 || height == 0) return;
-		this->width = static_cast<uint32_t>(width);
-		this->height = static_cast<uint32_t>(height);
-		this->srgb = srgb;
-		this->colorFormat = hasAlpha ? static_cast<char>(2) : static_cast<char>(6);
-		glGenTextures(1, &this->texHandle);
-		this->bind(0);
-		glTexImage2D(GL_TEXTURE_2D, 1, this->colorFormat == 2 ? (srgb ? GL_SRGB8 : GL_RGB8) : (srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8),
-		             this->width, this->height, 0, this->colorFormat == 2 ? GL_RGB : GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
-		for(uint32_t i = 0; i < this->height; i++)
-		{
-			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, i, this->width, 1, this->colorFormat == 2 ? GL_RGB : GL_RGBA, GL_UNSIGNED_BYTE, pixmap[i]);
-		}
-		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		Device::setTextureAnisotropy(this->texHandle, level);
 	}
 	
-	/// Pixmap from solid color
-	inline Pixmap(unsigned char red, unsigned char green, unsigned char blue, unsigned char alpha, bool srgb = false)
+	/// Replace a region of this pixmap with tightly packed rows in its color format
+	inline void update(uint32_t x, uint32_t y, uint32_t width, uint32_t height, unsigned char const *data)
 	{
-		this->width = 1;
-		this->height = 1;
-		this->srgb = srgb;
-		this->colorFormat = alpha == 255 ? static_cast<char>(2) : static_cast<char>(6);
-		unsigned char **pixmap = new unsigned char *;
-		pixmap[0] = new unsigned char[alpha == 255 ? 3 : 4];
-		pixmap[0][0] = red;
-		pixmap[0][1] = green;
-		pixmap[0][2] = blue;
-		if(alpha != 255) pixmap[0][3] = alpha;
-		glGenTextures(1, &this->texHandle);
-		this->bind(0);
-		glTexImage2D(GL_TEXTURE_2D, 1, this->colorFormat == 2 ? (srgb ? GL_SRGB8 : GL_RGB8) : (srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8),
-		             1, 1, 0, this->colorFormat == 2 ? GL_RGB : GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
-		for(uint32_t i = 0; i < this->height; i++)
-		{
-			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, i, 1, 1, this->colorFormat == 2 ? GL_RGB : GL_RGBA, GL_UNSIGNED_BYTE, pixmap[i]);
-		}
+		WUI_PROFILE_SCOPE("Pixmap::update");
+		Device::updateTexture(this->texHandle, x, y, width, height, this->format(), data);
+		CommandEncoder::current().edited();
 	}
 	
-	inline ~Pixmap()
+	/// Upload the levels of chain from firstLevel up to the ones already uploaded, chain must be the one this pixmap was made from
+	inline void uploadLevels(MipChain const &chain, uint32_t firstLevel)
 	{
-		glDeleteTextures(1, &this->texHandle);
+		WUI_PROFILE_SCOPE("Pixmap::uploadLevels");
+		firstLevel = std::min(firstLevel, this->mipLevels - 1);
+		if(firstLevel >= this->baseLevel) return;
+		Device::setTextureLevels(this->texHandle, firstLevel, this->mipLevels - 1);
+		for(uint32_t level = firstLevel; level < this->baseLevel; level++) this->uploadLevel(level, chain.levels[level].width, chain.levels[level].height, chain.channels, chain.texels(level));
+		this->baseLevel = firstLevel;
+		CommandEncoder::current().edited();
 	}
 	
-	inline void setInterp(int32_t min, int32_t mag)
+	inline void bind(uint32_t target = 0)
 	{
-		this->bind(0);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, min);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mag);
+		CommandEncoder::current().setTexture(target, this->texHandle);
 	}
 	
-	inline void bind(uint32_t target = 0)
+	/// The whole pixmap as a nine-slice image with insets
+	inline NineSlice nineSlice() const
 	{
-		glActiveTexture(GL_TEXTURE0 + target);
-		glBindTexture(GL_TEXTURE_2D, this->texHandle);
+		return {this->width, this->height, this->insets};
 	}
 	
 	char colorFormat;
+	NineSliceInsets insets; //Set on pixmaps drawn nine-sliced, see Widget::batchNineSlice()
 	bool srgb = true;
-	uint32_t texHandle = 0, width = 0, height = 0;
+	Device::Texture texHandle {};
+	uint32_t width = 0, height = 0;
+	uint32_t mipLevels = 1, baseLevel = 0; //Levels the texture has and the first one uploaded
+
+private:
+	inline TextureFormat format() const
+	{
+		return this->colorFormat == 2 ? TextureFormat::RGB8 : TextureFormat::RGBA8;
+	}
+	
+	inline void uploadLevel(uint32_t level, uint32_t width, uint32_t height, uint32_t channels, unsigned char const *texels)
+	{
+		size_t rowBytes = static_cast<size_t>(width) * channels;
+		//Rows of RGB levels can end off GL's default 4 byte unpack alignment, those go up a row at a time
+		if(rowBytes % 4 == 0) Device::updateTexture(this->texHandle, 0, 0, width, height, this->format(), texels, level);
+		else for(uint32_t row = 0; row < height; row++) Device::updateTexture(this->texHandle, 0, row, width, 1, this->format(), texels + row * rowBytes, level);
+	}
 };
-#endif
@@ -0,0 +1,286 @@
+#pragma once
+
+/// Profiling is compiled out unless WUI_PROFILE is defined, the macros below then expand to nothing
+#if defined(WUI_PROFILE)
+
+#include "definitions.hh"
+#include "device.hh"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <algorithm>
+
+/// A timed span, times are nanoseconds since the profiler started.  GPU spans are converted to the CPU clock
+struct ProfileEvent
+{
+	char const *name;
+	uint64_t start, end;
+	uint32_t thread; //0 is the GPU
+	std::atomic<uint64_t> frame; //Written last, the event is only complete once it matches its record's frame
+};
+
+/// Everything recorded during one frame
+struct ProfileFrame
+{
+	static constexpr uint32_t capacity = 4096;
+	
+	uint64_t frame = 0, start = 0, end = 0;
+	std::atomic<uint32_t> count {0}, dropped {0};
+	ProfileEvent events[capacity];
+};
+
+/// Collects scoped CPU timers from any thread and GPU timestamp queries from the GL thread into a ring of per-frame records.
+/// Recording never locks, a timer claims a slot in the current frame's record with one atomic add.
+/// The ring holds the last frameCount frames, endFrame() must be called once per frame on the thread that owns the context
+struct Profiler final
+{
+	static constexpr uint32_t frameCount = 64;
+	
+	inline static Profiler &instance()
+	{
+		static Profiler out;
+		return out;
+	}
+	
+	inline uint64_t now() const
+	{
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->epoch).count());
+	}
+	
+	/// Small stable id of the calling thread, starting at 1
+	inline static uint32_t threadID()
+	{
+		static std::atomic<uint32_t> next {1};
+		thread_local uint32_t out = next++;
+		return out;
+	}
+	
+	inline void record(char const *name, uint64_t start, uint64_t end, uint32_t thread)
+	{
+		this->record(this->currentFrame.load(std::memory_order_acquire), name, start, end, thread);
+	}
+	
+	/// Close the current frame, resolve the GPU timers that finished and open the next record
+	inline void endFrame()
+	{
+		uint64_t frame = this->currentFrame.load(std::memory_order_relaxed);
+		uint64_t end = this->now();
+		this->frames[frame % frameCount].end = end;
+		this->frameThread = threadID();
+		this->resolveGPU(frame);
+		ProfileFrame &next = this->frames[(frame + 1) % frameCount];
+		next.frame = frame + 1;
+		next.start = end;
+		next.end = 0;
+		next.count.store(0, std::memory_order_relaxed);
+		next.dropped.store(0, std::memory_order_relaxed);
+		this->currentFrame.store(frame + 1, std::memory_order_release);
+	}
+	
+	/// Completed frames still in the ring, oldest first
+	template <typename F> inline void forEachFrame(F const &f) const
+	{
+		uint64_t current = this->currentFrame.load(std::memory_order_acquire);
+		uint64_t first = current >= frameCount - 1 ? current - (frameCount - 1) : 0;
+		for(uint64_t frame = first; frame < current; frame++) f(this->frames[frame % frameCount]);
+	}
+	
+	/// The completed frames as Chrome trace event JSON, load it in chrome://tracing or Perfetto
+	inline std::string chromeTrace() const
+	{
+		std::string out = R"({"displayTimeUnit":"ms","traceEvents":[)";
+		out += R"({"name":"thread_name","ph":"M","pid":1,"tid":0,"args":{"name":"GPU"}})";
+		char buffer[256];
+		this->forEachFrame([&](ProfileFrame const &record)
+		{
+			snprintf(buffer, sizeof(buffer), R"(,{"name":"Frame %llu","ph":"X","pid":1,"tid":%u,"ts":%.3f,"dur":%.3f})",
+			         static_cast<unsigned long long>(record.frame), this->frameThread, static_cast<double>(record.start) / 1000.0, static_cast<double>(record.end - record.start) / 1000.0);
+			out += buffer;
+			uint32_t count = std::min(record.count.load(std::memory_order_acquire), ProfileFrame::capacity);
+			for(uint32_t i = 0; i < count; i++)
+			{
+				ProfileEvent const &event = record.events[i];
+				if(event.frame.load(std::memory_order_acquire) != record.frame) continue;
+				out += R"(,{"name":")";
+				for(char const *c = event.name; *c; c++)
+				{
+					if(*c == '"' || *c == '\\') out += '\\';
+					out += *c;
+				}
+				snprintf(buffer, sizeof(buffer), R"(","ph":"X","pid":1,"tid":%u,"ts":%.3f,"dur":%.3f})",
+				         event.thread, static_cast<double>(event.start) / 1000.0, static_cast<double>(event.end - event.start) / 1000.0);
+				out += buffer;
+			}
+		});
+		out += "]}";
+		return out;
+	}
+	
+	inline bool saveChromeTrace(std::string const &path) const
+	{
+		FILE *file = fopen(path.data(), "wb");
+		if(!file)
+		{
+			printf("Error opening file %s\n", path.data());
+			return false;
+		}
+		std::string trace = this->chromeTrace();
+		fwrite(trace.data(), 1, trace.size(), file);
+		fclose(file);
+		return true;
+	}
+
+#if !defined(_INVALIDGLVERSION)
+	/// Write a GPU timestamp now, the pair of them is resolved a few frames later once the GPU has passed both.
+	/// A GPU timer may span endFrame(), it is resolved into the frame it started in
+	inline uint64_t beginGPU()
+	{
+		if constexpr(!Device::timestamps) return 0;
+		uint64_t index = this->resolvedGPU + this->pendingGPU.size();
+		this->pendingGPU.push_back({nullptr, this->currentFrame.load(std::memory_order_relaxed), this->takeQuery(), {}});
+		Device::writeTimestamp(this->pendingGPU.back().begin);
+		return index;
+	}
+	
+	inline void endGPU(uint64_t index, char const *name)
+	{
+		if constexpr(!Device::timestamps) return;
+		PendingGPU &pending = this->pendingGPU[index - this->resolvedGPU];
+		pending.name = name;
+		pending.end = this->takeQuery();
+		Device::writeTimestamp(pending.end);
+	}
+#endif
+
+private:
+#if !defined(_INVALIDGLVERSION)
+	struct PendingGPU
+	{
+		char const *name;
+		uint64_t frame;
+		Device::Query begin, end;
+	};
+#endif
+
+	inline Profiler() : epoch(std::chrono::steady_clock::now()), frames(new ProfileFrame[frameCount])
+	{
+	
+	}
+	
+	inline void record(uint64_t frame, char const *name, uint64_t start, uint64_t end, uint32_t thread)
+	{
+		ProfileFrame &record = this->frames[frame % frameCount];
+		uint32_t slot = record.count.fetch_add(1, std::memory_order_relaxed);
+		if(slot >= ProfileFrame::capacity)
+		{
+			record.dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		ProfileEvent &event = record.events[slot];
+		event.name = name;
+		event.start = start;
+		event.end = end;
+		event.thread = thread;
+		event.frame.store(frame, std::memory_order_release);
+	}
+	
+	inline void resolveGPU([[maybe_unused]] uint64_t frame)
+	{
+#if !defined(_INVALIDGLVERSION)
+		if constexpr(!Device::timestamps) return;
+		if(this->pendingGPU.empty()) return;
+		//Queries complete in order, so stop at the first one that isn't ready
+		size_t resolved = 0;
+		for(; resolved < this->pendingGPU.size(); resolved++)
+		{
+			PendingGPU &pending = this->pendingGPU[resolved];
+			if(!pending.name || !Device::queryReady(pending.end)) break;
+			if(!this->gpuOffsetKnown)
+			{
+				//Line the GPU clock up with the CPU clock once, both are monotonic nanoseconds
+				this->gpuOffset = static_cast<int64_t>(this->now()) - static_cast<int64_t>(Device::gpuTime());
+				this->gpuOffsetKnown = true;
+			}
+			uint64_t start = static_cast<uint64_t>(static_cast<int64_t>(Device::queryResult(pending.begin)) + this->gpuOffset);
+			uint64_t end = static_cast<uint64_t>(static_cast<int64_t>(Device::queryResult(pending.end)) + this->gpuOffset);
+			if(frame - pending.frame < frameCount - 1) this->record(pending.frame, pending.name, start, end, 0);
+			this->freeQueries.push_back(pending.begin);
+			this->freeQueries.push_back(pending.end);
+		}
+		this->pendingGPU.erase(this->pendingGPU.begin(), this->pendingGPU.begin() + static_cast<std::ptrdiff_t>(resolved));
+		this->resolvedGPU += resolved;
+#endif
+	}
+
+#if !defined(_INVALIDGLVERSION)
+	inline Device::Query takeQuery()
+	{
+		if(this->freeQueries.empty()) return Device::createQuery();
+		Device::Query out = this->freeQueries.back();
+		this->freeQueries.pop_back();
+		return out;
+	}
+#endif
+
+	std::chrono::steady_clock::time_point const epoch;
+	UP<ProfileFrame[]> frames;
+	std::atomic<uint64_t> currentFrame {0};
+	uint32_t frameThread = 1;
+#if !defined(_INVALIDGLVERSION)
+	std::vector<PendingGPU> pendingGPU;
+	uint64_t resolvedGPU = 0; //GPU timers resolved so far, pendingGPU[0] is the timer with this index
+	std::vector<Device::Query> freeQueries;
+	int64_t gpuOffset = 0;
+	bool gpuOffsetKnown = false;
+#endif
+};
+
+/// Times the enclosing scope on the calling thread
+struct ProfileScope final
+{
+	inline explicit ProfileScope(char const *name) : name(name), start(Profiler::instance().now()) {}
+	
+	inline ~ProfileScope()
+	{
+		Profiler::instance().record(this->name, this->start, Profiler::instance().now(), Profiler::threadID());
+	}
+	
+	char const *name;
+	uint64_t start;
+};
+
+#if !defined(_INVALIDGLVERSION)
+/// Times the GPU work issued in the enclosing scope, must be used on the thread that owns the context
+struct GPUProfileScope final
+{
+	inline explicit GPUProfileScope(char const *name) : name(name), index(Profiler::instance().beginGPU()) {}
+	
+	inline ~GPUProfileScope()
+	{
+		Profiler::instance().endGPU(this->index, this->name);
+	}
+	
+	char const *name;
+	uint64_t index;
+};
+#define WUI_PROFILE_GPU_SCOPE(name) GPUProfileScope WUI_PROFILE_CONCAT(wuiGPUProfileScope, __LINE__){name}
+#else
+#define WUI_PROFILE_GPU_SCOPE(name)
+#endif
+
+#define WUI_PROFILE_CONCAT_INNER(a, b) a##b
+#define WUI_PROFILE_CONCAT(a, b) WUI_PROFILE_CONCAT_INNER(a, b)
+#define WUI_PROFILE_SCOPE(name) ProfileScope WUI_PROFILE_CONCAT(wuiProfileScope, __LINE__){name}
+#define WUI_PROFILE_FRAME() Profiler::instance().endFrame()
+
+#else
+
+#define WUI_PROFILE_SCOPE(name)
+#define WUI_PROFILE_GPU_SCOPE(name)
+#define WUI_PROFILE_FRAME()
+
+#endif
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <iris/vec2.hh>
+#include <iris/vec3.hh>
+#include <iris/vec4.hh>
+#include <iris/mat3.hh>
+#include <iris/mat4.hh>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+static constexpr float guiVerts[12] =
+{
+	1.0f, 0.0f, 0.0f,
+	0.0f, 0.0f, 0.0f,
+	1.0f, -1.0f, 0.0f,
+	0.0f, -1.0f, 0.0f,
+};
+
+static constexpr float guiUVs[8] =
+{
+	1.0f, 0.0f,
+	0.0f, 0.0f,
+	1.0f, 1.0f,
+	0.0f, 1.0f,
+};
+
+/// Per-instance attributes of a batched quad.  rect is x y width height in pixels with y up, matching Widget::getHitbox,
+/// uvRect is min u, min v, max u, max v of the pixmap region and color is multiplied with the sampled texel.
+/// Quads with shape.w set sample nothing and are drawn as a rounded rect evaluated per pixel instead, see roundedRect() and shadow()
+struct QuadInstance
+{
+	/// A rect filled with color, with corner radii top left, top right, bottom right and bottom left and a border of borderWidth pixels inside its edge
+	inline static QuadInstance roundedRect(IR::vec4<float> const &rect, IR::vec4<float> const &radii, IR::vec4<float> const &color, float layer = 1,
+	                                       float borderWidth = 0, IR::vec4<float> const &borderColor = {0, 0, 0, 0})
+	{
+		return {rect, radii, color, layer, borderColor, {borderWidth, 0, 0, 1}};
+	}
+	
+	/// The shadow rect casts, its edge fades out over blur pixels either side.  The quad is grown by blur to fit the fade
+	inline static QuadInstance shadow(IR::vec4<float> const &rect, IR::vec4<float> const &radii, IR::vec4<float> const &color, float blur, float layer = 1)
+	{
+		return {{rect.x() - blur, rect.y() + blur, rect.z() + blur * 2, rect.w() + blur * 2}, radii, color, layer, {0, 0, 0, 0}, {0, blur, blur, 1}};
+	}
+	
+	IR::vec4<float> rect, uvRect, color;
+	float layer = 1;
+	/// Only read by shape quads, uvRect holds their corner radii and shape is border width, blur, how far the shape is inset from rect and 1
+	IR::vec4<float> borderColor {0, 0, 0, 0}, shape {0, 0, 0, 0};
+};
+
+/// How a themed widget looks drawn with shape quads instead of pixmaps, see QuadBatch::addShape()
+struct ShapeStyle
+{
+	IR::vec4<float> radii, fill {1, 1, 1, 1}, borderColor, shadowColor;
+	IR::vec2<float> shadowOffset;
+	float borderWidth = 0, shadowBlur = 0; //No shadow is drawn while shadowColor is transparent
+};
+
+/// Signed distance from a point to the edge of a rounded box centered on the origin, negative inside.
+/// y is down, radii are top left, top right, bottom right and bottom left, the same as the instanced fragment shaders compute
+inline float roundedBoxDistance(float x, float y, float halfWidth, float halfHeight, IR::vec4<float> const &radii)
+{
+	float radius = x < 0 ? (y < 0 ? radii.x() : radii.w()) : (y < 0 ? radii.y() : radii.z());
+	radius = std::max(std::min(radius, std::min(halfWidth, halfHeight)), 0.0f);
+	float qx = std::abs(x) - halfWidth + radius, qy = std::abs(y) - halfHeight + radius;
+	float outX = std::max(qx, 0.0f), outY = std::max(qy, 0.0f);
+	return std::min(std::max(qx, qy), 0.0f) + std::sqrt(outX * outX + outY * outY) - radius;
+}
+
+/// Where each QuadInstance member lives in the instance buffer, the instanced shaders read them at locations 2 to 7
+struct InstanceAttrib
+{
+	uint32_t location, components;
+	size_t offset;
+};
+
+static constexpr InstanceAttrib quadInstanceAttribs[6] =
+{
+	{2, 4, offsetof(QuadInstance, rect)},
+	{3, 4, offsetof(QuadInstance, uvRect)},
+	{4, 4, offsetof(QuadInstance, color)},
+	{5, 1, offsetof(QuadInstance, layer)},
+	{6, 4, offsetof(QuadInstance, borderColor)},
+	{7, 4, offsetof(QuadInstance, shape)},
+};
+
+static_assert(sizeof(IR::vec4<float>) == 4 * sizeof(float), "vec4 must be tightly packed to be read as a vertex attribute");
+static_assert(quadInstanceAttribs[0].offset == 0, "QuadInstance attributes must start at the beginning of the instance");
+static_assert(quadInstanceAttribs[1].offset == quadInstanceAttribs[0].offset + quadInstanceAttribs[0].components * sizeof(float), "QuadInstance::uvRect must follow rect");
+static_assert(quadInstanceAttribs[2].offset == quadInstanceAttribs[1].offset + quadInstanceAttribs[1].components * sizeof(float), "QuadInstance::color must follow uvRect");
+static_assert(quadInstanceAttribs[3].offset == quadInstanceAttribs[2].offset + quadInstanceAttribs[2].components * sizeof(float), "QuadInstance::layer must follow color");
+static_assert(quadInstanceAttribs[4].offset == quadInstanceAttribs[3].offset + quadInstanceAttribs[3].components * sizeof(float), "QuadInstance::borderColor must follow layer");
+static_assert(quadInstanceAttribs[5].offset == quadInstanceAttribs[4].offset + quadInstanceAttribs[4].components * sizeof(float), "QuadInstance::shape must follow borderColor");
+static_assert(sizeof(QuadInstance) == quadInstanceAttribs[5].offset + quadInstanceAttribs[5].components * sizeof(float), "QuadInstance must not contain padding");
+
+struct StreamBufferStats
+{
+	uint64_t fenceWaits = 0, fenceWaitNanoseconds = 0, lastFenceWaitNanoseconds = 0;
+	uint64_t orphans = 0, reallocations = 0;
+};
+
+
+/// Pixel formats a device texture can be created with, RGB8 and RGBA8 may be sRGB encoded
+enum struct TextureFormat
+{
+	RGB8, RGBA8, RGBA32F
+};
+
+/// Bytes per texel of the data passed to Device::updateTexture
+inline constexpr size_t texelSize(TextureFormat format)
+{
+	return format == TextureFormat::RGB8 ? 3 : format == TextureFormat::RGBA8 ? 4 : 16;
+}
+
+/// A scissor rectangle in pixels with the origin at the bottom left of the target, like glScissor
+struct ScissorRect
+{
+	inline bool operator==(ScissorRect const &other) const
+	{
+		return this->x == other.x && this->y == other.y && this->width == other.width && this->height == other.height;
+	}
+	
+	int32_t x = 0, y = 0, width = 0, height = 0;
+};
+
+/// A StreamBuffer in plain memory for the devices that don't need GPU visible storage
+struct HostStreamBuffer
+{
+	static constexpr size_t alignment = 64;
+	
+	inline explicit HostStreamBuffer(size_t regionSize = 64 * 1024)
+	{
+		this->storage.reserve(regionSize);
+	}
+	
+	inline unsigned char *map(size_t bytes)
+	{
+		bytes = (bytes + alignment - 1) & ~(alignment - 1);
+		if(this->cursor + bytes > this->storage.capacity()) this->stats.reallocations++;
+		this->lastOffset = this->cursor;
+		this->cursor += bytes;
+		this->storage.resize(this->cursor);
+		return this->storage.data() + this->lastOffset;
+	}
+	
+	inline void unmap() {}
+	
+	inline size_t offset() const
+	{
+		return this->lastOffset;
+	}
+	
+	inline unsigned char const *data() const
+	{
+		return this->storage.data();
+	}
+	
+	inline void endFrame()
+	{
+		this->cursor = 0;
+	}
+	
+	StreamBufferStats stats;
+
+private:
+	std::vector<unsigned char> storage;
+	size_t cursor = 0, lastOffset = 0;
+};
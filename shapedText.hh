@@ -0,0 +1,50 @@
+#pragma once
+
+#include "util.hh"
+#include "definitions.hh"
+
+#include <vector>
+#include <atomic>
+#include <iris/vec2.hh>
+#include <iris/vec4.hh>
+
+/// A positioned glyph of a shaped layout, in pixels from the top left of the layout
+struct GlyphQuad
+{
+	IR::vec2<float> pos, size;
+	IR::vec4<float> uvRect;
+	uint32_t page = 0; //The GlyphAtlas page it samples
+};
+
+/// The finished output of shaping a string, safe to read from any thread once published
+struct ShapedText
+{
+	std::vector<GlyphQuad> quads;
+	IR::vec2<int32_t> extents;
+	uint64_t atlasGeneration = 0; //The newest glyph it uses
+};
+
+/// A widget's handle to its shaped text.  While a new result is being produced the previous one stays current,
+/// so a widget never waits on shaping and at worst draws stale text for a frame
+struct TextLayout
+{
+	/// The result to draw this frame, may be null before the first result arrives
+	inline SP<ShapedText const> current() const
+	{
+		return this->front;
+	}
+
+	/// True while a requested result has not been swapped in yet
+	inline bool pending() const
+	{
+		return this->swappedGeneration != this->requestedGeneration.load();
+	}
+
+private:
+	friend struct TextPipeline;
+
+	SP<ShapedText const> front, back;
+	std::atomic<uint64_t> requestedGeneration {0};
+	uint64_t backGeneration = 0, swappedGeneration = 0;
+	Spinlock sl;
+};
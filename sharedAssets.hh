@@ -1,527 +1,236 @@
 #pragma once
 
-#include "version.hh"
+#include "device.hh"
+#include "profiler.hh"
+#include "nineSlice.hh"
+#include "shapedText.hh"
 
-#include <iris/vec2.hh>
-#include <iris/vec3.hh>
-#include <iris/vec4.hh>
-#include <iris/mat3.hh>
-#include <iris/mat4.hh>
-
-static constexpr float guiVerts[12] =
-{
-	1.0f, 0.0f, 0.0f,
-	0.0f, 0.0f, 0.0f,
-	1.0f, -1.0f, 0.0f,
-	0.0f, -1.0f, 0.0f,
-};
-
-static constexpr float guiUVs[8] =
-{
-	1.0f, 0.0f,
-	0.0f, 0.0f,
-	1.0f, 1.0f,
-	0.0f, 1.0f,
-};
-
-#if defined(_USEGL45)
-static constexpr char const *guiVertShader =
-R"(#version 450
-
-layout(location = 0) in vec3 pos;
-layout(location = 1) in vec2 uv_in;
-out vec2 uv;
-uniform mat4 mvp;
-
-void main()
-{
-	uv = uv_in;
-	gl_Position = mvp * vec4(pos, 1.0f);
-})";
-
-static constexpr char const *guiFragShader =
-R"(#version 450
-
-in vec2 uv;
-layout(binding = 0) uniform sampler2D tex;
-out vec4 fragColor;
-
-void main()
-{
-	fragColor = texture(tex, uv);
-})";
+#include <string>
+#include <cstring>
 
+/// The GUI quad and a stream buffer for instances of it
 struct Mesh
 {
-	inline Mesh()
+	inline Mesh() : vboV(Device::createBuffer(guiVerts, sizeof(guiVerts))), vboU(Device::createBuffer(guiUVs, sizeof(guiUVs))),
+	                vao(Device::createQuadInput(this->vboV, this->vboU, this->instanceStream))
 	{
-		size_t constexpr vertexStride = 3 * sizeof(float);
-		size_t constexpr uvStride = 2 * sizeof(float);
-		glCreateVertexArrays(1, &this->vao);
-		glCreateBuffers(1, &this->vboV);
-		glCreateBuffers(1, &this->vboU);
-		
-		glNamedBufferData(this->vboV, 12 * sizeof(float), guiVerts, GL_STATIC_DRAW);
-		glVertexArrayAttribBinding(this->vao, 0, 0);
-		glVertexArrayVertexBuffer(this->vao, 0, this->vboV, 0, vertexStride);
-		glEnableVertexArrayAttrib(this->vao, 0);
-		glVertexArrayAttribFormat(this->vao, 0, 3, GL_FLOAT, GL_FALSE, 0);
-		
-		glNamedBufferData(this->vboU, 8 * sizeof(float), guiUVs, GL_STATIC_DRAW);
-		glVertexArrayAttribBinding(this->vao, 1, 1);
-		glVertexArrayVertexBuffer(this->vao, 1, this->vboU, 0, uvStride);
-		glEnableVertexArrayAttrib(this->vao, 1);
-		glVertexArrayAttribFormat(this->vao, 1, 2, GL_FLOAT, GL_FALSE, 0);
+		CommandEncoder::current().edited();
 	}
 	
 	inline ~Mesh()
 	{
-		glDeleteBuffers(1, &this->vboV);
-		glDeleteBuffers(1, &this->vboU);
-		glDeleteVertexArrays(1, &this->vao);
+		Device::destroyBuffer(this->vboV);
+		Device::destroyBuffer(this->vboU);
+		CommandEncoder::current().forgetVertexInput(this->vao);
+		Device::destroyVertexInput(this->vao);
 	}
 	
 	inline void bind()
 	{
-		glBindVertexArray(this->vao);
+		CommandEncoder::current().setVertexInput(this->vao);
 	}
 	
-	uint32_t vao = 0, vboV = 0, vboU = 0;
+	/// Draw the GUI quad, the mesh and a shader must be bound
+	inline void draw()
+	{
+		CommandEncoder::current().draw();
+	}
+	
+	/// Get space for count instances in the stream buffer, write them and then call drawInstanced() with the same count
+	inline QuadInstance *mapInstances(size_t count)
+	{
+		return reinterpret_cast<QuadInstance *>(this->instanceStream.map(count * sizeof(QuadInstance)));
+	}
+	
+	inline void uploadInstances(QuadInstance const *instances, size_t count)
+	{
+		memcpy(static_cast<void *>(this->mapInstances(count)), instances, count * sizeof(QuadInstance));
+	}
+	
+	/// Draw the instances last mapped, the mesh and an instanced shader must be bound
+	inline void drawInstanced(size_t count)
+	{
+		CommandEncoder::current().drawInstanced(this->vao, this->instanceStream, count);
+	}
+	
+	/// Call once per frame after the last instanced draw
+	inline void endFrame()
+	{
+		this->instanceStream.endFrame();
+	}
+	
+	StreamBuffer instanceStream;
+	Device::Buffer vboV, vboU;
+	Device::VertexInput vao;
 };
 
 struct Shader
 {
-	inline Shader()
+	inline explicit Shader(char const *vertSource = guiVertShader, char const *fragSource = guiFragShader) : shaderHandle(Device::createPipeline(vertSource, fragSource))
 	{
-		uint32_t vertHandle = glCreateShader(GL_VERTEX_SHADER), fragHandle = glCreateShader(GL_FRAGMENT_SHADER);
-		this->shaderHandle = glCreateProgram();
-		glShaderSource(vertHandle, 1, &guiVertShader, nullptr);
-		glShaderSource(fragHandle, 1, &guiFragShader, nullptr);
-		glCompileShader(vertHandle);
-		int32_t success = 0;
-		glGetShaderiv(vertHandle, GL_COMPILE_STATUS, &success);
-		if(!success)
-		{
-			int32_t maxLen = 0;
-			glGetShaderiv(vertHandle, GL_INFO_LOG_LENGTH, &maxLen);
-			std::vector<char> error;
-			error.resize(maxLen * sizeof(GLchar));
-			glGetShaderInfoLog(vertHandle, maxLen, &maxLen, error.data());
-			std::string errorStr{error.begin(), error.end()};
-			if(vertHandle == GL_LINK_STATUS) printf("Shader program %u failed to link\n", vertHandle);
-			else printf("Shader failed to compile: %s\n", errorStr.data());
-			return;
-		}
-		glCompileShader(fragHandle);
-		success = 0;
-		glGetShaderiv(fragHandle, GL_COMPILE_STATUS, &success);
-		if(!success)
-		{
-			int32_t maxLen = 0;
-			glGetShaderiv(fragHandle, GL_INFO_LOG_LENGTH, &maxLen);
-			std::vector<char> error;
-			error.resize(maxLen * sizeof(GLchar));
-			glGetShaderInfoLog(fragHandle, maxLen, &maxLen, error.data());
-			std::string errorStr{error.begin(), error.end()};
-			if(fragHandle == GL_LINK_STATUS) printf("Shader program %u failed to link\n", fragHandle);
-			else printf("Shader failed to compile: %s\n", errorStr.data());
-			return;
-		}
-		glAttachShader(this->shaderHandle, vertHandle);
-		glAttachShader(this->shaderHandle, fragHandle);
-		glLinkProgram(this->shaderHandle);
-		success = 0;
-		glGetProgramiv(this->shaderHandle, GL_LINK_STATUS, &success);
-		if(!success)
-		{
-			int32_t maxLen = 0;
-			glGetShaderiv(this->shaderHandle, GL_INFO_LOG_LENGTH, &maxLen);
-			std::vector<char> error;
-			error.resize(maxLen * sizeof(GLchar));
-			glGetShaderInfoLog(this->shaderHandle, maxLen, &maxLen, error.data());
-			std::string errorStr{error.begin(), error.end()};
-			if(this->shaderHandle == GL_LINK_STATUS) printf("Shader program %u failed to link\n", this->shaderHandle);
-			else printf("Shader failed to compile: %s\n", errorStr.data());
-			return;
-		}
-		glDetachShader(this->shaderHandle, vertHandle);
-		glDetachShader(this->shaderHandle, fragHandle);
-		glDeleteShader(vertHandle);
-		glDeleteShader(fragHandle);
+		
 	}
 	
 	inline ~Shader()
 	{
-		glDeleteProgram(this->shaderHandle);
+		CommandEncoder::current().forgetPipeline(this->shaderHandle);
+		Device::destroyPipeline(this->shaderHandle);
 	}
 	
 	inline void bind()
 	{
-		glUseProgram(this->shaderHandle);
+		CommandEncoder::current().setPipeline(this->shaderHandle);
 	}
 	
 	inline void sendFloat(std::string const &location, float val)
 	{
-		glUniform1f(glGetUniformLocation(this->shaderHandle, location.data()), val);
+		Device::setUniform(this->shaderHandle, location.data(), val);
 	}
 	
 	inline void sendInt(std::string const &location, int32_t val)
 	{
-		glUniform1i(glGetUniformLocation(this->shaderHandle, location.data()), val);
+		Device::setUniform(this->shaderHandle, location.data(), val);
 	}
 	
 	inline void sendUInt(std::string const &location, uint32_t val)
 	{
-		glUniform1ui(glGetUniformLocation(this->shaderHandle, location.data()), val);
+		Device::setUniform(this->shaderHandle, location.data(), val);
 	}
 	
 	inline void sendVec2f(std::string const &location, IR::vec2<float> const &val)
 	{
-		glUniform2fv(glGetUniformLocation(this->shaderHandle, location.data()), 1, val.data);
+		Device::setUniform(this->shaderHandle, location.data(), val);
 	}
 	
 	inline void sendVec3f(std::string const &location, IR::vec3<float> const &val)
 	{
-		glUniform3fv(glGetUniformLocation(this->shaderHandle, location.data()), 1, val.data);
+		Device::setUniform(this->shaderHandle, location.data(), val);
 	}
 	
 	inline void sendVec4f(std::string const &location, IR::vec4<float> const &val)
 	{
-		glUniform4fv(glGetUniformLocation(this->shaderHandle, location.data()), 1, val.data);
+		Device::setUniform(this->shaderHandle, location.data(), val);
 	}
 	
 	inline void sendMat3f(std::string const &location, IR::mat3x3<float> const &val)
 	{
-		glUniformMatrix3fv(glGetUniformLocation(this->shaderHandle, location.data()), 1, GL_FALSE, &val[0][0]);
+		Device::setUniform(this->shaderHandle, location.data(), val);
 	}
 	
 	inline void sendMat4f(std::string const &location, IR::mat4x4<float> const &val)
 	{
-		glUniformMatrix4fv(glGetUniformLocation(this->shaderHandle, location.data()), 1, GL_FALSE, &val[0][0]);
+		Device::setUniform(this->shaderHandle, location.data(), val);
 	}
 
 private:
-	uint32_t shaderHandle = 0;
+	Device::Pipeline shaderHandle;
 };
 
+/// A render target the size of the viewport with a color texture that can be drawn from
 struct FBO
 {
 	inline FBO()
 	{
-		int dfSz[4];
-		glGetIntegerv(GL_VIEWPORT, dfSz);
-		this->width = static_cast<uint32_t>(dfSz[2]);
-		this->height = static_cast<uint32_t>(dfSz[3]);
-		glCreateFramebuffers(1, &this->handle);
-		this->bindFBO();
-		glViewport(0, 0, this->width, this->height);
-		glScissor(0, 0, this->width, this->height);
-		glCreateTextures(GL_TEXTURE_2D, 1, &this->colorHandle);
-		glTextureStorage2D(this->colorHandle, 1, GL_RGBA32F, this->width, this->height);
-		glNamedFramebufferTexture(this->handle, GL_COLOR_ATTACHMENT0, this->colorHandle, 0);
-		std::vector<GLenum> drawBuffers;
-		drawBuffers.emplace_back(GL_COLOR_ATTACHMENT0);
-		glNamedFramebufferDrawBuffers(this->handle, static_cast<int32_t>(drawBuffers.size()), drawBuffers.data());
-		GLenum error = glCheckNamedFramebufferStatus(this->handle, GL_FRAMEBUFFER);
-		if(error != GL_FRAMEBUFFER_COMPLETE)
-		{
-			switch(error)
-			{
-				case GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT: printf("attachment\n"); break;
-				case GL_FRAMEBUFFER_INCOMPLETE_DIMENSIONS_EXT: printf("dimensions\n"); break;
-				case GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT: printf("missing attachment\n"); break;
-				case GL_FRAMEBUFFER_UNSUPPORTED: printf("fbo not supported\n"); break;
-				default: break;
-			}
-		}
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		Device::defaultTargetSize(this->width, this->height);
+		this->handle = Device::createTarget(this->width, this->height, this->colorHandle);
+		CommandEncoder::current().invalidate();
 	}
 	
 	inline ~FBO()
 	{
-		glDeleteFramebuffers(1, &this->handle);
-		glDeleteTextures(1, &this->colorHandle);
+		CommandEncoder::current().forgetTarget(this->handle);
+		CommandEncoder::current().forgetTexture(this->colorHandle);
+		Device::destroyTarget(this->handle);
+		Device::destroyTexture(this->colorHandle);
 	}
 	
 	inline void regen(uint32_t width, uint32_t height)
 	{
 		this->width = width;
 		this->height = height;
-		glDeleteFramebuffers(1, &this->handle);
-		glDeleteTextures(1, &this->colorHandle);
-		glCreateFramebuffers(1, &this->handle);
-		this->bindFBO();
-		glViewport(0, 0, this->width, this->height);
-		glScissor(0, 0, this->width, this->height);
-		glCreateTextures(GL_TEXTURE_2D, 1, &this->colorHandle);
-		glTextureStorage2D(this->colorHandle, 1, GL_RGBA32F , this->width, this->height);
-		glNamedFramebufferTexture(this->handle, GL_COLOR_ATTACHMENT0, this->colorHandle, 0);
-		std::vector<GLenum> drawBuffers;
-		drawBuffers.emplace_back(GL_COLOR_ATTACHMENT0);
-		glNamedFramebufferDrawBuffers(this->handle, static_cast<int32_t>(drawBuffers.size()), drawBuffers.data());
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		CommandEncoder::current().forgetTarget(this->handle);
+		CommandEncoder::current().forgetTexture(this->colorHandle);
+		Device::destroyTarget(this->handle);
+		Device::destroyTexture(this->colorHandle);
+		this->handle = Device::createTarget(this->width, this->height, this->colorHandle);
+		CommandEncoder::current().invalidate();
 	}
 	
 	inline void bindFBO()
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, this->handle);
+		CommandEncoder::current().setTarget(this->handle);
 	}
 	
 	inline void bindTexture(uint32_t target)
 	{
-		glBindTextureUnit(target, this->colorHandle);
+		CommandEncoder::current().setTexture(target, this->colorHandle);
 	}
 	
-	uint32_t handle = 0, colorHandle = 0;
-	uint32_t width, height;
-};
-#elif defined(_USEGL33)
-static constexpr char const *guiVertShader = R"(
-#version 330 core
-
-layout(location = 0) in vec3 pos;
-layout(location = 1) in vec2 uv_in;
-out vec2 uv;
-uniform mat4 mvp;
-
-void main()
-{
-	uv = uv_in;
-	gl_Position = mvp * vec4(pos, 1.0f);
-})";
-
-static constexpr char const *guiFragShader = R"(
-#version 330 core
-
-in vec2 uv;
-uniform sampler2D tex;
-out vec4 fragColor;
-
-void main()
-{
-	fragColor = texture(tex, uv);
-})";
-
-struct Mesh
-{
-	inline Mesh()
-	{
-		glGenVertexArrays(1, &this->vao);
-		glGenBuffers(1, &this->vboV);
-		glGenBuffers(1, &this->vboU);
-		
-		glBindVertexArray(this->vao);
-		
-		glBindBuffer(GL_ARRAY_BUFFER, this->vboV);
-		glEnableVertexAttribArray(0);
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), nullptr);
-		glBufferData(GL_ARRAY_BUFFER, 12 * sizeof(float), guiVerts, GL_STATIC_DRAW);
-		
-		glBindBuffer(GL_ARRAY_BUFFER, this->vboU);
-		glEnableVertexAttribArray(1);
-		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), nullptr);
-		glBufferData(GL_ARRAY_BUFFER, 8 * sizeof(float), guiUVs, GL_STATIC_DRAW);
-	}
-	
-	inline ~Mesh()
-	{
-		glDeleteBuffers(1, &this->vboV);
-		glDeleteBuffers(1, &this->vboU);
-		glDeleteVertexArrays(1, &this->vao);
-	}
-	
-	inline void bind()
+	/// Read the color texture back as RGBA8, the software device's rows start at the top and GL's at the bottom
+	inline std::vector<uint32_t> readPixels()
 	{
-		glBindVertexArray(this->vao);
+		std::vector<uint32_t> out(static_cast<size_t>(this->width) * this->height);
+		Device::readTexture(this->colorHandle, this->width, this->height, out.data());
+		CommandEncoder::current().edited();
+		return out;
 	}
 	
-	uint32_t vao = 0, vboV = 0, vboU = 0;
+	Device::Target handle;
+	Device::Texture colorHandle;
+	uint32_t width, height;
 };
 
-struct Shader
+/// Collects quads that sample the same pixmap so they can be drawn with one instanced call
+struct QuadBatch
 {
-	inline Shader()
-	{
-		uint32_t vertHandle = glCreateShader(GL_VERTEX_SHADER), fragHandle = glCreateShader(GL_FRAGMENT_SHADER);
-		this->shaderHandle = glCreateProgram();
-		glShaderSource(vertHandle, 1, &guiVertShader, nullptr);
-		glShaderSource(fragHandle, 1, &guiFragShader, nullptr);
-		glCompileShader(vertHandle);
-		int32_t success = 0;
-		glGetShaderiv(vertHandle, GL_COMPILE_STATUS, &success);
-		if(!success)
-		{
-			int32_t maxLen = 0;
-			glGetShaderiv(vertHandle, GL_INFO_LOG_LENGTH, &maxLen);
-			std::vector<char> error;
-			error.resize(maxLen * sizeof(GLchar));
-			glGetShaderInfoLog(vertHandle, maxLen, &maxLen, error.data());
-			std::string errorStr{error.begin(), error.end()};
-			if(vertHandle == GL_LINK_STATUS) printf("Shader program %u failed to link\n", vertHandle);
-			else printf("Shader failed to compile: %s\n", errorStr.data());
-			return;
-		}
-		glCompileShader(fragHandle);
-		success = 0;
-		glGetShaderiv(fragHandle, GL_COMPILE_STATUS, &success);
-		if(!success)
-		{
-			int32_t maxLen = 0;
-			glGetShaderiv(fragHandle, GL_INFO_LOG_LENGTH, &maxLen);
-			std::vector<char> error;
-			error.resize(maxLen * sizeof(GLchar));
-			glGetShaderInfoLog(fragHandle, maxLen, &maxLen, error.data());
-			std::string errorStr{error.begin(), error.end()};
-			if(fragHandle == GL_LINK_STATUS) printf("Shader program %u failed to link\n", fragHandle);
-			else printf("Shader failed to compile: %s\n", errorStr.data());
-			return;
-		}
-		glAttachShader(this->shaderHandle, vertHandle);
-		glAttachShader(this->shaderHandle, fragHandle);
-		glLinkProgram(this->shaderHandle);
-		success = 0;
-		glGetProgramiv(this->shaderHandle, GL_LINK_STATUS, &success);
-		if(!success)
-		{
-			int32_t maxLen = 0;
-			glGetShaderiv(this->shaderHandle, GL_INFO_LOG_LENGTH, &maxLen);
-			std::vector<char> error;
-			error.resize(maxLen * sizeof(GLchar));
-			glGetShaderInfoLog(this->shaderHandle, maxLen, &maxLen, error.data());
-			std::string errorStr{error.begin(), error.end()};
-			if(this->shaderHandle == GL_LINK_STATUS) printf("Shader program %u failed to link\n", this->shaderHandle);
-			else printf("Shader failed to compile: %s\n", errorStr.data());
-			return;
-		}
-		glDetachShader(this->shaderHandle, vertHandle);
-		glDetachShader(this->shaderHandle, fragHandle);
-		glDeleteShader(vertHandle);
-		glDeleteShader(fragHandle);
-	}
-	
-	inline ~Shader()
-	{
-		glDeleteProgram(this->shaderHandle);
-	}
-	
-	inline void bind()
+	inline void add(QuadInstance const &instance)
 	{
-		glUseProgram(this->shaderHandle);
+		this->instances.push_back(instance);
 	}
 	
-	inline void sendFloat(std::string const &location, float val)
-	{
-		glUniform1f(glGetUniformLocation(this->shaderHandle, location.data()), val);
-	}
-	
-	inline void sendInt(std::string const &location, int32_t val)
-	{
-		glUniform1i(glGetUniformLocation(this->shaderHandle, location.data()), val);
-	}
-	
-	inline void sendUInt(std::string const &location, uint32_t val)
-	{
-		glUniform1ui(glGetUniformLocation(this->shaderHandle, location.data()), val);
-	}
-	
-	inline void sendVec2f(std::string const &location, IR::vec2<float> const &val)
+	/// Add the shape quads of a rect drawn in style, its shadow first.  They sample nothing so they can join a batch of any pixmap
+	inline void addShape(IR::vec4<float> const &rect, ShapeStyle const &style, float layer = 1)
 	{
-		glUniform2fv(glGetUniformLocation(this->shaderHandle, location.data()), 1, val.data);
-	}
-	
-	inline void sendVec3f(std::string const &location, IR::vec3<float> const &val)
-	{
-		glUniform3fv(glGetUniformLocation(this->shaderHandle, location.data()), 1, val.data);
-	}
-	
-	inline void sendVec4f(std::string const &location, IR::vec4<float> const &val)
-	{
-		glUniform4fv(glGetUniformLocation(this->shaderHandle, location.data()), 1, val.data);
-	}
-	
-	inline void sendMat3f(std::string const &location, IR::mat3x3<float> const &val)
-	{
-		glUniformMatrix3fv(glGetUniformLocation(this->shaderHandle, location.data()), 1, GL_FALSE, &val[0][0]);
-	}
-	
-	inline void sendMat4f(std::string const &location, IR::mat4x4<float> const &val)
-	{
-		glUniformMatrix4fv(glGetUniformLocation(this->shaderHandle, location.data()), 1, GL_FALSE, &val[0][0]);
-	}
-
-private:
-	uint32_t shaderHandle = 0;
-};
-
-struct FBO
-{
-	inline FBO()
-	{
-		int dfSz[4];
-		glGetIntegerv(GL_VIEWPORT, dfSz);
-		this->width = static_cast<uint32_t>(dfSz[2]);
-		this->height = static_cast<uint32_t>(dfSz[3]);
-		glGenFramebuffers(1, &this->handle);
-		this->bindFBO();
-		glViewport(0, 0, this->width, this->height);
-		glGenTextures(1, &this->colorHandle);
-		glBindTexture(GL_TEXTURE_2D, this->colorHandle);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, this->width, this->height, 0, GL_RGBA, GL_FLOAT, nullptr);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, this->colorHandle, 0);
-		GLuint drawBuffers[1] = {GL_COLOR_ATTACHMENT0};
-		glDrawBuffers(1, drawBuffers);
-		GLenum error = glCheckFramebufferStatus(GL_FRAMEBUFFER);
-		if(error != GL_FRAMEBUFFER_COMPLETE)
+		if(style.shadowColor.w() > 0)
 		{
-			switch(error)
-			{
-				case GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT: printf("attachment\n"); break;
-				case GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT: printf("missing attachment\n"); break;
-				case GL_FRAMEBUFFER_UNSUPPORTED: printf("fbo not supported\n"); break;
-				default: break;
-			}
+			IR::vec4<float> shadowRect {rect.x() + style.shadowOffset.x(), rect.y() + style.shadowOffset.y(), rect.z(), rect.w()};
+			this->instances.push_back(QuadInstance::shadow(shadowRect, style.radii, style.shadowColor, style.shadowBlur, layer));
 		}
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		this->instances.push_back(QuadInstance::roundedRect(rect, style.radii, style.fill, layer, style.borderWidth, style.borderColor));
 	}
 	
-	inline ~FBO()
+	/// Add the quads of slice stretched over rect, the batch must be drawn with slice's pixmap bound
+	inline void addNineSlice(NineSlice const &slice, IR::vec4<float> const &rect, IR::vec4<float> const &color = {1, 1, 1, 1}, float layer = 1)
 	{
-		glDeleteFramebuffers(1, &this->handle);
-		glDeleteTextures(1, &this->colorHandle);
+		QuadInstance quads[9];
+		this->instances.insert(this->instances.end(), quads, quads + slice.expand(rect, color, layer, quads));
 	}
 	
-	inline void regen(uint32_t width, uint32_t height)
+	/// Add the glyphs of text on atlas page page with its top left at pos, tinted by color.  The batch must be drawn with that page's pixmap bound,
+	/// text spanning several pages takes a batch per page
+	inline void addText(ShapedText const &text, IR::vec2<float> const &pos, IR::vec4<float> const &color = {1, 1, 1, 1}, uint32_t page = 0, float layer = 1)
 	{
-		this->width = width;
-		this->height = height;
-		glDeleteFramebuffers(1, &this->handle);
-		glDeleteTextures(1, &this->colorHandle);
-		glGenFramebuffers(1, &this->handle);
-		this->bindFBO();
-		glViewport(0, 0, this->width, this->height);
-		glGenTextures(1, &this->colorHandle);
-		glBindTexture(GL_TEXTURE_2D, this->colorHandle);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, this->width, this->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
-		glFramebufferTexture(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, this->colorHandle, 0);
-		std::vector<GLenum> drawBuffers;
-		drawBuffers.emplace_back(GL_COLOR_ATTACHMENT0);
-		glDrawBuffers(static_cast<int32_t>(drawBuffers.size()), drawBuffers.data());
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		for(GlyphQuad const &quad : text.quads)
+		{
+			if(quad.page != page) continue;
+			this->instances.push_back({{pos.x() + quad.pos.x(), pos.y() - quad.pos.y(), quad.size.x(), quad.size.y()}, quad.uvRect, color, layer});
+		}
 	}
 	
-	inline void bindFBO()
+	inline void clear()
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, this->handle);
+		this->instances.clear();
 	}
 	
-	inline void bindTexture(uint32_t target)
+	/// Stream and draw every quad added since the last clear, the mesh, instanced shader and pixmap must be bound
+	inline void draw(Mesh &mesh)
 	{
-		glBindTexture(target, this->colorHandle);
+		if(this->instances.empty()) return;
+		WUI_PROFILE_SCOPE("QuadBatch::draw");
+		WUI_PROFILE_GPU_SCOPE("QuadBatch::draw");
+		mesh.uploadInstances(this->instances.data(), this->instances.size());
+		mesh.drawInstanced(this->instances.size());
 	}
 	
-	uint32_t handle = 0, colorHandle = 0, depthHandle = 0;
-	uint32_t width, height;
+	std::vector<QuadInstance> instances;
 };
-#endif
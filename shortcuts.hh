@@ -0,0 +1,188 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+
+/// Modifier keys held with a key press, as a mask
+enum struct KeyMods : uint8_t
+{
+	NONE = 0, CTRL = 1, SHIFT = 2, ALT = 4, SUPER = 8
+};
+
+inline KeyMods operator|(KeyMods a, KeyMods b)
+{
+	return static_cast<KeyMods>(static_cast<uint8_t>(a) | static_cast<uint8_t>(b));
+}
+
+/// One key press of a shortcut, eg ctrl+s
+template <typename Key> struct KeyStroke
+{
+	Key key;
+	KeyMods mods = KeyMods::NONE;
+};
+
+/// Keyboard shortcuts bound to actions, a key press is resolved in O(1) however many are bound.
+/// Single strokes and the first stroke of every chord are looked up in a dense table indexed by modifier mask and scancode,
+/// the strokes after that walk a trie whose edges are hashed by node and stroke.
+/// Feed it every key press and release with keyDown() and keyUp(), modifier keys included, and it tracks which modifiers are held.
+/// keyCount bounds the scancodes, 512 covers SDL's
+template <typename Key, size_t keyCount = 512> struct ShortcutRegistry
+{
+	using Chord = std::vector<KeyStroke<Key>>;
+	
+	/// The registry MenuItem::setShortcut() binds into and MenuBar resolves key presses with
+	inline static ShortcutRegistry &instance()
+	{
+		static ShortcutRegistry out;
+		return out;
+	}
+	
+	inline ShortcutRegistry() : roots(modCount * keyCount, 0), modifierKeys(keyCount, KeyMods::NONE), nodes(1) {}
+	
+	/// Holding key holds mod, eg both left and right control for CTRL
+	inline void setModifierKey(Key key, KeyMods mod)
+	{
+		if(static_cast<size_t>(key) < keyCount) this->modifierKeys[static_cast<size_t>(key)] = mod;
+	}
+	
+	/// Call action when chord is typed, binding a chord again replaces its action.
+	/// A chord that continues another one wins, ctrl+k is never acted on while ctrl+k ctrl+c is bound
+	inline void bind(Chord const &chord, std::function<void()> action)
+	{
+		if(chord.empty() || !this->valid(chord)) return;
+		uint32_t node = this->walk(chord, true);
+		if(!this->nodes[node].action) this->addBindings(chord, 1);
+		this->nodes[node].action = std::move(action);
+	}
+	
+	inline void unbind(Chord const &chord)
+	{
+		if(chord.empty() || !this->valid(chord)) return;
+		uint32_t node = this->walk(chord, false);
+		if(!node || !this->nodes[node].action) return;
+		this->nodes[node].action = nullptr;
+		this->addBindings(chord, -1);
+		this->pendingNode = 0;
+	}
+	
+	/// Resolve a key press, true if it was part of a shortcut and shouldn't be handled as anything else
+	inline bool keyDown(Key key)
+	{
+		size_t code = static_cast<size_t>(key);
+		if(code >= keyCount) return false;
+		if(this->modifierKeys[code] != KeyMods::NONE)
+		{
+			this->held |= static_cast<uint8_t>(this->modifierKeys[code]);
+			return false;
+		}
+		uint32_t stroke = this->strokeCode(key, static_cast<KeyMods>(this->held));
+		uint32_t node;
+		if(!this->pendingNode) node = this->roots[stroke];
+		else
+		{
+			auto it = this->edges.find(static_cast<uint64_t>(this->pendingNode) << 32 | stroke);
+			node = it == this->edges.end() ? 0 : it->second;
+			this->pendingNode = 0;
+			if(!node || !this->nodes[node].bindings) return true; //A chord was started and this broke it, swallow the key rather than acting on it
+		}
+		if(!node || !this->nodes[node].bindings) return false;
+		if(this->nodes[node].bindings > (this->nodes[node].action ? 1u : 0u)) this->pendingNode = node; //Longer chords continue from here
+		else
+		{
+			std::function<void()> action = this->nodes[node].action; //The action may rebind or unbind itself
+			action();
+		}
+		return true;
+	}
+	
+	inline void keyUp(Key key)
+	{
+		size_t code = static_cast<size_t>(key);
+		if(code < keyCount && this->modifierKeys[code] != KeyMods::NONE) this->held &= ~static_cast<uint8_t>(this->modifierKeys[code]);
+	}
+	
+	/// True between the strokes of a chord
+	inline bool pending() const
+	{
+		return this->pendingNode != 0;
+	}
+	
+	inline void cancelChord()
+	{
+		this->pendingNode = 0;
+	}
+	
+	inline KeyMods modifiers() const
+	{
+		return static_cast<KeyMods>(this->held);
+	}
+
+private:
+	static size_t constexpr modCount = 16;
+	
+	/// A chord's prefix, node 0 is the empty one
+	struct Node
+	{
+		std::function<void()> action;
+		uint32_t bindings = 0; //Actions bound here and in every chord continuing from here
+	};
+	
+	inline static uint32_t strokeCode(Key key, KeyMods mods)
+	{
+		return static_cast<uint32_t>((static_cast<size_t>(mods) & (modCount - 1)) * keyCount + static_cast<size_t>(key));
+	}
+	
+	inline static bool valid(Chord const &chord)
+	{
+		for(KeyStroke<Key> const &stroke : chord) if(static_cast<size_t>(stroke.key) >= keyCount) return false;
+		return true;
+	}
+	
+	/// The node chord ends on, created along the way when create is set, otherwise 0 if it doesn't exist
+	inline uint32_t walk(Chord const &chord, bool create)
+	{
+		uint32_t node = 0;
+		for(size_t i = 0; i < chord.size(); i++)
+		{
+			uint32_t stroke = strokeCode(chord[i].key, chord[i].mods);
+			uint32_t *next;
+			if(i == 0) next = &this->roots[stroke];
+			else
+			{
+				auto it = this->edges.find(static_cast<uint64_t>(node) << 32 | stroke);
+				if(it != this->edges.end()) next = &it->second;
+				else if(!create) return 0;
+				else next = &this->edges[static_cast<uint64_t>(node) << 32 | stroke];
+			}
+			if(!*next)
+			{
+				if(!create) return 0;
+				*next = static_cast<uint32_t>(this->nodes.size());
+				this->nodes.emplace_back();
+			}
+			node = *next;
+		}
+		return node;
+	}
+	
+	inline void addBindings(Chord const &chord, int32_t delta)
+	{
+		uint32_t node = 0;
+		for(size_t i = 0; i < chord.size(); i++)
+		{
+			uint32_t stroke = strokeCode(chord[i].key, chord[i].mods);
+			node = i == 0 ? this->roots[stroke] : this->edges[static_cast<uint64_t>(node) << 32 | stroke];
+			this->nodes[node].bindings += delta;
+		}
+	}
+	
+	std::vector<uint32_t> roots; //The node of every single stroke, 0 if nothing starts with it
+	std::vector<KeyMods> modifierKeys;
+	std::vector<Node> nodes;
+	std::unordered_map<uint64_t, uint32_t> edges; //Node << 32 | stroke to the node after it
+	uint32_t pendingNode = 0;
+	uint8_t held = 0;
+};
@@ -3,6 +3,7 @@
 #include "util.hh"
 #include "definitions.hh"
 #include "observer.hh"
+#include "profiler.hh"
 
 #include <functional>
 
@@ -62,6 +63,7 @@ template <typename... Args> struct Signal
 	
 	inline void fire(Args ... args)
 	{
+		WUI_PROFILE_SCOPE("Signal::fire");
 		this->sl.lock();
 		for(Callback &callback : this->cbs)
 		{
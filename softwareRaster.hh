@@ -0,0 +1,460 @@
+#pragma once
+
+#include "util.hh"
+#include "renderTypes.hh"
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <iris/vec4.hh>
+#include <iris/mat4.hh>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/// Packs 8 bit channels into a texel, R in the lowest byte like GL_RGBA/GL_UNSIGNED_BYTE
+inline constexpr uint32_t packRGBA(uint32_t r, uint32_t g, uint32_t b, uint32_t a)
+{
+	return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+/// A normalized float channel as 8 bits
+inline uint32_t packUnorm(float value)
+{
+	return static_cast<uint32_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+/// RGBA8 texels with straight alpha, row 0 at the top
+struct SoftwareTexture
+{
+	inline void resize(uint32_t width, uint32_t height)
+	{
+		this->width = width;
+		this->height = height;
+		this->texels.assign(static_cast<size_t>(width) * height, 0);
+	}
+
+	uint32_t width = 0, height = 0;
+	std::vector<uint32_t> texels;
+	uint32_t fullWidth = 0, fullHeight = 0, level = 0; //Size of level 0 and which level texels holds, for mipmapped pixmaps
+};
+
+/// A screen space quad waiting to be rasterized, bounds are half open pixels with y down
+struct SoftwareQuad
+{
+	int32_t minX, minY, maxX, maxY;
+	float u0, v0, dudx, dvdy; //Texture coordinate at the center of pixel minX, minY and its step per pixel
+	SoftwareTexture const *texture; //Null for a solid color
+	uint32_t color; //Multiplied with each texel
+	bool blend;
+	int32_t shape = -1; //Index of its SoftwareShape, or -1 to sample texture
+};
+
+/// The rounded rect a shape quad covers in pixels with y down, the same parameters the instanced shaders get
+struct SoftwareShape
+{
+	float centerX, centerY, halfWidth, halfHeight;
+	IR::vec4<float> radii;
+	float borderWidth, blur;
+	uint32_t borderColor;
+};
+
+/// Rasterizes the same textured quads the GL backends draw into a CPU framebuffer, used when WUI_SOFTWARE is defined.
+/// It mirrors GL's state machine: SoftwareDevice binds state here and draws are queued as quads.
+/// flush() bins the queued quads into tiles and rasterizes the tiles in parallel, each tile keeps submission order so blending matches GL.
+/// Only axis aligned quads are supported, which is all the widgets draw, and textures are sampled nearest
+struct SoftwareRasterizer final
+{
+	static constexpr int32_t tileSize = 64;
+
+	inline static SoftwareRasterizer &instance()
+	{
+		static SoftwareRasterizer out;
+		return out;
+	}
+
+	/// The size new FBOs are created with, the GL backends read it from GL_VIEWPORT
+	inline void setViewport(uint32_t width, uint32_t height)
+	{
+		this->viewportWidth = width;
+		this->viewportHeight = height;
+	}
+
+	inline void bindTarget(SoftwareTexture *target)
+	{
+		if(target != this->target) this->flush();
+		this->target = target;
+	}
+
+	inline SoftwareTexture *boundTarget() const
+	{
+		return this->target;
+	}
+
+	inline void bindTexture(SoftwareTexture const *texture)
+	{
+		this->texture = texture;
+	}
+
+	/// Replace every pixel of the bound target
+	inline void clear(uint32_t color)
+	{
+		if(!this->target) return;
+		SoftwareQuad quad {0, 0, static_cast<int32_t>(this->target->width), static_cast<int32_t>(this->target->height), 0, 0, 0, 0, nullptr, color, false};
+		if(this->clip(quad)) this->quads.push_back(quad);
+	}
+	
+	/// Rectangle in pixels with the origin at the bottom left like glScissor, draws and clears outside it are discarded
+	inline void setScissor(bool enabled, int32_t x = 0, int32_t y = 0, int32_t width = 0, int32_t height = 0)
+	{
+		this->scissoring = enabled;
+		this->scissor[0] = x;
+		this->scissor[1] = y;
+		this->scissor[2] = width;
+		this->scissor[3] = height;
+	}
+
+	/// Queue the unit GUI quad transformed by a model view projection matrix, with the bound texture
+	inline void drawQuad(IR::mat4x4<float> mvp, uint32_t color = 0xFFFFFFFF)
+	{
+		IR::vec4<float> first = mvp * IR::vec4<float>{0, 0, 0, 1}, second = mvp * IR::vec4<float>{1, -1, 0, 1};
+		this->queue(first, second, {0, 0, 1, 1}, color);
+	}
+
+	/// Queue an instanced quad, rect is x y width height with y up before projection
+	inline void drawRect(IR::mat4x4<float> projection, IR::vec4<float> const &rect, IR::vec4<float> const &uvRect, uint32_t color, float layer)
+	{
+		IR::vec4<float> first = projection * IR::vec4<float>{rect.x(), rect.y(), layer, 1}, second = projection * IR::vec4<float>{rect.x() + rect.z(), rect.y() - rect.w(), layer, 1};
+		this->queue(first, second, uvRect, color);
+	}
+	
+	/// Queue an instanced shape quad, see QuadInstance::roundedRect().  Its distances are in pixels of rect, scaled with it by the projection
+	inline void drawShape(IR::mat4x4<float> projection, IR::vec4<float> const &rect, IR::vec4<float> const &radii, uint32_t color, uint32_t borderColor,
+	                      IR::vec4<float> const &shape, float layer)
+	{
+		IR::vec4<float> first = projection * IR::vec4<float>{rect.x(), rect.y(), layer, 1}, second = projection * IR::vec4<float>{rect.x() + rect.z(), rect.y() - rect.w(), layer, 1};
+		SoftwareShape params {0, 0, 0, 0, radii, shape.x(), shape.y(), borderColor};
+		this->queue(first, second, {0, 0, 1, 1}, color, &params, shape.z(), rect.z());
+	}
+
+	/// Rasterize everything queued into the bound target, call before reading its texels
+	inline void flush()
+	{
+		if(this->quads.empty() || !this->target)
+		{
+			this->quads.clear();
+			this->shapes.clear();
+			return;
+		}
+		this->tilesX = (static_cast<int32_t>(this->target->width) + tileSize - 1) / tileSize;
+		int32_t tilesY = (static_cast<int32_t>(this->target->height) + tileSize - 1) / tileSize;
+		size_t tileCount = static_cast<size_t>(this->tilesX * tilesY);
+		if(this->bins.size() < tileCount) this->bins.resize(tileCount);
+		for(size_t i = 0; i < tileCount; i++) this->bins[i].clear();
+		for(uint32_t i = 0; i < this->quads.size(); i++)
+		{
+			SoftwareQuad const &quad = this->quads[i];
+			for(int32_t ty = quad.minY / tileSize; ty <= (quad.maxY - 1) / tileSize; ty++)
+			{
+				for(int32_t tx = quad.minX / tileSize; tx <= (quad.maxX - 1) / tileSize; tx++) this->bins[ty * this->tilesX + tx].push_back(i);
+			}
+		}
+		std::atomic<size_t> nextTile {0}, finishedJobs {0};
+		size_t jobs = this->pool.threadCount();
+		auto work = [&]
+		{
+			for(size_t tile = nextTile++; tile < tileCount; tile = nextTile++) this->rasterTile(tile);
+			finishedJobs++;
+		};
+		for(size_t i = 0; i < jobs; i++) this->pool.enqueue(work);
+		work();
+		while(finishedJobs.load() < jobs + 1) std::this_thread::yield();
+		this->quads.clear();
+		this->shapes.clear();
+	}
+
+	inline size_t queued() const
+	{
+		return this->quads.size();
+	}
+
+	/// Uniform state of the bound pipeline, read when a draw is queued
+	IR::mat4x4<float> const *mvp = nullptr, *projection = nullptr;
+	uint32_t const *tint = nullptr;
+	/// Whether queued quads blend like glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA) or replace what's under them
+	bool blending = true;
+	uint32_t viewportWidth = 0, viewportHeight = 0;
+
+private:
+	inline SoftwareRasterizer() = default;
+
+	/// Turn two clip space corners into a pixel rect, covering the pixels whose centers fall inside it like GL does.
+	/// A shape is placed inside the rect inset by inset, its lengths are in the units of a rect unitWidth wide and scaled to pixels
+	inline void queue(IR::vec4<float> const &first, IR::vec4<float> const &second, IR::vec4<float> const &uvRect, uint32_t color,
+	                  SoftwareShape const *shape = nullptr, float inset = 0, float unitWidth = 1)
+	{
+		if(!this->target) return;
+		float width = static_cast<float>(this->target->width), height = static_cast<float>(this->target->height);
+		float x0 = (first.x() / first.w() * 0.5f + 0.5f) * width, y0 = (0.5f - first.y() / first.w() * 0.5f) * height;
+		float x1 = (second.x() / second.w() * 0.5f + 0.5f) * width, y1 = (0.5f - second.y() / second.w() * 0.5f) * height;
+		if(x0 == x1 || y0 == y1) return;
+		SoftwareQuad quad;
+		quad.minX = std::max(0, static_cast<int32_t>(std::ceil(std::min(x0, x1) - 0.5f)));
+		quad.maxX = std::min(static_cast<int32_t>(width), static_cast<int32_t>(std::ceil(std::max(x0, x1) - 0.5f)));
+		quad.minY = std::max(0, static_cast<int32_t>(std::ceil(std::min(y0, y1) - 0.5f)));
+		quad.maxY = std::min(static_cast<int32_t>(height), static_cast<int32_t>(std::ceil(std::max(y0, y1) - 0.5f)));
+		if(!this->clip(quad)) return;
+		quad.dudx = (uvRect.z() - uvRect.x()) / (x1 - x0);
+		quad.dvdy = (uvRect.w() - uvRect.y()) / (y1 - y0);
+		quad.u0 = uvRect.x() + (static_cast<float>(quad.minX) + 0.5f - x0) * quad.dudx;
+		quad.v0 = uvRect.y() + (static_cast<float>(quad.minY) + 0.5f - y0) * quad.dvdy;
+		quad.texture = this->texture;
+		quad.color = color;
+		quad.blend = this->blending;
+		if(shape)
+		{
+			float scale = std::abs(x1 - x0) / std::max(unitWidth, 1e-6f);
+			SoftwareShape placed = *shape;
+			placed.centerX = (x0 + x1) * 0.5f;
+			placed.centerY = (y0 + y1) * 0.5f;
+			placed.halfWidth = std::max(std::abs(x1 - x0) * 0.5f - inset * scale, 0.0f);
+			placed.halfHeight = std::max(std::abs(y1 - y0) * 0.5f - inset * scale, 0.0f);
+			placed.radii = shape->radii * scale;
+			placed.borderWidth *= scale;
+			placed.blur *= scale;
+			quad.shape = static_cast<int32_t>(this->shapes.size());
+			this->shapes.push_back(placed);
+		}
+		this->quads.push_back(quad);
+	}
+
+	/// Clamp a quad to the scissor rect, false when nothing is left
+	inline bool clip(SoftwareQuad &quad) const
+	{
+		if(this->scissoring)
+		{
+			int32_t top = static_cast<int32_t>(this->target->height) - this->scissor[1] - this->scissor[3];
+			quad.minX = std::max(quad.minX, this->scissor[0]);
+			quad.maxX = std::min(quad.maxX, this->scissor[0] + this->scissor[2]);
+			quad.minY = std::max(quad.minY, top);
+			quad.maxY = std::min(quad.maxY, top + this->scissor[3]);
+		}
+		return quad.minX < quad.maxX && quad.minY < quad.maxY;
+	}
+	
+	inline static uint32_t div255(uint32_t x)
+	{
+		x += 128;
+		return (x + (x >> 8)) >> 8;
+	}
+
+	inline static uint32_t modulate(uint32_t texel, uint32_t color)
+	{
+		if(color == 0xFFFFFFFF) return texel;
+		uint32_t out = 0;
+		for(uint32_t shift = 0; shift < 32; shift += 8) out |= div255(((texel >> shift) & 0xFF) * ((color >> shift) & 0xFF)) << shift;
+		return out;
+	}
+
+	/// glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA) on all four channels
+	inline static uint32_t blendScalar(uint32_t src, uint32_t dst)
+	{
+		uint32_t alpha = src >> 24, out = 0;
+		for(uint32_t shift = 0; shift < 32; shift += 8) out |= div255(((src >> shift) & 0xFF) * alpha + ((dst >> shift) & 0xFF) * (255 - alpha)) << shift;
+		return out;
+	}
+
+#if defined(__SSE2__)
+	inline static __m128i div255(__m128i x)
+	{
+		x = _mm_add_epi16(x, _mm_set1_epi16(128));
+		return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+	}
+
+	/// Blends 4 pixels at once in 16 bit lanes, src * a + dst * (255 - a) can't exceed 65025 so nothing overflows
+	inline static __m128i blend4(__m128i src, __m128i dst)
+	{
+		__m128i zero = _mm_setzero_si128(), full = _mm_set1_epi16(255);
+		__m128i srcLo = _mm_unpacklo_epi8(src, zero), srcHi = _mm_unpackhi_epi8(src, zero);
+		__m128i dstLo = _mm_unpacklo_epi8(dst, zero), dstHi = _mm_unpackhi_epi8(dst, zero);
+		__m128i alphaLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(srcLo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+		__m128i alphaHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(srcHi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+		__m128i lo = div255(_mm_add_epi16(_mm_mullo_epi16(srcLo, alphaLo), _mm_mullo_epi16(dstLo, _mm_sub_epi16(full, alphaLo))));
+		__m128i hi = div255(_mm_add_epi16(_mm_mullo_epi16(srcHi, alphaHi), _mm_mullo_epi16(dstHi, _mm_sub_epi16(full, alphaHi))));
+		return _mm_packus_epi16(lo, hi);
+	}
+
+	inline static __m128i modulate4(__m128i texels, __m128i colorLanes)
+	{
+		__m128i zero = _mm_setzero_si128();
+		__m128i lo = div255(_mm_mullo_epi16(_mm_unpacklo_epi8(texels, zero), colorLanes));
+		__m128i hi = div255(_mm_mullo_epi16(_mm_unpackhi_epi8(texels, zero), colorLanes));
+		return _mm_packus_epi16(lo, hi);
+	}
+#endif
+
+	/// Blend a constant color across a span
+	inline static void fillSpan(uint32_t *dst, int32_t count, uint32_t src, bool blend)
+	{
+		uint32_t alpha = src >> 24;
+		if(!blend || alpha == 255)
+		{
+			std::fill(dst, dst + count, src);
+			return;
+		}
+		if(alpha == 0) return;
+		int32_t x = 0;
+#if defined(__SSE2__)
+		__m128i src4 = _mm_set1_epi32(static_cast<int32_t>(src));
+		for(; x + 4 <= count; x += 4)
+		{
+			__m128i *pixels = reinterpret_cast<__m128i *>(dst + x);
+			_mm_storeu_si128(pixels, blend4(src4, _mm_loadu_si128(pixels)));
+		}
+#endif
+		for(; x < count; x++) dst[x] = blendScalar(src, dst[x]);
+	}
+
+	/// Blend a span of colors, or copy them without blending
+	inline static void blendSpan(uint32_t *dst, uint32_t const *src, int32_t count, bool blend)
+	{
+		if(!blend)
+		{
+			std::copy(src, src + count, dst);
+			return;
+		}
+		int32_t x = 0;
+#if defined(__SSE2__)
+		for(; x + 4 <= count; x += 4)
+		{
+			__m128i *pixels = reinterpret_cast<__m128i *>(dst + x);
+			_mm_storeu_si128(pixels, blend4(_mm_loadu_si128(reinterpret_cast<__m128i const *>(src + x)), _mm_loadu_si128(pixels)));
+		}
+#endif
+		for(; x < count; x++) dst[x] = blendScalar(src[x], dst[x]);
+	}
+
+	/// Sample and blend a textured span, or store the modulated texels without blending.  u and du are in texels
+	inline static void textureSpan(uint32_t *dst, int32_t count, uint32_t const *row, int32_t rowWidth, float u, float du, uint32_t color, bool blend)
+	{
+		auto texel = [&](int32_t x)
+		{
+			return row[std::clamp(static_cast<int32_t>(std::floor(u + du * static_cast<float>(x))), 0, rowWidth - 1)];
+		};
+		int32_t x = 0;
+#if defined(__SSE2__)
+		__m128i colorLanes = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int32_t>(color)), _mm_setzero_si128());
+		for(; x + 4 <= count; x += 4)
+		{
+			__m128i src = _mm_set_epi32(static_cast<int32_t>(texel(x + 3)), static_cast<int32_t>(texel(x + 2)), static_cast<int32_t>(texel(x + 1)), static_cast<int32_t>(texel(x)));
+			if(color != 0xFFFFFFFF) src = modulate4(src, colorLanes);
+			__m128i *pixels = reinterpret_cast<__m128i *>(dst + x);
+			_mm_storeu_si128(pixels, blend ? blend4(src, _mm_loadu_si128(pixels)) : src);
+		}
+#endif
+		for(; x < count; x++) dst[x] = blend ? blendScalar(modulate(texel(x), color), dst[x]) : modulate(texel(x), color);
+	}
+
+	/// a and b mixed by t in 1/256ths, with alpha then scaled by coverage in 1/256ths
+	inline static uint32_t mixCoverage(uint32_t a, uint32_t b, uint32_t t, uint32_t coverage)
+	{
+		uint32_t out = 0;
+		for(uint32_t shift = 0; shift < 32; shift += 8) out |= ((((a >> shift) & 0xFF) * (256 - t) + ((b >> shift) & 0xFF) * t) >> 8) << shift;
+		return (out & 0xFFFFFF) | (((out >> 24) * coverage) >> 8) << 24;
+	}
+
+	/// The color of a shape pixel distance pixels outside its edge
+	inline static uint32_t shapeColor(SoftwareQuad const &quad, SoftwareShape const &shape, float distance)
+	{
+		float soft = std::max(shape.blur, 0.5f), t = std::clamp((distance + soft) / (soft * 2), 0.0f, 1.0f);
+		uint32_t coverage = static_cast<uint32_t>((1 - t * t * (3 - t * 2)) * 256.0f);
+		uint32_t border = shape.borderWidth > 0 ? static_cast<uint32_t>(std::clamp(distance + shape.borderWidth + 0.5f, 0.0f, 1.0f) * 256.0f) : 0;
+		if(!border) return (quad.color & 0xFFFFFF) | ((quad.color >> 24) * coverage >> 8) << 24;
+		return mixCoverage(quad.color, shape.borderColor, border, coverage);
+	}
+
+	/// Rasterize the part of a shape quad in a tile.  Away from the corners the distance to the edge only changes across a row near its ends,
+	/// so the middle of each row is filled with one color like a solid quad and only the ends are evaluated per pixel.
+	/// Rows further than band inside the top and bottom edges all have the same ends, they're evaluated once and reused
+	inline void shapeRect(SoftwareQuad const &quad, SoftwareShape const &shape, int32_t minX, int32_t maxX, int32_t minY, int32_t maxY)
+	{
+		float limit = std::min(shape.halfWidth, shape.halfHeight);
+		float band = std::max(std::max(shape.blur, 0.5f), shape.borderWidth + 1); //Pixels further than this inside are all the fill color
+		uint32_t ends[tileSize], fill = shapeColor(quad, shape, -band); //Spans never cross a tile
+		bool endsReady = false;
+		for(int32_t y = minY; y < maxY; y++)
+		{
+			uint32_t *row = &this->target->texels[static_cast<size_t>(y) * this->target->width];
+			float py = static_cast<float>(y) + 0.5f - shape.centerY, rowDistance = std::abs(py) - shape.halfHeight;
+			float left = std::clamp(py < 0 ? shape.radii.x() : shape.radii.w(), 0.0f, limit), right = std::clamp(py < 0 ? shape.radii.y() : shape.radii.z(), 0.0f, limit);
+			bool inner = rowDistance <= -band - std::max(left, right);
+			//How far either side of the center every pixel is the same color
+			float middleLeft = inner ? shape.halfWidth - band : rowDistance > -left ? shape.halfWidth - left : shape.halfWidth + rowDistance;
+			float middleRight = inner ? shape.halfWidth - band : rowDistance > -right ? shape.halfWidth - right : shape.halfWidth + rowDistance;
+			int32_t middleMin = std::clamp(static_cast<int32_t>(std::ceil(shape.centerX - middleLeft - 0.5f)), minX, maxX);
+			int32_t middleMax = std::clamp(static_cast<int32_t>(std::floor(shape.centerX + middleRight - 0.5f)) + 1, middleMin, maxX);
+			if(middleMin < middleMax) fillSpan(row + middleMin, middleMax - middleMin, inner ? fill : shapeColor(quad, shape, rowDistance), quad.blend);
+			uint32_t rowEnds[tileSize], *src = inner ? ends : rowEnds;
+			if(!inner || !endsReady)
+			{
+				auto evaluate = [&](int32_t from, int32_t to)
+				{
+					for(int32_t x = from; x < to; x++) src[x - minX] = shapeColor(quad, shape, roundedBoxDistance(static_cast<float>(x) + 0.5f - shape.centerX, py, shape.halfWidth, shape.halfHeight, shape.radii));
+				};
+				evaluate(minX, middleMin);
+				evaluate(middleMax, maxX);
+				endsReady |= inner;
+			}
+			blendSpan(row + minX, src, middleMin - minX, quad.blend);
+			blendSpan(row + middleMax, src + (middleMax - minX), maxX - middleMax, quad.blend);
+		}
+	}
+
+	inline void rasterTile(size_t tile)
+	{
+		int32_t tileMinX = static_cast<int32_t>(tile % this->tilesX) * tileSize, tileMinY = static_cast<int32_t>(tile / this->tilesX) * tileSize;
+		int32_t tileMaxX = std::min(tileMinX + tileSize, static_cast<int32_t>(this->target->width));
+		int32_t tileMaxY = std::min(tileMinY + tileSize, static_cast<int32_t>(this->target->height));
+		for(uint32_t index : this->bins[tile])
+		{
+			SoftwareQuad const &quad = this->quads[index];
+			int32_t minX = std::max(quad.minX, tileMinX), maxX = std::min(quad.maxX, tileMaxX);
+			int32_t minY = std::max(quad.minY, tileMinY), maxY = std::min(quad.maxY, tileMaxY);
+			if(quad.shape >= 0)
+			{
+				this->shapeRect(quad, this->shapes[quad.shape], minX, maxX, minY, maxY);
+				continue;
+			}
+			SoftwareTexture const *texture = quad.texture;
+			bool solid = !texture || (texture->width == 1 && texture->height == 1);
+			uint32_t solidColor = !texture ? quad.color : solid ? modulate(texture->texels[0], quad.color) : 0;
+			for(int32_t y = minY; y < maxY; y++)
+			{
+				uint32_t *dst = &this->target->texels[static_cast<size_t>(y) * this->target->width + minX];
+				if(solid)
+				{
+					fillSpan(dst, maxX - minX, solidColor, quad.blend);
+					continue;
+				}
+				float v = quad.v0 + quad.dvdy * static_cast<float>(y - quad.minY);
+				int32_t texelY = std::clamp(static_cast<int32_t>(std::floor(v * static_cast<float>(texture->height))), 0, static_cast<int32_t>(texture->height) - 1);
+				float u = (quad.u0 + quad.dudx * static_cast<float>(minX - quad.minX)) * static_cast<float>(texture->width);
+				textureSpan(dst, maxX - minX, &texture->texels[static_cast<size_t>(texelY) * texture->width], static_cast<int32_t>(texture->width),
+				            u, quad.dudx * static_cast<float>(texture->width), quad.color, quad.blend);
+			}
+		}
+	}
+
+	SoftwareTexture *target = nullptr;
+	SoftwareTexture const *texture = nullptr;
+	bool scissoring = false;
+	int32_t scissor[4] {};
+	std::vector<SoftwareQuad> quads;
+	std::vector<SoftwareShape> shapes;
+	std::vector<std::vector<uint32_t>> bins;
+	int32_t tilesX = 0;
+	WorkerPool pool;
+};
@@ -61,14 +61,24 @@ int main()
 	
 	testButton->stateChanged.connect(testButton->connectionObserver, [](bool down) { printf("Lambda\n"); }); //Connect this signal to a lambda
 	testButton->onHover.connect(testButton->connectionObserver, &printCB); //Connect this signal to a function pointer
+	testButton->onHover.connect(testButton->connectionObserver, [button = testButton.get()] { button->animateOpacity(0.6f, 0.15f); }); //Fade on hover
 	
 	testButton->stateChanged.fire(true); //Manually test the signals.  fire() is called internally by the widget on an event, don't manually fire any signal in a real application
 	testButton->onHover.fire();
 	
+	FramePacer &pacer = FramePacer::instance(); //Tracks whether any widget changed, so we only draw frames that differ
+	pacer.setWakeCallback([] //Background work like a BackgroundTask invalidates from its worker thread, wake the event wait below when it does
+	{
+		SDL_Event wake {};
+		wake.type = SDL_USEREVENT;
+		SDL_PushEvent(&wake);
+	});
 	SDL_Event event;
 	do
 	{
-		while(SDL_PollEvent(&event) != 0)
+		//Sleep until there's input or the next frame is due instead of redrawing identical frames
+		bool hasEvent = pacer.needsRedraw() ? SDL_PollEvent(&event) : SDL_WaitEventTimeout(&event, pacer.millisecondsUntilDeadline());
+		while(hasEvent)
 		{
 			switch(event.type)
 			{
@@ -77,10 +87,16 @@ int main()
 					break;
 				case SDL_KEYDOWN: //update the 
 					break;
+				case SDL_WINDOWEVENT: pacer.invalidate(); //exposed or resized, the window contents must be drawn again
+					break;
 				default: break;
 			}
+			hasEvent = SDL_PollEvent(&event);
 		}
+		if(!pacer.needsRedraw()) continue;
 		
+		pacer.beginFrame();
+		Animator::instance().update(); //Advance every running tween, widgets they touch are marked dirty
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 		//render
 		SDL_GL_SwapWindow(window);
@@ -0,0 +1,338 @@
+#pragma once
+
+#include "util.hh"
+#include "definitions.hh"
+#include "pixmap.hh"
+#include "fontCache.hh"
+#include "profiler.hh"
+#include "framePacing.hh"
+#include "shapedText.hh"
+
+#include <pango/pangocairo.h>
+#include <unordered_map>
+#include <vector>
+#include <deque>
+#include <string>
+#include <cstring>
+#include <atomic>
+#include <iris/vec2.hh>
+#include <iris/vec4.hh>
+
+/// A glyph rasterized into the atlas, offset is from the pen position on the baseline to the top left of the bitmap
+struct GlyphSlot
+{
+	IR::vec2<int32_t> offset, size;
+	IR::vec4<float> uvRect; //minU minV maxU maxV
+	uint32_t page = 0; //Index into GlyphAtlas::pixmaps
+	uint64_t generation = 0; //When it was inserted, it is drawable once GlyphAtlas::uploadedGeneration() reaches this
+};
+
+/// Glyph bitmaps packed onto shelves of RGBA pages, white with coverage in alpha so the text can be tinted when drawn.
+/// Workers insert glyphs into the CPU copy, the GL thread uploads the rows that changed in the order they were inserted.
+/// A new page is started when one fills up, once there are maxPages further glyphs are dropped and counted by dropped()
+struct GlyphAtlas final
+{
+	static constexpr uint32_t pageSize = 1024;
+	static constexpr uint32_t padding = 1;
+	static constexpr uint32_t maxPages = 8;
+
+	/// Look up a glyph that has already been rasterized
+	inline bool find(uint64_t key, GlyphSlot &out)
+	{
+		this->sl.lock();
+		auto it = this->slots.find(key);
+		bool found = it != this->slots.end();
+		if(found) out = it->second;
+		this->sl.unlock();
+		return found;
+	}
+
+	/// Copy an 8 bit coverage bitmap into the atlas, returns false if it was dropped because every page is full
+	inline bool insert(uint64_t key, IR::vec2<int32_t> const &offset, uint32_t width, uint32_t height, unsigned char const *coverage, int32_t stride, GlyphSlot &out)
+	{
+		this->sl.lock();
+		auto it = this->slots.find(key);
+		if(it != this->slots.end())
+		{
+			out = it->second;
+			this->sl.unlock();
+			return true;
+		}
+		if(!width || !height) //Nothing to draw or upload, but remembered so it isn't rasterized again
+		{
+			out = {offset, {}, {}, 0, 0};
+			this->slots.emplace(key, out);
+			this->sl.unlock();
+			return true;
+		}
+		if(width + padding * 2 > pageSize || height + padding * 2 > pageSize)
+		{
+			this->sl.unlock();
+			this->droppedGlyphs++;
+			return false;
+		}
+		if(this->penX + width + padding > pageSize)
+		{
+			this->penX = padding;
+			this->penY += this->shelfHeight + padding;
+			this->shelfHeight = 0;
+		}
+		if(this->pages.empty() || this->penY + height + padding > pageSize)
+		{
+			if(this->pages.size() == maxPages)
+			{
+				this->sl.unlock();
+				this->droppedGlyphs++;
+				return false;
+			}
+			this->pages.emplace_back(static_cast<size_t>(pageSize) * pageSize * 4, 255);
+			std::vector<unsigned char> &page = this->pages.back();
+			for(size_t i = 3; i < page.size(); i += 4) page[i] = 0;
+			this->penX = padding;
+			this->penY = padding;
+			this->shelfHeight = 0;
+		}
+		uint32_t page = static_cast<uint32_t>(this->pages.size() - 1);
+		for(uint32_t row = 0; row < height; row++)
+		{
+			unsigned char *dst = &this->pages[page][(static_cast<size_t>(this->penY + row) * pageSize + this->penX) * 4];
+			for(uint32_t col = 0; col < width; col++) dst[col * 4 + 3] = coverage[row * stride + col];
+		}
+		out.offset = offset;
+		out.size = {static_cast<int32_t>(width), static_cast<int32_t>(height)};
+		out.uvRect = {static_cast<float>(this->penX) / pageSize, static_cast<float>(this->penY) / pageSize,
+		              static_cast<float>(this->penX + width) / pageSize, static_cast<float>(this->penY + height) / pageSize};
+		out.page = page;
+		out.generation = ++this->insertGeneration;
+		this->slots.emplace(key, out);
+		//Glyphs on the shelf still waiting join its rows, so a flood of glyphs queues one range per shelf
+		if(!this->dirty.empty() && this->dirty.back().page == page && this->dirty.back().maxY > this->penY)
+		{
+			DirtyRows &last = this->dirty.back();
+			last.minY = std::min(last.minY, this->penY);
+			last.maxY = std::max(last.maxY, this->penY + height);
+			last.generation = out.generation;
+		}
+		else this->dirty.push_back({out.generation, page, this->penY, this->penY + height});
+		this->penX += width + padding;
+		this->shelfHeight = std::max(this->shelfHeight, height);
+		this->sl.unlock();
+		return true;
+	}
+
+	/// Must be called on the GL thread, uploads changed rows oldest first until byteBudget worth have gone up, at least one row, and leaves the rest for the next frame
+	inline void upload(size_t byteBudget)
+	{
+		uint32_t budget = std::max(1u, static_cast<uint32_t>(std::min<size_t>(byteBudget / (pageSize * 4), pageSize)));
+		this->sl.lock();
+		while(this->pixmaps.size() < this->pages.size()) //Start from the cleared CPU page, GL leaves new storage undefined
+		{
+			this->pixmaps.push_back(MS<Pixmap>(nullptr, pageSize, pageSize, true));
+			this->pixmaps.back()->update(0, 0, pageSize, pageSize, this->pages[this->pixmaps.size() - 1].data());
+		}
+		while(budget && !this->dirty.empty())
+		{
+			DirtyRows &next = this->dirty.front();
+			uint32_t rows = std::min(next.maxY - next.minY, budget);
+			this->pixmaps[next.page]->update(0, next.minY, pageSize, rows, &this->pages[next.page][static_cast<size_t>(next.minY) * pageSize * 4]);
+			next.minY += rows;
+			budget -= rows;
+			if(next.minY < next.maxY) break;
+			this->uploaded = next.generation;
+			this->dirty.pop_front();
+		}
+		this->sl.unlock();
+	}
+
+	/// Every glyph whose GlyphSlot::generation is at most this has reached the GPU
+	inline uint64_t uploadedGeneration()
+	{
+		this->sl.lock();
+		uint64_t out = this->uploaded;
+		this->sl.unlock();
+		return out;
+	}
+
+	/// Glyphs that didn't fit once every page was full, they are left out of the text that uses them
+	inline uint64_t dropped() const
+	{
+		return this->droppedGlyphs.load();
+	}
+
+	std::vector<SP<Pixmap>> pixmaps; //One per page, GL thread only
+
+private:
+	std::vector<std::vector<unsigned char>> pages;
+	std::unordered_map<uint64_t, GlyphSlot> slots;
+	uint32_t penX = padding, penY = padding, shelfHeight = 0;
+	/// Rows changed since the last upload and the newest glyph in them
+	struct DirtyRows
+	{
+		uint64_t generation;
+		uint32_t page, minY, maxY;
+	};
+
+	std::deque<DirtyRows> dirty;
+	uint64_t insertGeneration = 0, uploaded = 0;
+	std::atomic<uint64_t> droppedGlyphs {0};
+	Spinlock sl;
+};
+
+/// Shapes text with Pango and rasterizes new glyphs on a worker pool.
+/// The GL thread only calls finalize() once per frame to upload finished atlas rows and swap in completed layouts
+struct TextPipeline final
+{
+	/// Workers load the FontCache warmup list as soon as they start, rather than on the first text they shape
+	inline explicit TextPipeline(size_t threadCount = std::max(2u, std::thread::hardware_concurrency()) - 1) : pool(threadCount, []{FontCache::local();}) {}
+
+	/// Queue text to be shaped off-thread, the layout keeps showing its previous result until the new one is finalized
+	inline void shape(SP<TextLayout> const &layout, std::string text, FontKey font, int32_t maxWidth = -1)
+	{
+		uint64_t generation = ++layout->requestedGeneration;
+		WP<TextLayout> weakLayout = layout;
+		this->pool.enqueue([this, weakLayout, generation, text = std::move(text), font = std::move(font), maxWidth]
+		{
+			SP<TextLayout> target = weakLayout.lock();
+			if(!target || target->requestedGeneration.load() != generation) return; //superseded before we started
+			WUI_PROFILE_SCOPE("TextPipeline::shape");
+			SP<ShapedText const> result = this->shapeText(text, font, maxWidth);
+			target->sl.lock();
+			if(generation > target->backGeneration)
+			{
+				target->back = result;
+				target->backGeneration = generation;
+			}
+			target->sl.unlock();
+			this->completedSL.lock();
+			this->completed.push_back(weakLayout);
+			this->completedSL.unlock();
+			FramePacer::instance().invalidate(); //finalize() only runs when a frame is drawn
+		});
+	}
+
+	/// Must be called on the GL thread before drawing text.  Layouts are swapped in as soon as the glyphs they reference are on the GPU,
+	/// even while glyphs inserted after them are still waiting for upload budget
+	inline void finalize(size_t uploadBudget = 4 * 1024 * 1024)
+	{
+		WUI_PROFILE_SCOPE("TextPipeline::finalize");
+		this->atlas.upload(uploadBudget);
+		uint64_t uploaded = this->atlas.uploadedGeneration();
+		this->completedSL.lock();
+		std::vector<WP<TextLayout>> ready;
+		ready.swap(this->completed);
+		this->completedSL.unlock();
+		std::vector<WP<TextLayout>> waiting;
+		for(WP<TextLayout> const &weakLayout : ready)
+		{
+			SP<TextLayout> layout = weakLayout.lock();
+			if(!layout) continue;
+			layout->sl.lock();
+			if(layout->backGeneration > layout->swappedGeneration)
+			{
+				if(layout->back->atlasGeneration > uploaded) waiting.push_back(weakLayout);
+				else
+				{
+					layout->front = std::move(layout->back);
+					layout->swappedGeneration = layout->backGeneration;
+				}
+			}
+			layout->sl.unlock();
+		}
+		if(waiting.empty()) return;
+		this->completedSL.lock();
+		this->completed.insert(this->completed.begin(), waiting.begin(), waiting.end());
+		this->completedSL.unlock();
+		FramePacer::instance().invalidate(); //keep drawing frames until their glyphs are up
+	}
+
+	GlyphAtlas atlas;
+
+private:
+	inline static uint32_t fontKey(PangoFont *font)
+	{
+		PangoFontDescription *description = pango_font_describe(font);
+		uint32_t out = pango_font_description_hash(description);
+		pango_font_description_free(description);
+		return out;
+	}
+
+	inline bool rasterize(PangoFont *font, PangoGlyph glyph, uint64_t key, GlyphSlot &out)
+	{
+		PangoRectangle ink;
+		pango_font_get_glyph_extents(font, glyph, &ink, nullptr);
+		pango_extents_to_pixels(&ink, nullptr);
+		if(ink.width <= 0 || ink.height <= 0) return this->atlas.insert(key, {}, 0, 0, nullptr, 0, out);
+		cairo_surface_t *surface = cairo_image_surface_create(CAIRO_FORMAT_A8, ink.width, ink.height);
+		cairo_t *cr = cairo_create(surface);
+		PangoGlyphString *glyphs = pango_glyph_string_new();
+		pango_glyph_string_set_size(glyphs, 1);
+		glyphs->glyphs[0].glyph = glyph;
+		glyphs->glyphs[0].geometry.width = 0;
+		glyphs->glyphs[0].geometry.x_offset = 0;
+		glyphs->glyphs[0].geometry.y_offset = 0;
+		glyphs->glyphs[0].attr.is_cluster_start = 1;
+		glyphs->log_clusters[0] = 0;
+		cairo_move_to(cr, -ink.x, -ink.y);
+		pango_cairo_show_glyph_string(cr, font, glyphs);
+		cairo_surface_flush(surface);
+		bool inserted = this->atlas.insert(key, {ink.x, ink.y}, static_cast<uint32_t>(ink.width), static_cast<uint32_t>(ink.height),
+		                                   cairo_image_surface_get_data(surface), cairo_image_surface_get_stride(surface), out);
+		pango_glyph_string_free(glyphs);
+		cairo_destroy(cr);
+		cairo_surface_destroy(surface);
+		return inserted;
+	}
+
+	/// Pango objects aren't thread safe, so each worker shapes through its own FontCache
+	inline SP<ShapedText const> shapeText(std::string const &text, FontKey const &font, int32_t maxWidth)
+	{
+		SP<ShapedText> out = MS<ShapedText>();
+		FontCache &fontCache = FontCache::local();
+		fontCache.fontset(font); //Keeps the fontset and its fallbacks resident for the layout to resolve against
+		PangoLayout *layout = pango_layout_new(fontCache.context(font.language));
+		PangoFontDescription *description = pango_font_description_from_string(font.description.data());
+		pango_layout_set_font_description(layout, description);
+		if(maxWidth > 0)
+		{
+			pango_layout_set_width(layout, maxWidth * PANGO_SCALE);
+			pango_layout_set_wrap(layout, PANGO_WRAP_WORD_CHAR);
+		}
+		pango_layout_set_text(layout, text.data(), static_cast<int>(text.size()));
+		PangoRectangle logical;
+		pango_layout_get_pixel_extents(layout, nullptr, &logical);
+		out->extents = {logical.width, logical.height};
+		PangoLayoutIter *iter = pango_layout_get_iter(layout);
+		do
+		{
+			PangoLayoutRun *run = pango_layout_iter_get_run_readonly(iter);
+			if(!run) continue;
+			PangoRectangle runRect;
+			pango_layout_iter_get_run_extents(iter, nullptr, &runRect);
+			int32_t baseline = pango_layout_iter_get_baseline(iter);
+			uint64_t fontHash = static_cast<uint64_t>(fontKey(run->item->analysis.font)) << 32;
+			int32_t penX = runRect.x;
+			for(int32_t i = 0; i < run->glyphs->num_glyphs; i++)
+			{
+				PangoGlyphInfo const &info = run->glyphs->glyphs[i];
+				GlyphSlot slot;
+				uint64_t key = fontHash | info.glyph;
+				if(info.glyph != PANGO_GLYPH_EMPTY && !(info.glyph & PANGO_GLYPH_UNKNOWN_FLAG) &&
+				   (this->atlas.find(key, slot) || this->rasterize(run->item->analysis.font, info.glyph, key, slot)) && slot.size.x() > 0)
+				{
+					IR::vec2<float> pen = {static_cast<float>(penX + info.geometry.x_offset) / PANGO_SCALE, static_cast<float>(baseline + info.geometry.y_offset) / PANGO_SCALE};
+					out->quads.push_back({pen + IR::vec2<float>{slot.offset}, IR::vec2<float>{slot.size}, slot.uvRect, slot.page});
+					out->atlasGeneration = std::max(out->atlasGeneration, slot.generation);
+				}
+				penX += info.geometry.width;
+			}
+		} while(pango_layout_iter_next_run(iter));
+		pango_layout_iter_free(iter);
+		pango_font_description_free(description);
+		g_object_unref(layout);
+		return out;
+	}
+
+	std::vector<WP<TextLayout>> completed;
+	Spinlock completedSL;
+	WorkerPool pool; //Declared last so workers are joined before anything they touch is destroyed
+};
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <pango/pango.h>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+/// A half open byte range into a TextBuffer
+struct TextRange
+{
+	inline uint32_t length() const { return this->end - this->begin; }
+	inline bool empty() const { return this->begin == this->end; }
+
+	uint32_t begin = 0, end = 0;
+};
+
+/// A single edit, replaced is the range in the text as it was before the edit.
+/// inserted views the buffer's own storage and is only valid until the next edit
+struct TextEdit
+{
+	TextRange replaced;
+	std::string_view inserted;
+};
+
+/// UTF-8 text with a cursor and selection stored as byte offsets into one string.
+/// Cursor positions are the grapheme cluster boundaries Pango reports through PangoLogAttr, cached so moving the cursor never rescans the text,
+/// and only the clusters around an edit are re-segmented
+struct TextBuffer
+{
+	inline TextBuffer()
+	{
+		this->breaks.push_back(0);
+	}
+
+	inline std::string_view view() const { return this->text; }
+	inline std::string_view selectedText() const { return std::string_view{this->text}.substr(this->selection().begin, this->selection().length()); }
+	inline uint32_t cursor() const { return this->breaks[this->cursorIndex]; }
+	inline size_t graphemeCount() const { return this->breaks.size() - 1; }
+
+	/// The selected range, empty and at the cursor when nothing is selected
+	inline TextRange selection() const
+	{
+		uint32_t anchor = this->breaks[this->anchorIndex], cursor = this->cursor();
+		return {std::min(anchor, cursor), std::max(anchor, cursor)};
+	}
+
+	/// Move the cursor by a number of grapheme clusters, extending the selection from its anchor if asked to
+	inline void moveCursor(int64_t graphemes, bool extendSelection = false)
+	{
+		int64_t target = static_cast<int64_t>(this->cursorIndex) + graphemes;
+		this->cursorIndex = static_cast<size_t>(std::clamp<int64_t>(target, 0, static_cast<int64_t>(this->graphemeCount())));
+		if(!extendSelection) this->anchorIndex = this->cursorIndex;
+	}
+
+	/// Place the cursor at the grapheme boundary at or before a byte offset
+	inline void setCursor(uint32_t byteOffset, bool extendSelection = false)
+	{
+		this->cursorIndex = this->breakAtOrBefore(byteOffset);
+		if(!extendSelection) this->anchorIndex = this->cursorIndex;
+	}
+
+	inline void select(TextRange const &range)
+	{
+		this->anchorIndex = this->breakAtOrBefore(range.begin);
+		this->cursorIndex = this->breakAtOrBefore(range.end);
+	}
+
+	inline void selectAll()
+	{
+		this->anchorIndex = 0;
+		this->cursorIndex = this->graphemeCount();
+	}
+
+	/// Replace a byte range, the cursor ends up after the inserted text
+	inline TextEdit replace(TextRange const &range, std::string_view replacement)
+	{
+		//Re-segment from the boundary before the edit to the one after it, a combining mark can merge with its neighbouring clusters
+		size_t first = this->breakBefore(range.begin), last = this->breakAfter(range.end);
+		uint32_t spanBegin = this->breaks[first], spanEnd = this->breaks[last];
+		int64_t delta = static_cast<int64_t>(replacement.size()) - static_cast<int64_t>(range.length());
+		this->text.replace(range.begin, range.length(), replacement.data(), replacement.size());
+		std::vector<uint32_t> span;
+		this->segment(spanBegin, static_cast<uint32_t>(spanEnd + delta), span);
+		for(size_t i = last + 1; i < this->breaks.size(); i++) this->breaks[i] = static_cast<uint32_t>(this->breaks[i] + delta);
+		this->breaks.erase(this->breaks.begin() + first, this->breaks.begin() + last + 1);
+		this->breaks.insert(this->breaks.begin() + first, span.begin(), span.end());
+		this->setCursor(static_cast<uint32_t>(range.begin + replacement.size()));
+		return {range, std::string_view{this->text}.substr(range.begin, replacement.size())};
+	}
+
+	/// Replace the selection, or insert at the cursor when nothing is selected
+	inline TextEdit insert(std::string_view input)
+	{
+		return this->replace(this->selection(), input);
+	}
+
+	/// Delete the selection, or the grapheme before the cursor
+	inline TextEdit eraseBackward()
+	{
+		if(!this->selection().empty() || this->cursorIndex == 0) return this->replace(this->selection(), {});
+		return this->replace({this->breaks[this->cursorIndex - 1], this->cursor()}, {});
+	}
+
+	/// Delete the selection, or the grapheme after the cursor
+	inline TextEdit eraseForward()
+	{
+		if(!this->selection().empty() || this->cursorIndex == this->graphemeCount()) return this->replace(this->selection(), {});
+		return this->replace({this->cursor(), this->breaks[this->cursorIndex + 1]}, {});
+	}
+
+private:
+	inline size_t breakAtOrBefore(uint32_t byteOffset) const
+	{
+		return static_cast<size_t>(std::upper_bound(this->breaks.begin(), this->breaks.end(), byteOffset) - this->breaks.begin()) - 1;
+	}
+
+	inline size_t breakBefore(uint32_t byteOffset) const
+	{
+		size_t index = static_cast<size_t>(std::lower_bound(this->breaks.begin(), this->breaks.end(), byteOffset) - this->breaks.begin());
+		return index == 0 ? 0 : index - 1;
+	}
+
+	inline size_t breakAfter(uint32_t byteOffset) const
+	{
+		size_t index = static_cast<size_t>(std::upper_bound(this->breaks.begin(), this->breaks.end(), byteOffset) - this->breaks.begin());
+		return std::min(index, this->breaks.size() - 1);
+	}
+
+	/// Append the cursor positions in [from, to] of the current text, both ends must be cluster boundaries
+	inline void segment(uint32_t from, uint32_t to, std::vector<uint32_t> &out) const
+	{
+		char const *segment = this->text.data() + from;
+		size_t chars = 0;
+		for(uint32_t i = from; i < to; i++) if((static_cast<unsigned char>(this->text[i]) & 0xC0) != 0x80) chars++;
+		std::vector<PangoLogAttr> attrs(chars + 1);
+		pango_get_log_attrs(segment, static_cast<int>(to - from), -1, pango_language_get_default(), attrs.data(), static_cast<int>(attrs.size()));
+		uint32_t byte = from;
+		for(size_t i = 0; i <= chars; i++)
+		{
+			if(attrs[i].is_cursor_position || i == 0 || i == chars) out.push_back(byte);
+			if(i < chars) do byte++; while(byte < to && (static_cast<unsigned char>(this->text[byte]) & 0xC0) == 0x80);
+		}
+	}
+
+	std::string text;
+	std::vector<uint32_t> breaks; //Byte offset of every cursor position, always starts with 0 and ends with text.size()
+	size_t cursorIndex = 0, anchorIndex = 0;
+};
@@ -0,0 +1,66 @@
+#include "assetBundle.hh"
+#include "imageDecode.hh"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <filesystem>
+
+//wui_pack packs a directory of assets into a bundle for AssetBundle, named by their paths relative to it with / separators
+static void usage()
+{
+	printf("usage: wui_pack [-c] [-t] [-m] [-l] output directory\n"
+	       "  -c  compress entries that shrink by at least an eighth\n"
+	       "  -t  store PNG and JPEG files decoded, as textures Pixmap can upload straight from the bundle\n"
+	       "  -m  with -t, store every mip level too\n"
+	       "  -l  with -t, the images are linear rather than sRGB\n");
+}
+
+int main(int argc, char **argv)
+{
+	bool compress = false, textures = false, mips = false, srgb = true;
+	std::vector<std::string> paths;
+	for(int i = 1; i < argc; i++)
+	{
+		if(strcmp(argv[i], "-c") == 0) compress = true;
+		else if(strcmp(argv[i], "-t") == 0) textures = true;
+		else if(strcmp(argv[i], "-m") == 0) mips = true;
+		else if(strcmp(argv[i], "-l") == 0) srgb = false;
+		else paths.emplace_back(argv[i]);
+	}
+	if(paths.size() != 2)
+	{
+		usage();
+		return 1;
+	}
+	std::filesystem::path root = paths[1];
+	std::error_code error;
+	std::vector<std::filesystem::path> files;
+	for(std::filesystem::recursive_directory_iterator it(root, error), end; !error && it != end; it.increment(error))
+	{
+		if(it->is_regular_file()) files.push_back(it->path());
+	}
+	if(error)
+	{
+		printf("Error reading directory %s\n", paths[1].data());
+		return 1;
+	}
+	std::sort(files.begin(), files.end()); //The same directory always packs the same bundle
+	AssetBundleWriter writer;
+	size_t rawBytes = 0;
+	for(std::filesystem::path const &path : files)
+	{
+		std::string name = path.lexically_relative(root).generic_string();
+		MappedFile file;
+		if(!file.open(path.string())) return 1;
+		rawBytes += file.size();
+		DecodedImage image;
+		if(textures && decodeImage(file.data(), file.size(), image)) writer.addTexture(name, image.texels.data(), image.width, image.height, image.channels, srgb, mips, compress);
+		else writer.add(name, file.data(), file.size(), compress);
+	}
+	if(!writer.write(paths[0])) return 1;
+	printf("Packed %zu files, %zu bytes, into %s\n", files.size(), rawBytes, paths[0].data());
+	return 0;
+}
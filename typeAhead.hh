@@ -0,0 +1,138 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+
+/// Finds the entries of a long list containing what's been typed so far, ignoring ASCII case.
+/// build() indexes every trigram of every entry once.  A query's candidates are then the entries with its rarest trigram,
+/// and a query that only adds to the last one narrows the last matches rather than searching again.
+/// rank() scores every entry as a fuzzy match instead, it's slower and meant for a worker
+struct TypeAheadIndex
+{
+	inline void build(std::vector<std::string> const &entries)
+	{
+		this->folded.resize(entries.size());
+		std::vector<uint64_t> pairs; //trigram << 32 | entry
+		for(size_t i = 0; i < entries.size(); i++)
+		{
+			fold(entries[i], this->folded[i]);
+			std::string const &entry = this->folded[i];
+			for(size_t at = 0; at + 3 <= entry.size(); at++) pairs.push_back(static_cast<uint64_t>(trigram(&entry[at])) << 32 | i);
+		}
+		std::sort(pairs.begin(), pairs.end());
+		pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+		this->grams.clear();
+		this->gramOffsets.clear();
+		this->postings.resize(pairs.size());
+		for(size_t i = 0; i < pairs.size(); i++)
+		{
+			uint32_t gram = static_cast<uint32_t>(pairs[i] >> 32);
+			if(this->grams.empty() || this->grams.back() != gram)
+			{
+				this->grams.push_back(gram);
+				this->gramOffsets.push_back(static_cast<uint32_t>(i));
+			}
+			this->postings[i] = static_cast<uint32_t>(pairs[i]);
+		}
+		this->gramOffsets.push_back(static_cast<uint32_t>(pairs.size()));
+		this->lastQuery.clear();
+		this->lastMatches.clear();
+	}
+	
+	inline size_t size() const
+	{
+		return this->folded.size();
+	}
+	
+	/// The entries containing query in the order they were given, everything for an empty query
+	inline void filter(std::string const &query, std::vector<uint32_t> &out)
+	{
+		thread_local std::string folded;
+		fold(query, folded);
+		out.clear();
+		if(folded.empty()) for(size_t i = 0; i < this->folded.size(); i++) out.push_back(static_cast<uint32_t>(i));
+		else if(!this->lastQuery.empty() && folded.find(this->lastQuery) != std::string::npos)
+		{
+			//Anything containing the new query contains the last one
+			for(uint32_t entry : this->lastMatches) if(this->folded[entry].find(folded) != std::string::npos) out.push_back(entry);
+		}
+		else if(folded.size() >= 3)
+		{
+			uint32_t first = 0, end = UINT32_MAX;
+			for(size_t at = 0; at + 3 <= folded.size() && first != end; at++)
+			{
+				uint32_t gram = trigram(&folded[at]);
+				auto it = std::lower_bound(this->grams.begin(), this->grams.end(), gram);
+				size_t index = it - this->grams.begin();
+				if(it == this->grams.end() || *it != gram) first = end = 0;
+				else if(this->gramOffsets[index + 1] - this->gramOffsets[index] < end - first)
+				{
+					first = this->gramOffsets[index];
+					end = this->gramOffsets[index + 1];
+				}
+			}
+			for(uint32_t i = first; i < end; i++) if(this->folded[this->postings[i]].find(folded) != std::string::npos) out.push_back(this->postings[i]);
+		}
+		else for(size_t i = 0; i < this->folded.size(); i++) if(this->folded[i].find(folded) != std::string::npos) out.push_back(static_cast<uint32_t>(i));
+		this->lastQuery = folded;
+		this->lastMatches = out;
+	}
+	
+	/// Every entry with query's characters in order, best first.  Runs of consecutive characters and characters starting words score higher,
+	/// ties go to shorter entries and then to the order they were given.  Only reads what build() made, so it may run on a worker while nothing rebuilds
+	inline void rank(std::string const &query, std::vector<uint32_t> &out) const
+	{
+		std::string folded;
+		fold(query, folded);
+		std::vector<std::pair<int64_t, uint32_t>> scored;
+		for(size_t i = 0; i < this->folded.size(); i++)
+		{
+			int32_t score = fuzzyScore(this->folded[i], folded);
+			if(score < 0) continue;
+			//Higher scores first, then shorter entries, then entry order
+			int64_t key = -(static_cast<int64_t>(score) << 32) + static_cast<int64_t>(std::min<size_t>(this->folded[i].size(), UINT32_MAX));
+			scored.push_back({key, static_cast<uint32_t>(i)});
+		}
+		std::sort(scored.begin(), scored.end());
+		out.resize(scored.size());
+		for(size_t i = 0; i < scored.size(); i++) out[i] = scored[i].second;
+	}
+	
+	/// How well query matches entry as a subsequence, both already folded, -1 if it doesn't
+	inline static int32_t fuzzyScore(std::string const &entry, std::string const &query)
+	{
+		int32_t score = 0, run = 0;
+		size_t at = 0;
+		for(char c : query)
+		{
+			size_t found = entry.find(c, at);
+			if(found == std::string::npos) return -1;
+			run = found == at && at > 0 ? run + 1 : 0;
+			bool wordStart = found == 0 || entry[found - 1] == ' ' || entry[found - 1] == '_' || entry[found - 1] == '-' || entry[found - 1] == '/' || entry[found - 1] == '.';
+			score += 1 + run * 4 + (wordStart ? 8 : 0) - static_cast<int32_t>(std::min<size_t>(found - at, 8));
+			at = found + 1;
+		}
+		return std::max(score, 0);
+	}
+
+private:
+	inline static void fold(std::string const &in, std::string &out)
+	{
+		out.resize(in.size());
+		for(size_t i = 0; i < in.size(); i++) out[i] = in[i] >= 'A' && in[i] <= 'Z' ? static_cast<char>(in[i] + ('a' - 'A')) : in[i];
+	}
+	
+	inline static uint32_t trigram(char const *at)
+	{
+		return static_cast<uint32_t>(static_cast<uint8_t>(at[0])) << 16 | static_cast<uint32_t>(static_cast<uint8_t>(at[1])) << 8 | static_cast<uint8_t>(at[2]);
+	}
+	
+	std::vector<std::string> folded; //Entries in lower case
+	std::vector<uint32_t> grams, gramOffsets, postings; //Sorted trigrams, and postings[gramOffsets[i], gramOffsets[i + 1]) are the entries with grams[i]
+	std::string lastQuery;
+	std::vector<uint32_t> lastMatches;
+};
@@ -1,11 +1,20 @@
 #pragma once
 
+#include "definitions.hh"
+#include "framePacing.hh"
+
 #include <string>
 #include <atomic>
 #include <fstream>
 #include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+#include <algorithm>
 
-std::string readTextFile(std::string const &filePath)
+inline std::string readTextFile(std::string const &filePath)
 {
 	std::ifstream fileIn;
 	fileIn.open(filePath);
@@ -101,6 +110,142 @@ private:
 	std::atomic_flag writeSem {false};
 };
 
+/// A fixed set of worker threads consuming a shared job queue
+struct WorkerPool final
+{
+	
+	/// onStart runs on each worker as it starts, before it takes any job, for per-thread setup like caches
+	inline explicit WorkerPool(size_t threadCount = std::max(2u, std::thread::hardware_concurrency()) - 1, std::function<void()> onStart = nullptr)
+	{
+		for(size_t i = 0; i < threadCount; i++) this->workers.emplace_back([this, onStart]
+		{
+			if(onStart) onStart();
+			this->workerLoop();
+		});
+	}
+	
+	inline ~WorkerPool()
+	{
+		{
+			std::lock_guard<std::mutex> guard(this->queueMutex);
+			this->exiting = true;
+		}
+		this->queueCV.notify_all();
+		for(std::thread &worker : this->workers) worker.join();
+	}
+	
+	inline void enqueue(std::function<void()> job)
+	{
+		{
+			std::lock_guard<std::mutex> guard(this->queueMutex);
+			this->jobs.emplace_back(std::move(job));
+		}
+		this->queueCV.notify_one();
+	}
+	
+	inline size_t threadCount() const
+	{
+		return this->workers.size();
+	}
+
+private:
+	inline void workerLoop()
+	{
+		while(true)
+		{
+			std::function<void()> job;
+			{
+				std::unique_lock<std::mutex> guard(this->queueMutex);
+				this->queueCV.wait(guard, [this]{return this->exiting || !this->jobs.empty();});
+				if(this->jobs.empty()) return;
+				job = std::move(this->jobs.front());
+				this->jobs.pop_front();
+			}
+			job();
+		}
+	}
+	
+	std::vector<std::thread> workers;
+	std::deque<std::function<void()>> jobs;
+	std::mutex queueMutex;
+	std::condition_variable queueCV;
+	bool exiting = false;
+};
+
+/// One worker shared by everything that runs in the background through BackgroundTask.  FramePacer is created first so it outlives the worker at exit
+inline WorkerPool &backgroundPool()
+{
+	FramePacer::instance();
+	static WorkerPool out(1);
+	return out;
+}
+
+/// The newest result of jobs run on backgroundPool(), for work the thread that renders mustn't wait on.
+/// Starting a job supersedes the ones before it and drops their results, the thread that renders picks the newest up with take()
+template <typename T> struct BackgroundTask
+{
+	/// job(out) fills in the result on the worker.  Anything it reads must stay alive and unchanged until busy() is false, so capture owners by SP
+	template <typename F> inline void start(F job)
+	{
+		uint64_t generation = ++this->state->requested;
+		SP<State> state = this->state;
+		backgroundPool().enqueue([state, generation, job = std::move(job)]
+		{
+			if(state->requested.load() != generation) return; //superseded before we started
+			T result {};
+			job(result);
+			state->sl.lock();
+			if(generation > state->finished)
+			{
+				std::swap(state->result, result);
+				state->finished = generation;
+			}
+			state->sl.unlock();
+			FramePacer::instance().invalidate();
+		});
+	}
+	
+	/// Drop the job running, if any
+	inline void cancel()
+	{
+		this->taken = ++this->state->requested;
+	}
+	
+	/// Swaps the newest job's result into out once it's finished, true when it did
+	inline bool take(T &out)
+	{
+		if(!this->busy()) return false;
+		this->state->sl.lock();
+		bool done = this->state->finished == this->state->requested.load();
+		if(done)
+		{
+			std::swap(out, this->state->result);
+			this->taken = this->state->finished;
+		}
+		this->state->sl.unlock();
+		return done;
+	}
+	
+	/// True from start() until its result is taken
+	inline bool busy() const
+	{
+		return this->state->requested.load() > this->taken;
+	}
+
+private:
+	/// Shared with the jobs, so an owner destroyed mid job doesn't leave the worker writing into it
+	struct State
+	{
+		std::atomic<uint64_t> requested {0};
+		uint64_t finished = 0;
+		T result {};
+		Spinlock sl;
+	};
+	
+	SP<State> state = MS<State>();
+	uint64_t taken = 0;
+};
+
 inline std::vector<std::string> splitStr(std::string const &input, char const &splitOn, bool const &removeMatches)
 {
 	std::vector<std::string> out;
@@ -4,6 +4,10 @@
 #define _USEGL45
 #elif defined(WUI_GL44) || defined(WUI_GL43) || defined(WUI_GL42) || defined(WUI_GL41) || defined(WUI_GL40) || defined(WUI_GL33)
 #define _USEGL33
+#elif defined(WUI_SOFTWARE)
+#define _USESOFTWARE
+#elif defined(WUI_RECORDING)
+#define _USERECORDING
 #else
 #define _INVALIDGLVERSION
 #endif
@@ -0,0 +1,448 @@
+#pragma once
+
+#include "definitions.hh"
+
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <unordered_map>
+#include <algorithm>
+
+/// Where each item of a virtualized list starts, as a prefix sum of item heights so the item under any offset is a binary search away.
+/// Lists where every item is the same height keep no table at all
+struct HeightIndex
+{
+	/// Every item is height tall
+	inline void uniform(size_t count, int32_t height)
+	{
+		this->count = count;
+		this->rowHeight = std::max(height, 1);
+		this->offsets.clear();
+	}
+	
+	/// Item i is height(i) tall, O(count)
+	template <typename F> inline void assign(size_t count, F const &height)
+	{
+		this->count = count;
+		this->rowHeight = 0;
+		this->offsets.resize(count + 1);
+		this->offsets[0] = 0;
+		for(size_t i = 0; i < count; i++) this->offsets[i + 1] = this->offsets[i] + std::max(height(i), 0);
+	}
+	
+	inline size_t size() const
+	{
+		return this->count;
+	}
+	
+	/// Distance from the top of the list to the top of item
+	inline int64_t offset(size_t item) const
+	{
+		return this->rowHeight ? static_cast<int64_t>(item) * this->rowHeight : this->offsets[item];
+	}
+	
+	inline int32_t height(size_t item) const
+	{
+		return static_cast<int32_t>(this->offset(item + 1) - this->offset(item));
+	}
+	
+	inline int64_t total() const
+	{
+		return this->offset(this->count);
+	}
+	
+	/// The item covering offset y, size() past the end
+	inline size_t find(int64_t y) const
+	{
+		if(y < 0) return 0;
+		if(this->rowHeight) return std::min(static_cast<size_t>(y / this->rowHeight), this->count);
+		return static_cast<size_t>(std::upper_bound(this->offsets.begin(), this->offsets.end(), y) - this->offsets.begin()) - 1;
+	}
+
+private:
+	size_t count = 0;
+	int32_t rowHeight = 1;
+	std::vector<int64_t> offsets; //count + 1 entries unless rowHeight is set
+};
+
+/// The row widgets a virtualized view shows, one per item in a contiguous range.
+/// Rows of items that leave the range are unbound and parked in a pool, and rebound to the items that enter it, so scrolling creates no widgets once the pool has warmed up
+template <typename ROW> struct RowRecycler
+{
+	/// Show items [first, end).  Rows of items still in range are kept as they are, bind(row, item) is only called for items that weren't shown,
+	/// unbind(row, item) for items that aren't anymore, and create() only when the pool is empty
+	template <typename Create, typename Bind, typename Unbind> inline void show(size_t first, size_t end, Create const &create, Bind const &bind, Unbind const &unbind)
+	{
+		end = std::max(first, end);
+		size_t oldEnd = this->activeFirst + this->active.size();
+		for(size_t i = 0; i < this->active.size(); i++)
+		{
+			size_t item = this->activeFirst + i;
+			if(item >= first && item < end) continue;
+			unbind(*this->active[i], item);
+			this->pool.push_back(std::move(this->active[i]));
+		}
+		this->scratch.resize(end - first);
+		for(size_t item = first; item < end; item++)
+		{
+			SP<ROW> &row = this->scratch[item - first];
+			if(item >= this->activeFirst && item < oldEnd)
+			{
+				row = std::move(this->active[item - this->activeFirst]);
+				continue;
+			}
+			if(this->pool.empty()) row = create();
+			else
+			{
+				row = std::move(this->pool.back());
+				this->pool.pop_back();
+			}
+			bind(*row, item);
+		}
+		this->active.swap(this->scratch);
+		this->scratch.clear();
+		this->activeFirst = first;
+	}
+	
+	/// Unbind every row and pool them, eg when the items they show changed
+	template <typename Unbind> inline void clear(Unbind const &unbind)
+	{
+		for(size_t i = 0; i < this->active.size(); i++)
+		{
+			unbind(*this->active[i], this->activeFirst + i);
+			this->pool.push_back(std::move(this->active[i]));
+		}
+		this->active.clear();
+		this->activeFirst = 0;
+	}
+	
+	/// Calls f(row, item) for every row shown
+	template <typename F> inline void forEach(F const &f) const
+	{
+		for(size_t i = 0; i < this->active.size(); i++) f(*this->active[i], this->activeFirst + i);
+	}
+	
+	/// Calls f(row) for every row created so far, shown or pooled
+	template <typename F> inline void forEachCreated(F const &f) const
+	{
+		for(SP<ROW> const &row : this->active) f(*row);
+		for(SP<ROW> const &row : this->pool) f(*row);
+	}
+	
+	/// The row showing item, nullptr if it isn't shown
+	inline ROW *row(size_t item) const
+	{
+		if(item < this->activeFirst || item >= this->activeFirst + this->active.size()) return nullptr;
+		return this->active[item - this->activeFirst].get();
+	}
+	
+	inline size_t first() const
+	{
+		return this->activeFirst;
+	}
+	
+	inline size_t end() const
+	{
+		return this->activeFirst + this->active.size();
+	}
+	
+	/// Rows created so far, shown or pooled
+	inline size_t rowCount() const
+	{
+		return this->active.size() + this->pool.size();
+	}
+
+private:
+	std::vector<SP<ROW>> active, pool, scratch;
+	size_t activeFirst = 0;
+};
+
+/// One column of a TableSource, a typed view of values the source stores contiguously rather than one object per row
+struct TableColumn
+{
+	enum struct Type : uint8_t
+	{
+		INT, FLOAT, TEXT
+	};
+	
+	inline static TableColumn of(int64_t const *values, size_t count)
+	{
+		return {Type::INT, values, count};
+	}
+	
+	inline static TableColumn of(double const *values, size_t count)
+	{
+		return {Type::FLOAT, values, count};
+	}
+	
+	inline static TableColumn of(std::string const *values, size_t count)
+	{
+		return {Type::TEXT, values, count};
+	}
+	
+	inline int64_t const *ints() const
+	{
+		return static_cast<int64_t const *>(this->values);
+	}
+	
+	inline double const *floats() const
+	{
+		return static_cast<double const *>(this->values);
+	}
+	
+	inline std::string const *texts() const
+	{
+		return static_cast<std::string const *>(this->values);
+	}
+	
+	Type type = Type::INT;
+	void const *values = nullptr;
+	size_t count = 0;
+};
+
+/// A cell's value as text, integers as is, floats with %g
+inline void formatCell(TableColumn const &column, size_t row, std::string &out)
+{
+	char buffer[32];
+	switch(column.type)
+	{
+		case TableColumn::Type::INT: out.assign(buffer, std::min<size_t>(snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(column.ints()[row])), sizeof(buffer) - 1)); break;
+		case TableColumn::Type::FLOAT: out.assign(buffer, std::min<size_t>(snprintf(buffer, sizeof(buffer), "%g", column.floats()[row]), sizeof(buffer) - 1)); break;
+		case TableColumn::Type::TEXT: out = column.texts()[row]; break;
+	}
+}
+
+/// The rows of column in order of their values, equal values keep their relative order.
+/// Numbers are radix sorted as (key, row) pairs with keys that order like the values as unsigned integers, a byte per pass, skipping bytes every key shares
+inline void sortRows(TableColumn const &column, bool ascending, std::vector<uint32_t> &order)
+{
+	order.resize(column.count);
+	if(column.type == TableColumn::Type::TEXT)
+	{
+		for(size_t i = 0; i < order.size(); i++) order[i] = static_cast<uint32_t>(i);
+		std::string const *texts = column.texts();
+		if(ascending) std::stable_sort(order.begin(), order.end(), [texts](uint32_t a, uint32_t b){return texts[a] < texts[b];});
+		else std::stable_sort(order.begin(), order.end(), [texts](uint32_t a, uint32_t b){return texts[b] < texts[a];});
+		return;
+	}
+	uint64_t constexpr sign = uint64_t(1) << 63;
+	std::vector<std::pair<uint64_t, uint32_t>> keys(column.count), scratch(column.count);
+	std::vector<size_t> counts(8 * 256, 0); //One histogram per byte, all filled in the same pass
+	for(size_t i = 0; i < keys.size(); i++)
+	{
+		uint64_t key;
+		if(column.type == TableColumn::Type::INT) key = static_cast<uint64_t>(column.ints()[i]) ^ sign;
+		else
+		{
+			std::memcpy(&key, &column.floats()[i], sizeof(key));
+			key = key & sign ? ~key : key | sign; //Negatives count down, positives up, NaNs last
+		}
+		if(!ascending) key = ~key;
+		keys[i] = {key, static_cast<uint32_t>(i)};
+		for(size_t byte = 0; byte < 8; byte++) counts[byte * 256 + ((key >> (byte * 8)) & 0xFF)]++;
+	}
+	for(size_t byte = 0; byte < 8; byte++)
+	{
+		size_t *count = &counts[byte * 256];
+		if(!keys.empty() && count[(keys[0].first >> (byte * 8)) & 0xFF] == keys.size()) continue;
+		for(size_t digit = 0, sum = 0; digit < 256; digit++)
+		{
+			size_t next = sum + count[digit];
+			count[digit] = sum;
+			sum = next;
+		}
+		for(std::pair<uint64_t, uint32_t> const &key : keys) scratch[count[(key.first >> (byte * 8)) & 0xFF]++] = key;
+		keys.swap(scratch);
+	}
+	for(size_t i = 0; i < keys.size(); i++) order[i] = keys[i].second;
+}
+
+/// The rows of a tree whose children are only loaded when their parent is first expanded.
+/// Rows in view order are kept flattened and spliced on expand and collapse, so the node on any row is an index away.
+/// Each node's visible row count is also kept in a Fenwick tree, children of a node are loaded next to each other so the rows before a node
+/// are a prefix sum per level, and finding the row of any node is O(depth * log n)
+struct TreeIndex
+{
+	static uint32_t constexpr none = UINT32_MAX;
+	
+	/// Forget every node and start over with the top level nodes
+	inline void reset(std::vector<uint64_t> const &topLevel)
+	{
+		this->nodes.clear();
+		this->fenwick.assign(1, 0);
+		this->ids.clear();
+		this->visible.clear();
+		this->append(topLevel, none);
+		for(uint32_t node = 0; node < this->nodes.size(); node++) this->visible.push_back(node);
+	}
+	
+	/// Show the children of node, load(id, out) fills in their ids the first time.  False if it was already expanded
+	template <typename Load> inline bool expand(uint32_t node, Load const &load)
+	{
+		if(this->nodes[node].expanded) return false;
+		if(!this->nodes[node].loaded)
+		{
+			thread_local std::vector<uint64_t> children;
+			children.clear();
+			load(this->nodes[node].id, children);
+			this->nodes[node].firstChild = static_cast<uint32_t>(this->nodes.size());
+			this->nodes[node].childCount = static_cast<uint32_t>(children.size());
+			this->nodes[node].loaded = true;
+			this->append(children, node);
+		}
+		Node const &expanding = this->nodes[node];
+		int64_t added = this->prefix(expanding.firstChild + expanding.childCount) - this->prefix(expanding.firstChild);
+		if(this->isVisible(node))
+		{
+			thread_local std::vector<uint32_t> rows;
+			rows.clear();
+			for(uint32_t child = expanding.firstChild; child < expanding.firstChild + expanding.childCount; child++) this->collectRows(child, rows);
+			size_t row = this->rowOf(node) + 1;
+			this->visible.insert(this->visible.begin() + row, rows.begin(), rows.end());
+		}
+		this->nodes[node].expanded = true;
+		this->addRows(node, added);
+		return true;
+	}
+	
+	/// Hide the children of node, they stay loaded and keep whether they're expanded.  False if it wasn't expanded
+	inline bool collapse(uint32_t node)
+	{
+		if(!this->nodes[node].expanded) return false;
+		int64_t removed = this->nodes[node].rows - 1;
+		if(this->isVisible(node))
+		{
+			size_t row = this->rowOf(node) + 1;
+			this->visible.erase(this->visible.begin() + row, this->visible.begin() + row + removed);
+		}
+		this->addRows(node, -removed);
+		this->nodes[node].expanded = false;
+		return true;
+	}
+	
+	inline size_t rowCount() const
+	{
+		return this->visible.size();
+	}
+	
+	inline uint32_t nodeAt(size_t row) const
+	{
+		return this->visible[row];
+	}
+	
+	/// The row node is shown on, rowCount() if a collapsed ancestor hides it
+	inline size_t rowOf(uint32_t node) const
+	{
+		if(!this->isVisible(node)) return this->rowCount();
+		int64_t out = 0;
+		for(uint32_t child = node; child != none;)
+		{
+			uint32_t parent = this->nodes[child].parent;
+			uint32_t first = parent == none ? 0 : this->nodes[parent].firstChild;
+			out += this->prefix(child) - this->prefix(first) + (parent == none ? 0 : 1);
+			child = parent;
+		}
+		return static_cast<size_t>(out);
+	}
+	
+	/// The node with id, none if it isn't loaded
+	inline uint32_t find(uint64_t id) const
+	{
+		auto it = this->ids.find(id);
+		return it == this->ids.end() ? none : it->second;
+	}
+	
+	inline bool isVisible(uint32_t node) const
+	{
+		for(uint32_t parent = this->nodes[node].parent; parent != none; parent = this->nodes[parent].parent) if(!this->nodes[parent].expanded) return false;
+		return true;
+	}
+	
+	inline uint64_t id(uint32_t node) const
+	{
+		return this->nodes[node].id;
+	}
+	
+	inline uint32_t parent(uint32_t node) const
+	{
+		return this->nodes[node].parent;
+	}
+	
+	inline uint32_t depth(uint32_t node) const
+	{
+		return this->nodes[node].depth;
+	}
+	
+	inline bool expanded(uint32_t node) const
+	{
+		return this->nodes[node].expanded;
+	}
+	
+	/// Nodes loaded so far
+	inline size_t size() const
+	{
+		return this->nodes.size();
+	}
+
+private:
+	struct Node
+	{
+		uint64_t id;
+		uint32_t parent, depth;
+		uint32_t firstChild = 0, childCount = 0;
+		int64_t rows = 1; //Rows this node and its visible descendants take up
+		bool expanded = false, loaded = false;
+	};
+	
+	inline void append(std::vector<uint64_t> const &children, uint32_t parent)
+	{
+		uint32_t depth = parent == none ? 0 : this->nodes[parent].depth + 1;
+		for(uint64_t id : children)
+		{
+			this->ids[id] = static_cast<uint32_t>(this->nodes.size());
+			this->nodes.push_back({id, parent, depth});
+			//The new entry i covers (i - lowbit(i), i], everything in it but itself is already in the tree
+			size_t i = this->fenwick.size();
+			this->fenwick.push_back(1 + this->prefix(static_cast<uint32_t>(i - 1)) - this->prefix(static_cast<uint32_t>(i - (i & (~i + 1)))));
+		}
+	}
+	
+	/// node's row count changed by delta, so did every ancestor's up to the first collapsed one
+	inline void addRows(uint32_t node, int64_t delta)
+	{
+		if(!delta) return;
+		for(uint32_t at = node; at != none; at = this->nodes[at].parent)
+		{
+			this->nodes[at].rows += delta;
+			for(size_t i = at + 1; i < this->fenwick.size(); i += i & (~i + 1)) this->fenwick[i] += delta;
+			uint32_t parent = this->nodes[at].parent;
+			if(parent != none && !this->nodes[parent].expanded) return;
+		}
+	}
+	
+	/// Sum of the row counts of nodes [0, end)
+	inline int64_t prefix(uint32_t end) const
+	{
+		int64_t out = 0;
+		for(size_t i = end; i > 0; i -= i & (~i + 1)) out += this->fenwick[i];
+		return out;
+	}
+	
+	/// node and its visible descendants in view order
+	inline void collectRows(uint32_t node, std::vector<uint32_t> &out) const
+	{
+		out.push_back(node);
+		Node const &at = this->nodes[node];
+		if(!at.expanded) return;
+		for(uint32_t child = at.firstChild; child < at.firstChild + at.childCount; child++) this->collectRows(child, out);
+	}
+	
+	std::vector<Node> nodes;
+	std::vector<int64_t> fenwick {0}; //1 based
+	std::vector<uint32_t> visible; //The node on each row
+	std::unordered_map<uint64_t, uint32_t> ids;
+};
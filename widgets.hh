@@ -4,6 +4,15 @@
 #include "definitions.hh"
 #include "pixmap.hh"
 #include "sharedAssets.hh"
+#include "textBuffer.hh"
+#include "profiler.hh"
+#include "layout.hh"
+#include "framePacing.hh"
+#include "animation.hh"
+#include "culling.hh"
+#include "virtualList.hh"
+#include "typeAhead.hh"
+#include "shortcuts.hh"
 
 #include <functional>
 #include <cstdint>
@@ -22,15 +31,6 @@ enum MouseButtons
 	X2 = 5,
 };
 
-struct Layout
-{
-protected:
-	Layout() = default;
-
-public:
-	virtual ~Layout() = default;
-};
-
 template <typename Key> struct Widget
 {
 	using Key_t = Key;
@@ -46,7 +46,10 @@ template <typename Key> struct Widget
 		else this->parent = parent;
 	}
 	
-	virtual ~Widget() = default;
+	virtual ~Widget()
+	{
+		if(this->animated) Animator::instance().cancel(this);
+	}
 	
 	virtual void render() = 0;
 	virtual void onResize(uint32_t newWidth, uint32_t newHeight) = 0;
@@ -61,11 +64,41 @@ template <typename Key> struct Widget
 	inline void addLayout(SP<Layout> const &layout)
 	{
 		this->layout = layout;
+		this->invalidate();
 	}
 	
 	inline void addWidget(SP<Widget> const &widget)
 	{
 		this->childWidgets.push_back(widget);
+		this->invalidate();
+	}
+	
+	/// Tween pos, size, color or opacity from where it is now, Animator::instance().update() drives every tween once per frame
+	inline void animatePos(IR::vec2<int32_t> const &to, float seconds, Easing easing = Easing::SMOOTHSTEP, float delay = 0)
+	{
+		this->animate(AnimTrack::POSITION, &this->pos[0], {static_cast<float>(to.x()), static_cast<float>(to.y()), 0, 0}, seconds, easing, delay);
+	}
+	
+	inline void animateSize(IR::vec2<int32_t> const &to, float seconds, Easing easing = Easing::SMOOTHSTEP, float delay = 0)
+	{
+		this->animate(AnimTrack::SIZE, &this->size[0], {static_cast<float>(to.x()), static_cast<float>(to.y()), 0, 0}, seconds, easing, delay);
+	}
+	
+	inline void animateColor(IR::vec4<float> const &to, float seconds, Easing easing = Easing::SMOOTHSTEP, float delay = 0)
+	{
+		this->animate(AnimTrack::COLOR, &this->color[0], to, seconds, easing, delay);
+	}
+	
+	inline void animateOpacity(float to, float seconds, Easing easing = Easing::SMOOTHSTEP, float delay = 0)
+	{
+		this->animate(AnimTrack::OPACITY, &this->opacity, {to, 0, 0, 0}, seconds, easing, delay);
+	}
+	
+	/// Mark this widget as changed so the next frame redraws it, safe to call from any thread
+	inline void invalidate()
+	{
+		this->dirty.store(true, std::memory_order_relaxed);
+		FramePacer::instance().invalidate();
 	}
 	
 	inline IR::aabb2D<int32_t> getHitbox()
@@ -73,37 +106,89 @@ template <typename Key> struct Widget
 		return IR::aabb2D<int32_t>(this->pos.x(), this->pos.x() + this->size.x(), this->pos.y() - this->size.y(), this->pos.y());
 	}
 	
-	IR::vec2<int32_t> pos, size;
+	/// Place the children with this widget's layout inside its own rect, then lay out each child the same way
+	inline void applyLayout()
+	{
+		if(this->layout && !this->childWidgets.empty())
+		{
+			//Scratch is reused across the recursion, it's written back before descending
+			thread_local std::vector<LayoutItem> items;
+			items.resize(this->childWidgets.size());
+			for(size_t i = 0; i < items.size(); i++) items[i] = {this->childWidgets[i]->minSize, {}, {}, this->childWidgets[i]->stretch};
+			this->layout->arrange(this->pos, this->size, items.data(), items.size());
+			for(size_t i = 0; i < items.size(); i++)
+			{
+				Widget &child = *this->childWidgets[i];
+				if(child.pos == items[i].pos && child.size == items[i].size) continue;
+				child.pos = items[i].pos;
+				child.size = items[i].size;
+				child.invalidate();
+			}
+		}
+		for(auto &child : this->childWidgets) child->applyLayout();
+	}
+	
+	/// Add this widget's rect drawn in style to batch, tinted by color and opacity like its pixmaps would be.
+	/// Themed backgrounds and borders drawn this way need no pixmap per element and size
+	inline void batchShape(QuadBatch &batch, ShapeStyle style) const
+	{
+		IR::vec4<float> tint {this->color.x(), this->color.y(), this->color.z(), this->color.w() * this->opacity};
+		style.fill = style.fill * tint;
+		style.borderColor = style.borderColor * tint;
+		style.shadowColor.w() *= tint.w();
+		batch.addShape({static_cast<float>(this->pos.x()), static_cast<float>(this->pos.y()), static_cast<float>(this->size.x()), static_cast<float>(this->size.y())}, style,
+		               static_cast<float>(this->layer));
+	}
+	
+	/// Add this widget's rect drawn with slice to batch, tinted by color and opacity.  Resizing only moves the slices, the pixmap is the same at any size
+	inline void batchNineSlice(QuadBatch &batch, NineSlice const &slice) const
+	{
+		batch.addNineSlice(slice, {static_cast<float>(this->pos.x()), static_cast<float>(this->pos.y()), static_cast<float>(this->size.x()), static_cast<float>(this->size.y())},
+		                   {this->color.x(), this->color.y(), this->color.z(), this->color.w() * this->opacity}, static_cast<float>(this->layer));
+	}
+	
+	/// Add the glyphs of text on atlas page page to batch from this widget's top left, tinted by color and opacity
+	inline void batchText(QuadBatch &batch, ShapedText const &text, uint32_t page = 0) const
+	{
+		batch.addText(text, {static_cast<float>(this->pos.x()), static_cast<float>(this->pos.y())},
+		              {this->color.x(), this->color.y(), this->color.z(), this->color.w() * this->opacity}, page, static_cast<float>(this->layer));
+	}
+	
+	/// Add the hitboxes of this widget and its subtree to list, widgets[i] is the widget of rect i.
+	/// The children of a widget with clipChildren set, like a scrolling container, are clipped to its hitbox.  Hidden widgets are left out with their subtrees
+	inline void collectCulling(CullList &list, std::vector<Widget *> &widgets)
+	{
+		if(!this->visible) return;
+		list.push(this->getHitbox());
+		widgets.push_back(this);
+		if(this->childWidgets.empty()) return;
+		if(this->clipChildren) list.pushClip(this->getHitbox());
+		for(auto &child : this->childWidgets) child->collectCulling(list, widgets);
+		if(this->clipChildren) list.popClip();
+	}
+	
+	IR::vec2<int32_t> pos, size, minSize;
+	IR::vec4<float> color {1, 1, 1, 1}; //Multiplies the widget's pixmaps
+	float stretch = 1, opacity = 1;
 	Observer connectionObserver;
 	uint64_t layer = 1;
+	std::atomic<bool> dirty {true}; //Cleared by render()
+	bool clipChildren = false, visible = true;
 
 private:
+	inline void animate(AnimTrack track, void *out, IR::vec4<float> const &to, float seconds, Easing easing, float delay)
+	{
+		this->animated = true;
+		Animator::instance().animate(this, track, out, &this->dirty, to, seconds, easing, delay);
+	}
+	
 	std::vector<SP<Widget>> childWidgets;
 	WP<Widget> parent;
 	SP<Layout> layout;
 	SP<Shader> shader;
 	SP<Mesh> mesh;
 	SP<FBO> fbo;
-};
-
-/*Layouts--------------------------------------------------------------------------------------------------------------------------------*/
-
-/// 
-struct VBoxLayout : public Layout
-{
-	
-};
-
-/// 
-struct HBoxLayout : public Layout
-{
-	
-};
-
-/// 
-struct FlexBoxLayout : public Layout
-{
-	
+	bool animated = false;
 };
 
 /*Components-----------------------------------------------------------------------------------------------------------------------------*/
@@ -123,24 +208,31 @@ template <typename BASE> struct Pane : public BASE
 	
 	inline void render(IR::vec2<uint32_t> const &contextSize) override
 	{
+		WUI_PROFILE_SCOPE("Pane::render");
+		WUI_PROFILE_GPU_SCOPE("Pane::render");
+		constexpr IR::mat4x4<float> view {}; //The UI camera never moves
 		IR::mat4x4<float> MVP = IR::mat4x4<float>::modelViewProjectionMatrix(IR::mat4x4<float>::modelMatrix({this->pos, this->layer}, {}, {this->size, 1}),
-		                                                                     IR::mat4x4<float>::viewMatrix({}, {}),
+		                                                                     view,
 		                                                                     IR::mat4x4<float>::orthoProjectionMatrix(0, contextSize.x(), contextSize.y(), 0, 1, 100));
 		this->shader->bind();
 		this->mesh->bind();
 		this->pixmap->bind();
 		this->shader->sendMat4f("mvp", &MVP[0][0]);
-		glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+		this->shader->sendVec4f("color", {this->color.x(), this->color.y(), this->color.z(), this->color.w() * this->opacity});
+		this->mesh->draw();
+		this->dirty.store(false, std::memory_order_relaxed);
 	}
 	
 	inline void onResize(uint32_t newWidth, uint32_t newHeight) override
 	{
+		WUI_PROFILE_SCOPE("Pane::onResize");
 		
 	}
 	
 	inline void customPixmap(SP<Pixmap> const &pixmap)
 	{
 		this->pixmap = pixmap;
+		this->invalidate();
 	}
 
 private:
@@ -173,12 +265,14 @@ template <typename BASE> struct Button : public BASE
 	inline void onMouseUp(MouseButtons button, IR::vec2<int32_t> const &pos) override
 	{
 		if(button == LEFT) this->pressing = false;
+		this->invalidate();
 		this->stateChanged.fire(this->pressing);
 	}
 	
 	inline void onMouseDown(MouseButtons button, IR::vec2<int32_t> const &pos) override
 	{
 		if(button == LEFT) this->pressing = true;
+		this->invalidate();
 		this->stateChanged.fire(this->pressing);
 	}
 	
@@ -190,12 +284,14 @@ template <typename BASE> struct Button : public BASE
 			if(!this->hovering)
 			{
 				this->hovering = true;
+				this->invalidate();
 				this->onHover.fire();
 			}
 		}
-		else
+		else if(this->hovering)
 		{
 			this->hovering = false;
+			this->invalidate();
 		}
 	}
 	
@@ -265,6 +361,7 @@ template <typename BASE> struct Checkbox : public BASE
 	inline void onMouseUp(MouseButtons button, IR::vec2<int32_t> const &pos) override
 	{
 		this->value = !this->value;
+		this->invalidate();
 		this->stateChanged.fire(this->value);
 	}
 	
@@ -498,7 +595,7 @@ template <typename BASE> struct DropdownMenu : public BASE
 	
 	inline void render() override
 	{
-		
+		if(this->ranker.take(this->matches)) this->filtered.fire();
 	}
 	
 	inline void onResize(uint32_t newWidth, uint32_t newHeight) override
@@ -529,7 +626,39 @@ template <typename BASE> struct DropdownMenu : public BASE
 	
 	inline void onTextInput(std::string const &input) override
 	{
-		
+		this->setFilter(this->query + input);
+	}
+	
+	/// Index entries for type-ahead filtering, done once rather than on every keystroke
+	inline void setEntries(std::vector<std::string> entries)
+	{
+		this->entries = std::move(entries);
+		SP<TypeAheadIndex> index = MS<TypeAheadIndex>();
+		index->build(this->entries);
+		this->index = index; //Rankings still running keep the index they started with
+		this->setFilter(this->query);
+	}
+	
+	/// Show the entries containing query right away, then the fuzzy matches ranked best first once a worker has scored them
+	inline void setFilter(std::string const &query)
+	{
+		this->query = query;
+		this->index->filter(query, this->matches);
+		if(query.empty()) this->ranker.cancel();
+		else this->ranker.start([index = this->index, query](std::vector<uint32_t> &out){index->rank(query, out);});
+		this->filtered.fire();
+		this->invalidate();
+	}
+	
+	inline std::string const &filterText() const
+	{
+		return this->query;
+	}
+	
+	/// Indices into entries to list, in the order to list them
+	inline std::vector<uint32_t> const &filteredEntries() const
+	{
+		return this->matches;
 	}
 	
 	enum struct PixmapElem
@@ -556,13 +685,19 @@ template <typename BASE> struct DropdownMenu : public BASE
 		}
 	}
 	
+	std::vector<std::string> entries;
 	uint32_t selected = 0;
 	Signal<> onOpen = {};
 	Signal<uint32_t> stateChanged = {};
+	Signal<> filtered = {}; //filteredEntries() changed
 
 private:
 	bool extended = false;
 	SP<Pixmap> pixmapFrame, pixmapFrameBorder, pixmapExtendedFrame, pixmapExtendedFrameBorder;
+	SP<TypeAheadIndex> index = MS<TypeAheadIndex>();
+	BackgroundTask<std::vector<uint32_t>> ranker;
+	std::vector<uint32_t> matches;
+	std::string query;
 };
 
 /// A menu bar with dropdown menus, eg File Edit Help etc
@@ -603,13 +738,15 @@ template <typename BASE> struct MenuBar : public BASE
 		
 	}
 	
+	/// Key presses that are part of a shortcut go only to the MenuItem bound to it, anything else fires keyPressed
 	inline void onKeyDown(typename BASE::Key_t key) override
 	{
-		this->keyPressed.fire(true, key);
+		if(!ShortcutRegistry<typename BASE::Key_t>::instance().keyDown(key)) this->keyPressed.fire(true, key);
 	}
 	
 	inline void onKeyUp(typename BASE::Key_t key) override
 	{
+		ShortcutRegistry<typename BASE::Key_t>::instance().keyUp(key);
 		this->keyPressed.fire(false, key);
 	}
 	
@@ -652,6 +789,11 @@ template <typename BASE> struct MenuItem : public BASE
 		//TODO create pixmaps
 	}
 	
+	inline ~MenuItem()
+	{
+		this->setShortcut({});
+	}
+	
 	inline void render() override
 	{
 		
@@ -687,10 +829,28 @@ template <typename BASE> struct MenuItem : public BASE
 		this->keyPressed.fire(false, key);
 	}
 	
+	/// Fire clicked with MouseButtons::NONE when chord is typed, resolved by ShortcutRegistry::instance() which MenuBar feeds key presses to.
+	/// An empty chord removes the shortcut
+	inline void setShortcut(typename ShortcutRegistry<typename BASE::Key_t>::Chord const &chord)
+	{
+		ShortcutRegistry<typename BASE::Key_t> &registry = ShortcutRegistry<typename BASE::Key_t>::instance();
+		registry.unbind(this->shortcut);
+		this->shortcut = chord;
+		registry.bind(this->shortcut, [this]{this->clicked.fire(MouseButtons::NONE, true);});
+	}
+	
+	inline typename ShortcutRegistry<typename BASE::Key_t>::Chord const &getShortcut() const
+	{
+		return this->shortcut;
+	}
+	
 	std::string text = "";
 	Signal<MouseButtons, bool> clicked {};
 	Signal<> hover {};
 	Signal<bool, typename BASE::Key_t> keyPressed = {};
+
+private:
+	typename ShortcutRegistry<typename BASE::Key_t>::Chord shortcut;
 };
 
 /// A text label
@@ -726,7 +886,17 @@ template <typename BASE> struct Label : public BASE
 		this->pixmapBackground = pixmap;
 	}
 	
+	using BASE::batchText;
+	
+	/// Add the label's current layout to batch, nothing until its first result arrives
+	inline void batchText(QuadBatch &batch, uint32_t page = 0) const
+	{
+		SP<ShapedText const> shaped = this->layout->current();
+		if(shaped) this->batchText(batch, *shaped, page);
+	}
+	
 	std::string text = "";
+	SP<TextLayout> layout = MS<TextLayout>(); //Shape text into it with a TextPipeline whenever text changes
 	Signal<> hover {};
 
 private:
@@ -773,7 +943,32 @@ template <typename BASE> struct TextLine : public BASE
 	
 	inline void onTextInput(std::string const &input) override
 	{
-		
+		WUI_PROFILE_SCOPE("onTextInput");
+		this->insert(input);
+	}
+	
+	/// Replace the selection with new text, or insert it at the cursor
+	inline void insert(std::string_view input)
+	{
+		this->edited(this->text.insert(input));
+	}
+	
+	/// Replace a byte range of the text
+	inline void replace(TextRange const &range, std::string_view replacement)
+	{
+		this->edited(this->text.replace(range, replacement));
+	}
+	
+	/// Backspace
+	inline void eraseBackward()
+	{
+		this->edited(this->text.eraseBackward());
+	}
+	
+	/// Delete
+	inline void eraseForward()
+	{
+		this->edited(this->text.eraseForward());
 	}
 	
 	enum struct PixmapElem
@@ -794,13 +989,19 @@ template <typename BASE> struct TextLine : public BASE
 		}
 	}
 	
-	std::string text = "";
-	std::string selectedText = "";
-	Signal<std::string> textChanged {};
+	/// Move the cursor and selection through text directly, edit it through the functions above so textChanged fires
+	TextBuffer text;
+	Signal<TextEdit const &> textChanged {};
 	Signal<> hover {};
 	Signal<uint64_t> drag {};
 
 private:
+	inline void edited(TextEdit const &edit)
+	{
+		this->invalidate();
+		this->textChanged.fire(edit);
+	}
+	
 	SP<Pixmap> pixmapBackground, pixmapBorder;
 };
 
@@ -844,7 +1045,32 @@ template <typename BASE> struct TextArea : public BASE
 	
 	inline void onTextInput(std::string const &input) override
 	{
-		
+		WUI_PROFILE_SCOPE("onTextInput");
+		this->insert(input);
+	}
+	
+	/// Replace the selection with new text, or insert it at the cursor
+	inline void insert(std::string_view input)
+	{
+		this->edited(this->text.insert(input));
+	}
+	
+	/// Replace a byte range of the text
+	inline void replace(TextRange const &range, std::string_view replacement)
+	{
+		this->edited(this->text.replace(range, replacement));
+	}
+	
+	/// Backspace
+	inline void eraseBackward()
+	{
+		this->edited(this->text.eraseBackward());
+	}
+	
+	/// Delete
+	inline void eraseForward()
+	{
+		this->edited(this->text.eraseForward());
 	}
 	
 	enum struct PixmapElem
@@ -865,13 +1091,19 @@ template <typename BASE> struct TextArea : public BASE
 		}
 	}
 	
-	std::string text = "";
-	std::string selectedText = "";
-	Signal<std::string> textChanged {};
+	/// Move the cursor and selection through text directly, edit it through the functions above so textChanged fires
+	TextBuffer text;
+	Signal<TextEdit const &> textChanged {};
 	Signal<> hover {};
 	Signal<uint64_t> drag {};
 
 private:
+	inline void edited(TextEdit const &edit)
+	{
+		this->invalidate();
+		this->textChanged.fire(edit);
+	}
+	
 	SP<Pixmap> pixmapBackground, pixmapBorder;
 };
 
@@ -947,3 +1179,762 @@ template <class BASE> struct FreeWindow : public BASE
 private:
 	SP<Pixmap> pixmapBackground, pixmapBorder, pixmapTopBar;
 };
+
+/*Views----------------------------------------------------------------------------------------------------------------------------------*/
+
+/// The items a ListView or GridView shows.  Views only ask for rows for the items in view, and hand them back to be rebound as they scroll out
+template <typename BASE> struct ListSource
+{
+	virtual ~ListSource() = default;
+	
+	virtual size_t count() const = 0;
+	
+	/// Height of every item in a ListView, or 0 when they vary and itemHeight() is asked for each one
+	virtual int32_t rowHeight() const
+	{
+		return 24;
+	}
+	
+	virtual int32_t itemHeight(size_t item) const
+	{
+		return this->rowHeight();
+	}
+	
+	/// A widget able to show any item, only called when no recycled row is free
+	virtual SP<BASE> createRow(SP<BASE> const &parent) = 0;
+	
+	/// Make row show item, row may have shown another item before
+	virtual void bindRow(BASE &row, size_t item) = 0;
+	
+	/// row stops showing item, eg to release what bindRow() loaded
+	virtual void unbindRow(BASE &row, size_t item) {}
+};
+
+/// A scrolling list that only has widgets for the items in view plus overscan items either side, recycled as they scroll out.
+/// Items may each have their own height, looked up through a HeightIndex
+template <typename BASE> struct ListView : public BASE
+{
+	inline static SP<ListView> create(SP<BASE> parent)
+	{
+		SP<ListView> out = MS<ListView>(parent);
+		out->self = out;
+		return out;
+	}
+	
+	inline ListView(SP<BASE> parent) : BASE(parent)
+	{
+		this->clipChildren = true;
+	}
+	
+	inline void render() override
+	{
+		this->rows.forEach([](BASE &row, size_t){row.render();});
+		this->dirty.store(false, std::memory_order_relaxed);
+	}
+	
+	inline void onResize(uint32_t newWidth, uint32_t newHeight) override
+	{
+		this->refresh();
+	}
+	
+	inline void setSource(SP<ListSource<BASE>> const &source)
+	{
+		this->releaseRows();
+		this->source = source;
+		this->itemsChanged();
+	}
+	
+	/// Call after items were added, removed or changed height, every row is rebound
+	inline void itemsChanged()
+	{
+		this->releaseRows();
+		if(this->source) this->measure();
+		this->scrollTo(this->scroll);
+		this->refresh();
+	}
+	
+	/// Call after what item shows changed without its height changing
+	inline void itemChanged(size_t item)
+	{
+		if(BASE *row = this->rows.row(item))
+		{
+			this->source->bindRow(*row, item);
+			row->invalidate();
+		}
+	}
+	
+	/// Scroll so offset pixels of content are above the top of the view, clamped to the content
+	inline void scrollTo(int64_t offset)
+	{
+		offset = std::max<int64_t>(0, std::min(offset, this->contentHeight() - this->size.y()));
+		if(offset == this->scroll) return;
+		this->scroll = offset;
+		this->refresh();
+		this->scrolled.fire(this->scroll);
+	}
+	
+	inline void scrollBy(int64_t delta)
+	{
+		this->scrollTo(this->scroll + delta);
+	}
+	
+	/// Scroll the least needed to bring item fully into view
+	inline void scrollToItem(size_t item)
+	{
+		if(!this->source || item >= this->source->count()) return;
+		int64_t top = this->itemTop(item), bottom = top + this->itemHeight(item);
+		if(top < this->scroll) this->scrollTo(top);
+		else if(bottom > this->scroll + this->size.y()) this->scrollTo(bottom - this->size.y());
+	}
+	
+	inline int64_t scrollOffset() const
+	{
+		return this->scroll;
+	}
+	
+	/// The item under a point in the same space as pos, count() if there isn't one
+	virtual size_t itemAt(IR::vec2<int32_t> const &point) const
+	{
+		size_t count = this->source ? this->source->count() : 0;
+		if(point.x() < this->pos.x() || point.x() >= this->pos.x() + this->size.x() || point.y() > this->pos.y() || point.y() <= this->pos.y() - this->size.y()) return count;
+		return this->heights.find(this->scroll + this->pos.y() - point.y());
+	}
+	
+	/// Bind rows to the items in view and place them, call after moving or resizing the view
+	inline void refresh()
+	{
+		if(!this->source) return;
+		size_t first = 0, end = 0;
+		if(this->size.y() > 0) this->visibleRange(first, end);
+		end = std::min(end + this->overscanItems(), this->source->count());
+		first = first > this->overscanItems() ? first - this->overscanItems() : 0;
+		this->rows.show(first, end, [this]
+		{
+			SP<BASE> row = this->source->createRow(this->self.lock());
+			this->addWidget(row);
+			return row;
+		}, [this](BASE &row, size_t item)
+		{
+			row.visible = true;
+			this->source->bindRow(row, item);
+		}, [this](BASE &row, size_t item)
+		{
+			this->source->unbindRow(row, item);
+			row.visible = false;
+		});
+		this->rows.forEach([this](BASE &row, size_t item)
+		{
+			IR::vec2<int32_t> pos, size;
+			this->placeItem(item, pos, size);
+			if(row.pos == pos && row.size == size) return;
+			row.pos = pos;
+			row.size = size;
+			row.invalidate();
+		});
+		this->invalidate();
+	}
+	
+	/// Calls f(row, item) for every row bound to an item, overscan included
+	template <typename F> inline void forEachRow(F const &f) const
+	{
+		this->rows.forEach(f);
+	}
+	
+	/// Row widgets created so far, which stays around the number in view however far the list scrolls
+	inline size_t rowCount() const
+	{
+		return this->rows.rowCount();
+	}
+	
+	size_t overscan = 4; //Items bound above and below the ones in view, so short scrolls don't rebind anything
+	Signal<int64_t> scrolled {};
+
+protected:
+	/// Items [first, end) intersect the view at the current scroll offset
+	virtual void visibleRange(size_t &first, size_t &end) const
+	{
+		first = this->heights.find(this->scroll);
+		end = this->heights.find(this->scroll + this->size.y() - 1) + 1;
+	}
+	
+	virtual size_t overscanItems() const
+	{
+		return this->overscan;
+	}
+	
+	virtual void placeItem(size_t item, IR::vec2<int32_t> &pos, IR::vec2<int32_t> &size) const
+	{
+		pos = {this->pos.x(), this->pos.y() - static_cast<int32_t>(this->itemTop(item) - this->scroll)};
+		size = {this->size.x(), this->itemHeight(item)};
+	}
+	
+	virtual int64_t itemTop(size_t item) const
+	{
+		return this->heights.offset(item);
+	}
+	
+	virtual int32_t itemHeight(size_t item) const
+	{
+		return this->heights.height(item);
+	}
+	
+	virtual int64_t contentHeight() const
+	{
+		return this->heights.total();
+	}
+	
+	virtual void measure()
+	{
+		int32_t rowHeight = this->source->rowHeight();
+		if(rowHeight > 0) this->heights.uniform(this->source->count(), rowHeight);
+		else this->heights.assign(this->source->count(), [this](size_t item){return this->source->itemHeight(item);});
+	}
+	
+	inline void releaseRows()
+	{
+		if(!this->source) return;
+		this->rows.clear([this](BASE &row, size_t item)
+		{
+			this->source->unbindRow(row, item);
+			row.visible = false;
+		});
+	}
+	
+	WP<BASE> self;
+	SP<ListSource<BASE>> source;
+	HeightIndex heights;
+	RowRecycler<BASE> rows;
+	int64_t scroll = 0;
+};
+
+/// A scrolling grid of equally sized cells filled left to right, with as many columns as fit the view's width
+template <typename BASE> struct GridView : public ListView<BASE>
+{
+	inline static SP<GridView> create(SP<BASE> parent)
+	{
+		SP<GridView> out = MS<GridView>(parent);
+		out->self = out;
+		return out;
+	}
+	
+	inline GridView(SP<BASE> parent) : ListView<BASE>(parent) {}
+	
+	inline void onResize(uint32_t newWidth, uint32_t newHeight) override
+	{
+		this->itemsChanged(); //The column count may have changed, which moves every item
+	}
+	
+	inline size_t itemAt(IR::vec2<int32_t> const &point) const override
+	{
+		size_t count = this->source ? this->source->count() : 0;
+		if(point.x() < this->pos.x() || point.y() > this->pos.y() || point.y() <= this->pos.y() - this->size.y()) return count;
+		size_t column = static_cast<size_t>((point.x() - this->pos.x()) / std::max(this->cellSize.x(), 1));
+		if(column >= this->columns()) return count;
+		size_t out = static_cast<size_t>((this->scroll + this->pos.y() - point.y()) / this->cellHeight()) * this->columns() + column;
+		return std::min(out, count);
+	}
+	
+	inline size_t columns() const
+	{
+		return static_cast<size_t>(std::max(this->size.x() / std::max(this->cellSize.x(), 1), 1));
+	}
+	
+	IR::vec2<int32_t> cellSize {96, 96};
+
+protected:
+	inline void visibleRange(size_t &first, size_t &end) const override
+	{
+		first = static_cast<size_t>(this->scroll / this->cellHeight()) * this->columns();
+		end = static_cast<size_t>((this->scroll + this->size.y() - 1) / this->cellHeight() + 1) * this->columns();
+	}
+	
+	inline size_t overscanItems() const override
+	{
+		return this->overscan * this->columns();
+	}
+	
+	inline void placeItem(size_t item, IR::vec2<int32_t> &pos, IR::vec2<int32_t> &size) const override
+	{
+		int32_t column = static_cast<int32_t>(item % this->columns());
+		pos = {this->pos.x() + column * this->cellSize.x(), this->pos.y() - static_cast<int32_t>(this->itemTop(item) - this->scroll)};
+		size = this->cellSize;
+	}
+	
+	inline int64_t itemTop(size_t item) const override
+	{
+		return static_cast<int64_t>(item / this->columns()) * this->cellHeight();
+	}
+	
+	inline int32_t itemHeight(size_t item) const override
+	{
+		return this->cellHeight();
+	}
+	
+	inline int64_t contentHeight() const override
+	{
+		size_t count = this->source ? this->source->count() : 0;
+		return static_cast<int64_t>((count + this->columns() - 1) / this->columns()) * this->cellHeight();
+	}
+	
+	inline void measure() override {}
+
+private:
+	inline int32_t cellHeight() const
+	{
+		return std::max(this->cellSize.y(), 1);
+	}
+};
+
+/// The cells a TableView shows, stored a column at a time and handed over as typed spans rather than an object per row
+template <typename BASE> struct TableSource
+{
+	virtual ~TableSource() = default;
+	
+	virtual size_t rowCount() const = 0;
+	
+	virtual size_t columnCount() const = 0;
+	
+	/// The values of column, which must stay as they are while TableView::sorting()
+	virtual TableColumn column(size_t column) const = 0;
+	
+	/// Width a column starts with, until TableView::setColumnWidth()
+	virtual int32_t columnWidth(size_t column) const
+	{
+		return 120;
+	}
+	
+	/// The text a cell shows, only asked for when the cell comes into view
+	virtual void format(size_t row, size_t column, std::string &out) const
+	{
+		formatCell(this->column(column), row, out);
+	}
+	
+	/// A widget able to show any cell, only called when no recycled cell is free
+	virtual SP<BASE> createCell(SP<BASE> const &parent) = 0;
+	
+	/// Make cell show text, the formatted value of row in column
+	virtual void bindCell(BASE &cell, size_t row, size_t column, std::string const &text) = 0;
+	
+	virtual void unbindCell(BASE &cell, size_t row, size_t column) {}
+};
+
+/// A scrolling table that only has widgets for the cells in view plus overscan rows and columns around them, recycled as they scroll out.
+/// Rows are sorted by a column on a worker, the table keeps showing the old order until render() picks the new one up
+template <typename BASE> struct TableView : public BASE
+{
+	inline static SP<TableView> create(SP<BASE> parent)
+	{
+		SP<TableView> out = MS<TableView>(parent);
+		out->self = out;
+		return out;
+	}
+	
+	inline TableView(SP<BASE> parent) : BASE(parent)
+	{
+		this->clipChildren = true;
+	}
+	
+	inline void render() override
+	{
+		this->applySort();
+		this->rows.forEach([](TableRow &row, size_t)
+		{
+			row.cells.forEach([](BASE &cell, size_t){cell.render();});
+		});
+		this->dirty.store(false, std::memory_order_relaxed);
+	}
+	
+	inline void onResize(uint32_t newWidth, uint32_t newHeight) override
+	{
+		this->refresh();
+	}
+	
+	inline void setSource(SP<TableSource<BASE>> const &source)
+	{
+		this->releaseRows();
+		this->source = source;
+		this->widths.clear();
+		this->sortColumn = SIZE_MAX;
+		this->itemsChanged();
+	}
+	
+	/// Call after rows or columns were added, removed or changed, every cell is reformatted and a sort is redone
+	inline void itemsChanged()
+	{
+		this->releaseRows();
+		this->order.clear();
+		this->sorter.cancel();
+		if(!this->source) return;
+		size_t columnCount = this->source->columnCount();
+		for(size_t column = this->widths.size(); column < columnCount; column++) this->widths.push_back(this->source->columnWidth(column));
+		this->widths.resize(columnCount);
+		this->columnOffsets.assign(columnCount, [this](size_t column){return this->widths[column];});
+		if(this->sortColumn < columnCount) this->sortBy(this->sortColumn, this->sortAscending);
+		else this->sortColumn = SIZE_MAX;
+		this->clampScroll();
+		this->refresh();
+	}
+	
+	/// Only the cells in view are moved, and only those right of column invalidated
+	inline void setColumnWidth(size_t column, int32_t width)
+	{
+		width = std::max(width, 1);
+		if(column >= this->widths.size() || this->widths[column] == width) return;
+		this->widths[column] = width;
+		this->columnOffsets.assign(this->widths.size(), [this](size_t column){return this->widths[column];});
+		this->clampScroll();
+		this->refresh();
+	}
+	
+	inline int32_t columnWidth(size_t column) const
+	{
+		return this->widths[column];
+	}
+	
+	/// Start sorting the rows by column on a worker, sorted fires once render() swaps the new order in
+	inline void sortBy(size_t column, bool ascending = true)
+	{
+		if(!this->source || column >= this->source->columnCount()) return;
+		this->sortColumn = column;
+		this->sortAscending = ascending;
+		//source is held so the values outlive the sort
+		this->sorter.start([source = this->source, values = this->source->column(column), ascending](std::vector<uint32_t> &out)
+		{
+			sortRows(values, ascending, out);
+		});
+	}
+	
+	/// True from sortBy() until its order is shown
+	inline bool sorting() const
+	{
+		return this->sorter.busy();
+	}
+	
+	/// Show the order of a finished sort, render() calls this every frame
+	inline void applySort()
+	{
+		if(!this->sorter.take(this->order)) return;
+		this->releaseRows();
+		this->refresh();
+		this->sorted.fire(this->sortColumn, this->sortAscending);
+	}
+	
+	/// The source row shown at row of the view
+	inline size_t sourceRow(size_t row) const
+	{
+		return this->order.empty() ? row : this->order[row];
+	}
+	
+	/// Scroll so x pixels of content are left of the view and y above it, clamped to the content
+	inline void scrollTo(int64_t x, int64_t y)
+	{
+		int64_t oldX = this->scrollX, oldY = this->scrollY;
+		this->scrollX = x;
+		this->scrollY = y;
+		this->clampScroll();
+		if(this->scrollX == oldX && this->scrollY == oldY) return;
+		this->refresh();
+		this->scrolled.fire(this->scrollX, this->scrollY);
+	}
+	
+	inline void scrollBy(int64_t x, int64_t y)
+	{
+		this->scrollTo(this->scrollX + x, this->scrollY + y);
+	}
+	
+	inline IR::vec2<int64_t> scrollOffset() const
+	{
+		return {this->scrollX, this->scrollY};
+	}
+	
+	/// The row of the view and column under a point in the same space as pos, false if there isn't a cell there
+	inline bool cellAt(IR::vec2<int32_t> const &point, size_t &row, size_t &column) const
+	{
+		if(!this->source || point.x() < this->pos.x() || point.x() >= this->pos.x() + this->size.x() || point.y() > this->pos.y() || point.y() <= this->pos.y() - this->size.y()) return false;
+		row = static_cast<size_t>((this->scrollY + this->pos.y() - point.y()) / std::max(this->rowHeight, 1));
+		column = this->columnOffsets.find(this->scrollX + point.x() - this->pos.x());
+		return row < this->source->rowCount() && column < this->widths.size();
+	}
+	
+	/// Bind cells to what's in view and place them, call after moving or resizing the table
+	inline void refresh()
+	{
+		if(!this->source) return;
+		size_t firstRow = 0, endRow = 0, firstColumn = 0, endColumn = 0;
+		if(this->size.x() > 0 && this->size.y() > 0)
+		{
+			int32_t rowHeight = std::max(this->rowHeight, 1);
+			firstRow = static_cast<size_t>(this->scrollY / rowHeight);
+			endRow = static_cast<size_t>((this->scrollY + this->size.y() - 1) / rowHeight + 1);
+			firstColumn = this->columnOffsets.find(this->scrollX);
+			endColumn = this->columnOffsets.find(this->scrollX + this->size.x() - 1) + 1;
+		}
+		endRow = std::min(endRow + this->overscan, this->source->rowCount());
+		firstRow = firstRow > this->overscan ? firstRow - this->overscan : 0;
+		endColumn = std::min(endColumn + this->overscan, this->widths.size());
+		firstColumn = firstColumn > this->overscan ? firstColumn - this->overscan : 0;
+		this->rows.show(firstRow, endRow, []{return MS<TableRow>();}, [this](TableRow &row, size_t item)
+		{
+			row.sourceRow = this->sourceRow(item);
+			row.text.resize(this->widths.size());
+			row.formatted.assign(this->widths.size(), false);
+		}, [this](TableRow &row, size_t)
+		{
+			this->releaseCells(row);
+		});
+		this->rows.forEach([&](TableRow &row, size_t item)
+		{
+			row.cells.show(firstColumn, endColumn, [this]
+			{
+				SP<BASE> cell = this->source->createCell(this->self.lock());
+				this->addWidget(cell);
+				return cell;
+			}, [this, &row](BASE &cell, size_t column)
+			{
+				if(!row.formatted[column])
+				{
+					this->source->format(row.sourceRow, column, row.text[column]);
+					row.formatted[column] = true;
+				}
+				cell.visible = true;
+				this->source->bindCell(cell, row.sourceRow, column, row.text[column]);
+			}, [this, &row](BASE &cell, size_t column)
+			{
+				this->source->unbindCell(cell, row.sourceRow, column);
+				cell.visible = false;
+			});
+			int32_t top = this->pos.y() - static_cast<int32_t>(static_cast<int64_t>(item) * this->rowHeight - this->scrollY);
+			row.cells.forEach([&](BASE &cell, size_t column)
+			{
+				IR::vec2<int32_t> pos {this->pos.x() + static_cast<int32_t>(this->columnOffsets.offset(column) - this->scrollX), top}, size {this->widths[column], this->rowHeight};
+				if(cell.pos == pos && cell.size == size) return;
+				cell.pos = pos;
+				cell.size = size;
+				cell.invalidate();
+			});
+		});
+		this->invalidate();
+	}
+	
+	/// Calls f(cell, row, column) for every cell bound, with the source's row
+	template <typename F> inline void forEachCell(F const &f) const
+	{
+		this->rows.forEach([&f](TableRow &row, size_t)
+		{
+			row.cells.forEach([&](BASE &cell, size_t column){f(cell, row.sourceRow, column);});
+		});
+	}
+	
+	/// Cell widgets created so far, which stays around the number in view however far the table scrolls
+	inline size_t cellCount() const
+	{
+		size_t out = 0;
+		this->rows.forEachCreated([&out](TableRow &row){out += row.cells.rowCount();});
+		return out;
+	}
+	
+	int32_t rowHeight = 24;
+	size_t overscan = 2; //Rows above and below, and columns either side of the ones in view
+	Signal<int64_t, int64_t> scrolled {};
+	Signal<size_t, bool> sorted {}; //Column and whether it's ascending
+
+protected:
+	/// The cells of one row of the view, cells are pooled per row and the text they were bound with is kept while the row shows the same source row
+	struct TableRow
+	{
+		RowRecycler<BASE> cells;
+		std::vector<std::string> text;
+		std::vector<bool> formatted;
+		size_t sourceRow = 0;
+	};
+	
+	inline void clampScroll()
+	{
+		int64_t contentHeight = this->source ? static_cast<int64_t>(this->source->rowCount()) * this->rowHeight : 0;
+		this->scrollX = std::max<int64_t>(0, std::min(this->scrollX, this->columnOffsets.total() - this->size.x()));
+		this->scrollY = std::max<int64_t>(0, std::min(this->scrollY, contentHeight - this->size.y()));
+	}
+	
+	inline void releaseCells(TableRow &row)
+	{
+		row.cells.clear([this, &row](BASE &cell, size_t column)
+		{
+			this->source->unbindCell(cell, row.sourceRow, column);
+			cell.visible = false;
+		});
+	}
+	
+	inline void releaseRows()
+	{
+		if(!this->source) return;
+		this->rows.clear([this](TableRow &row, size_t){this->releaseCells(row);});
+	}
+	
+	WP<BASE> self;
+	SP<TableSource<BASE>> source;
+	HeightIndex columnOffsets;
+	std::vector<int32_t> widths;
+	std::vector<uint32_t> order; //Source row of each row of the view, empty until sorted
+	RowRecycler<TableRow> rows;
+	BackgroundTask<std::vector<uint32_t>> sorter;
+	int64_t scrollX = 0, scrollY = 0;
+	size_t sortColumn = SIZE_MAX;
+	bool sortAscending = true;
+};
+
+/// The nodes a TreeView shows, named by ids of the source's choosing.  Children are only asked for when their parent is first expanded
+template <typename BASE> struct TreeSource
+{
+	inline static uint64_t constexpr root = ~uint64_t(0); //Pass to children() for the top level nodes
+	
+	virtual ~TreeSource() = default;
+	
+	/// Fill out with the ids of node's children
+	virtual void children(uint64_t node, std::vector<uint64_t> &out) = 0;
+	
+	/// Whether node could have children, so a row can draw an expander without loading them
+	virtual bool hasChildren(uint64_t node) const
+	{
+		return true;
+	}
+	
+	virtual int32_t rowHeight() const
+	{
+		return 24;
+	}
+	
+	/// A widget able to show any node, only called when no recycled row is free
+	virtual SP<BASE> createRow(SP<BASE> const &parent) = 0;
+	
+	/// Make row show node, depth levels down from the top
+	virtual void bindRow(BASE &row, uint64_t node, uint32_t depth, bool expanded) = 0;
+	
+	virtual void unbindRow(BASE &row, uint64_t node) {}
+};
+
+/// A scrolling tree that loads children on first expand and shows its visible nodes through a ListView, so rows are recycled the same way.
+/// Expanding or collapsing splices the rows below the node, and finding a node's row to scroll to it is O(depth * log n)
+template <typename BASE> struct TreeView : public ListView<BASE>
+{
+	inline static SP<TreeView> create(SP<BASE> parent)
+	{
+		SP<TreeView> out = MS<TreeView>(parent);
+		out->self = out;
+		return out;
+	}
+	
+	inline TreeView(SP<BASE> parent) : ListView<BASE>(parent) {}
+	
+	inline void setTreeSource(SP<TreeSource<BASE>> const &source)
+	{
+		this->releaseRows();
+		this->tree = source;
+		this->treeChanged();
+	}
+	
+	/// Call after the source's nodes changed, everything is collapsed and reloaded
+	inline void treeChanged()
+	{
+		this->releaseRows();
+		std::vector<uint64_t> topLevel;
+		if(this->tree) this->tree->children(TreeSource<BASE>::root, topLevel);
+		this->index.reset(topLevel);
+		this->setSource(this->tree ? MS<Adapter>(*this) : nullptr);
+	}
+	
+	/// Show node's children, loading them if it's the first time.  Does nothing if node isn't loaded
+	inline void expand(uint64_t node)
+	{
+		uint32_t at = this->index.find(node);
+		if(at == TreeIndex::none || this->index.expanded(at)) return;
+		this->releaseRows();
+		this->index.expand(at, [this](uint64_t id, std::vector<uint64_t> &out){this->tree->children(id, out);});
+		this->itemsChanged();
+		this->toggled.fire(node, true);
+	}
+	
+	inline void collapse(uint64_t node)
+	{
+		uint32_t at = this->index.find(node);
+		if(at == TreeIndex::none || !this->index.expanded(at)) return;
+		this->releaseRows();
+		this->index.collapse(at);
+		this->itemsChanged();
+		this->toggled.fire(node, false);
+	}
+	
+	inline void toggle(uint64_t node)
+	{
+		if(this->isExpanded(node)) this->collapse(node);
+		else this->expand(node);
+	}
+	
+	inline bool isExpanded(uint64_t node) const
+	{
+		uint32_t at = this->index.find(node);
+		return at != TreeIndex::none && this->index.expanded(at);
+	}
+	
+	/// Expand the ancestors of a loaded node and scroll the least needed to bring it into view, false if it isn't loaded
+	inline bool scrollToNode(uint64_t node)
+	{
+		uint32_t at = this->index.find(node);
+		if(at == TreeIndex::none) return false;
+		for(uint32_t parent = this->index.parent(at); parent != TreeIndex::none; parent = this->index.parent(parent)) if(!this->index.expanded(parent)) this->expand(this->index.id(parent));
+		this->scrollToItem(this->index.rowOf(at));
+		return true;
+	}
+	
+	/// The node under a point in the same space as pos, TreeSource::root if there isn't one
+	inline uint64_t nodeAt(IR::vec2<int32_t> const &point) const
+	{
+		size_t row = this->itemAt(point);
+		return row < this->index.rowCount() ? this->index.id(this->index.nodeAt(row)) : TreeSource<BASE>::root;
+	}
+	
+	/// The node shown on row
+	inline uint64_t nodeOnRow(size_t row) const
+	{
+		return this->index.id(this->index.nodeAt(row));
+	}
+	
+	Signal<uint64_t, bool> toggled {}; //Node and whether it was expanded
+
+protected:
+	/// Presents the visible rows to ListView as its items
+	struct Adapter : public ListSource<BASE>
+	{
+		inline explicit Adapter(TreeView &view) : view(view) {}
+		
+		inline size_t count() const override
+		{
+			return this->view.index.rowCount();
+		}
+		
+		inline int32_t rowHeight() const override
+		{
+			return std::max(this->view.tree->rowHeight(), 1);
+		}
+		
+		inline SP<BASE> createRow(SP<BASE> const &parent) override
+		{
+			return this->view.tree->createRow(parent);
+		}
+		
+		inline void bindRow(BASE &row, size_t item) override
+		{
+			uint32_t node = this->view.index.nodeAt(item);
+			this->view.tree->bindRow(row, this->view.index.id(node), this->view.index.depth(node), this->view.index.expanded(node));
+		}
+		
+		inline void unbindRow(BASE &row, size_t item) override
+		{
+			this->view.tree->unbindRow(row, this->view.index.id(this->view.index.nodeAt(item)));
+		}
+		
+		TreeView &view;
+	};
+	
+	SP<TreeSource<BASE>> tree;
+	TreeIndex index;
+};